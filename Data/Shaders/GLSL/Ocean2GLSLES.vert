@@ -0,0 +1,121 @@
+/*********************************************************************NVMH3****
+Copyright NVIDIA Corporation 2003
+TO THE MAXIMUM EXTENT PERMITTED BY APPLICABLE LAW, THIS SOFTWARE IS PROVIDED
+*AS IS* AND NVIDIA AND ITS SUPPLIERS DISCLAIM ALL WARRANTIES, EITHER EXPRESS
+OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY
+AND FITNESS FOR A PARTICULAR PURPOSE.  IN NO EVENT SHALL NVIDIA OR ITS SUPPLIERS
+BE LIABLE FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES
+WHATSOEVER (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY LOSS)
+ARISING OUT OF THE USE OF OR INABILITY TO USE THIS SOFTWARE, EVEN IF NVIDIA HAS
+BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+
+
+Comments:
+	Simple ocean shader with animated bump map and geometric waves
+	Based partly on "Effective Water Simulation From Physical Models", GPU Gems
+
+11 Aug 05: heavily modified by Jeff Doyle (nfz) for Ogre
+
+Talos: GLSL ES port of Ocean2HLSL_Cg.vert; keep the two in step.
+
+******************************************************************************/
+
+#version 100
+
+attribute vec4 vertex;
+// ring spacing, morph start, morph end
+attribute vec4 uv0;
+
+uniform mat4 worldViewProj;
+uniform mat4 world;
+uniform vec3 eyePosition;
+uniform float uvScale;
+uniform float BumpScale;
+uniform vec2 textureScale;
+uniform vec2 bumpSpeed;
+uniform float time;
+uniform float waveFreq;
+uniform float waveAmp;
+
+// rows of the 3x3 transform from tangent to obj space
+varying vec3 rotMatrix1;
+varying vec3 rotMatrix2;
+varying vec3 rotMatrix3;
+
+varying vec2 bumpCoord0;
+varying vec2 bumpCoord1;
+varying vec2 bumpCoord2;
+
+varying vec3 eyeVector;
+
+// wave functions
+
+struct Wave {
+	float freq;  // 2*PI / wavelength
+	float amp;   // amplitude
+	float phase; // speed * 2*PI / wavelength
+	vec2 dir;
+};
+
+void main()
+{
+	#define NWAVES 2
+	Wave wave[NWAVES];
+	wave[0] = Wave(waveFreq, waveAmp, 0.5, vec2(-1.0, 0.0));
+	wave[1] = Wave(waveFreq * 3.0, waveAmp * 0.33, 1.7, vec2(-0.7, 0.7));
+
+	vec4 P = vertex;
+
+	// the node only moves in steps of the finest grid; shift the ring back
+	// onto its own grid in world space (always a multiple of its spacing, so
+	// rings still meet once morphed)
+	vec2 origin = (world * vec4(0.0, 0.0, 0.0, 1.0)).xz;
+	P.xz -= origin - floor(origin / uv0.x) * uv0.x;
+
+	// geomorph: odd vertices slide onto the coarser world grid as the camera
+	// distance (square rings, so max of the axes) approaches the ring edge
+	vec2 eyeDist = abs(P.xz - eyePosition.xz);
+	float morph = clamp((max(eyeDist.x, eyeDist.y) - uv0.y) /
+		(uv0.z - uv0.y), 0.0, 1.0);
+	vec2 gridPos = (P.xz + origin) / (2.0 * uv0.x);
+	P.xz -= fract(gridPos) * (2.0 * uv0.x) * morph;
+
+	vec2 worldXZ = P.xz + origin;
+	float spacing = uv0.x * (1.0 + morph);
+
+	// sum waves
+	float ddx = 0.0, ddy = 0.0;
+	float deriv;
+	float angle;
+
+	// wave synthesis using two sine waves at different frequencies and phase shift
+	for(int i = 0; i<NWAVES; ++i)
+	{
+		// full amplitude up to a quarter wavelength spacing, none at half
+		float amp = wave[i].amp * clamp(2.0 - spacing * wave[i].freq * 0.6366, 0.0, 1.0);
+		angle = dot(wave[i].dir, worldXZ) * wave[i].freq + time * wave[i].phase;
+		P.y += amp * sin( angle );
+		// calculate derivate of wave function
+		deriv = wave[i].freq * amp * cos(angle);
+		ddx -= deriv * wave[i].dir.x;
+		ddy -= deriv * wave[i].dir.y;
+	}
+
+	// compute the 3x3 transform from tangent space to object space
+	// first rows are the tangent and binormal scaled by the bump scale
+
+	rotMatrix1 = BumpScale * normalize(vec3(1.0, ddy, 0.0)); // Binormal
+	rotMatrix2 = BumpScale * normalize(vec3(0.0, ddx, 1.0)); // Tangent
+	rotMatrix3 = normalize(vec3(ddx, 1.0, ddy)); // Normal
+
+	gl_Position = worldViewProj * P;
+
+	// calculate texture coordinates for normal map lookup
+	vec2 texCoord = worldXZ * uvScale;
+	bumpCoord0.xy = texCoord*textureScale + time * bumpSpeed;
+	bumpCoord1.xy = texCoord*textureScale * 2.0 + time * bumpSpeed * 4.0;
+	bumpCoord2.xy = texCoord*textureScale * 4.0 + time * bumpSpeed * 8.0;
+
+	eyeVector = P.xyz - eyePosition; // eye position in vertex space
+}
@@ -17,11 +17,18 @@ Comments:
 
 11 Aug 05: heavily modified by Jeff Doyle (nfz) for Ogre
 
+Talos: rendered on a camera-centred clipmap. Each ring is aligned to its own
+spacing in world space so coarse rings don't swim as the mesh follows the
+camera in finer steps. Waves and texture coordinates use world positions,
+each ring geomorphs towards the next ring's world grid near its outer edge,
+and waves shorter than twice a ring's spacing fade out instead of aliasing.
+Keep Ocean2GLSL.vert and Ocean2GLSLES.vert in step with this file.
+
 ******************************************************************************/
 
 struct a2v {
 	float4 Position : POSITION;   // in object space
-	float2 TexCoord : TEXCOORD0;
+	float4 Morph    : TEXCOORD0;  // ring spacing, morph start, morph end
 };
 
 struct v2f {
@@ -48,7 +55,9 @@ struct Wave {
 
 v2f main(a2v IN,
 		uniform float4x4 WorldViewProj,
+		uniform float4x4 World,
 		uniform float3 eyePosition,
+		uniform float uvScale,
 		uniform float BumpScale,
 		uniform float2 textureScale,
 		uniform float2 bumpSpeed,
@@ -73,6 +82,23 @@ v2f main(a2v IN,
 
     float4 P = IN.Position;
 
+	// the node only moves in steps of the finest grid; shift the ring back
+	// onto its own grid in world space (always a multiple of its spacing, so
+	// rings still meet once morphed)
+	float2 origin = mul(World, float4(0.0, 0.0, 0.0, 1.0)).xz;
+	P.xz -= origin - floor(origin / IN.Morph.x) * IN.Morph.x;
+
+	// geomorph: odd vertices slide onto the coarser world grid as the camera
+	// distance (square rings, so max of the axes) approaches the ring edge
+	float2 eyeDist = abs(P.xz - eyePosition.xz);
+	float morph = saturate((max(eyeDist.x, eyeDist.y) - IN.Morph.y) /
+		(IN.Morph.z - IN.Morph.y));
+	float2 gridPos = (P.xz + origin) / (2.0 * IN.Morph.x);
+	P.xz -= frac(gridPos) * (2.0 * IN.Morph.x) * morph;
+
+	float2 worldXZ = P.xz + origin;
+	float spacing = IN.Morph.x * (1.0 + morph);
+
 	// sum waves
 	float ddx = 0.0, ddy = 0.0;
 	float deriv;
@@ -81,10 +107,12 @@ v2f main(a2v IN,
 	// wave synthesis using two sine waves at different frequencies and phase shift
 	for(int i = 0; i<NWAVES; ++i)
 	{
-		angle = dot(wave[i].dir, P.xz) * wave[i].freq + time * wave[i].phase;
-		P.y += wave[i].amp * sin( angle );
+		// full amplitude up to a quarter wavelength spacing, none at half
+		float amp = wave[i].amp * saturate(2.0 - spacing * wave[i].freq * 0.6366);
+		angle = dot(wave[i].dir, worldXZ) * wave[i].freq + time * wave[i].phase;
+		P.y += amp * sin( angle );
 		// calculate derivate of wave function
-		deriv = wave[i].freq * wave[i].amp * cos(angle);
+		deriv = wave[i].freq * amp * cos(angle);
 		ddx -= deriv * wave[i].dir.x;
 		ddy -= deriv * wave[i].dir.y;
 	}
@@ -99,9 +127,10 @@ v2f main(a2v IN,
 	OUT.Position = mul(WorldViewProj, P);
 
 	// calculate texture coordinates for normal map lookup
-	OUT.bumpCoord0.xy = IN.TexCoord*textureScale + time * bumpSpeed;
-	OUT.bumpCoord1.xy = IN.TexCoord*textureScale * 2.0 + time * bumpSpeed * 4.0;
-	OUT.bumpCoord2.xy = IN.TexCoord*textureScale * 4.0 + time * bumpSpeed * 8.0;
+	float2 texCoord = worldXZ * uvScale;
+	OUT.bumpCoord0.xy = texCoord*textureScale + time * bumpSpeed;
+	OUT.bumpCoord1.xy = texCoord*textureScale * 2.0 + time * bumpSpeed * 4.0;
+	OUT.bumpCoord2.xy = texCoord*textureScale * 4.0 + time * bumpSpeed * 8.0;
 
 	OUT.eyeVector = P.xyz - eyePosition; // eye position in vertex space
 	return OUT;
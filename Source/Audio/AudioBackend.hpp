@@ -0,0 +1,104 @@
+// ========================================================================= //
+// Talos - A 3D game engine with network multiplayer.
+// Copyright(C) 2015 Jordan Sparks <unixunited@live.com>
+//
+// This program is free software; you can redistribute it and / or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 3
+// of the License, or(at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+// ========================================================================= //
+// File: AudioBackend.hpp
+// Author: Jordan Sparks <unixunited@live.com>
+// ========================================================================= //
+// Defines AudioBackend interface.
+// ========================================================================= //
+
+#ifndef __AUDIOBACKEND_HPP__
+#define __AUDIOBACKEND_HPP__
+
+// ========================================================================= //
+
+#include "stdafx.hpp"
+
+// ========================================================================= //
+// Abstract mixer the AudioManager drives. A source is loaded sound data,
+// either decoded in memory or streamed from disk by the mixer. A voice is
+// one physically playing source; the manager decides which emitters get one.
+class AudioBackend
+{
+public:
+    // Opaque source handle, nullptr if the sound could not be loaded.
+    typedef void* Source;
+
+    // Opaque voice handle, nullptr if a voice could not be started.
+    typedef void* Voice;
+
+    // Empty constructor.
+    explicit AudioBackend(void) { }
+
+    // Empty destructor.
+    virtual ~AudioBackend(void) { }
+
+    // Decodes file into memory, or opens it to be streamed while playing.
+    virtual Source load(const std::string& file, const bool stream) = 0;
+
+    // Decodes a sound file already read into memory. Does not touch disk.
+    virtual Source load(const std::string& file,
+                        const char* data,
+                        const size_t size) = 0;
+
+    // Releases a source. It must not be playing.
+    virtual void unload(Source source) = 0;
+
+    // Starts a voice at playPosition milliseconds into source. A voice that
+    // is not positional plays in 2D and ignores position.
+    virtual Voice start(Source source,
+                        const Ogre::Vector3& position,
+                        const bool positional,
+                        const bool looped,
+                        const Ogre::Real volume,
+                        const uint32_t playPosition) = 0;
+
+    // Stops and releases a voice.
+    virtual void stop(Voice voice) = 0;
+
+    // Advances the backend by dt milliseconds.
+    virtual void update(const Ogre::Real dt) { }
+
+    // Getters:
+
+    // Returns true if a non-looped voice has played to its end.
+    virtual bool isFinished(Voice voice) const = 0;
+
+    // Returns the voice's play position in milliseconds.
+    virtual uint32_t getPlayPosition(Voice voice) const = 0;
+
+    // Returns length of source in milliseconds, 0 if unknown.
+    virtual uint32_t getLength(Source source) const = 0;
+
+    // Returns bytes of decoded data held by source, 0 if streamed.
+    virtual size_t getSize(Source source) const = 0;
+
+    // Setters:
+
+    virtual void setPosition(Voice voice, const Ogre::Vector3& position) = 0;
+
+    virtual void setVolume(Voice voice, const Ogre::Real volume) = 0;
+
+    virtual void setListener(const Ogre::Vector3& position,
+                             const Ogre::Vector3& look) = 0;
+};
+
+// ========================================================================= //
+
+#endif
+
+// ========================================================================= //
\ No newline at end of file
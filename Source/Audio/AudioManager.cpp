@@ -0,0 +1,380 @@
+// ========================================================================= //
+// Talos - A 3D game engine with network multiplayer.
+// Copyright(C) 2015 Jordan Sparks <unixunited@live.com>
+//
+// This program is free software; you can redistribute it and / or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 3
+// of the License, or(at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+// ========================================================================= //
+// File: AudioManager.cpp
+// Author: Jordan Sparks <unixunited@live.com>
+// ========================================================================= //
+// Implements AudioManager class.
+// ========================================================================= //
+
+#include "AudioManager.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+// ========================================================================= //
+
+AudioManager::AudioManager(AudioBackend* backend) :
+m_backend(backend),
+m_bank(new SoundBank(backend)),
+m_emitters(),
+m_free(),
+m_ranked(),
+m_listener(Ogre::Vector3::ZERO),
+m_maxVoices(16),
+m_physical(0),
+m_virtual(0),
+m_minDistance(1.f),
+m_cutoff(0.001f)
+{
+
+}
+
+// ========================================================================= //
+
+AudioManager::~AudioManager(void)
+{
+    this->stopAll();
+}
+
+// ========================================================================= //
+
+AudioManager::Handle AudioManager::create(const SoundBank::Handle sound,
+                                          const Ogre::Vector3& position,
+                                          const bool positional,
+                                          const bool looped,
+                                          const bool paused,
+                                          const Ogre::Real priority)
+{
+    Handle handle = 0;
+    if (m_free.empty() == false){
+        handle = m_free.back();
+        m_free.pop_back();
+    }
+    else{
+        handle = static_cast<Handle>(m_emitters.size());
+        m_emitters.push_back(Emitter());
+        m_ranked.reserve(m_emitters.size());
+    }
+
+    Emitter& emitter = m_emitters[handle];
+    emitter.sound = sound;
+    emitter.position = position;
+    emitter.volume = 1.f;
+    emitter.priority = priority;
+    // Loading now tells the emitter its length even if it never gets a voice.
+    m_bank->prefetch(sound);
+    emitter.length = m_bank->getLength(sound);
+    emitter.playTime = 0.f;
+    emitter.audibility = 0.f;
+    emitter.voice = nullptr;
+    emitter.positional = positional;
+    emitter.looped = looped;
+    emitter.paused = paused;
+    emitter.finished = false;
+    emitter.moved = false;
+    emitter.active = true;
+
+    // Voices are handed out on the next update.
+    return handle;
+}
+
+// ========================================================================= //
+
+AudioManager::Handle AudioManager::play(const SoundBank::Handle sound,
+                                        const Ogre::Vector3& position,
+                                        const bool looped,
+                                        const bool paused,
+                                        const Ogre::Real priority)
+{
+    return this->create(sound, position, true, looped, paused, priority);
+}
+
+// ========================================================================= //
+
+AudioManager::Handle AudioManager::play2D(const SoundBank::Handle sound,
+                                          const bool looped,
+                                          const Ogre::Real priority)
+{
+    return this->create(sound,
+                        Ogre::Vector3::ZERO,
+                        false,
+                        looped,
+                        false,
+                        priority);
+}
+
+// ========================================================================= //
+
+void AudioManager::stop(const Handle handle)
+{
+    Assert(handle < m_emitters.size() && m_emitters[handle].active,
+           "Invalid AudioManager handle");
+
+    Emitter& emitter = m_emitters[handle];
+    if (emitter.voice != nullptr){
+        m_backend->stop(emitter.voice);
+        m_bank->release(emitter.sound);
+        emitter.voice = nullptr;
+        --m_physical;
+    }
+
+    emitter.active = false;
+    m_free.push_back(handle);
+}
+
+// ========================================================================= //
+
+void AudioManager::stopAll(void)
+{
+    for (Handle i = 0; i < m_emitters.size(); ++i){
+        if (m_emitters[i].active){
+            this->stop(i);
+        }
+    }
+}
+
+// ========================================================================= //
+
+const Ogre::Real AudioManager::getAudibility(const Emitter& emitter) const
+{
+    Ogre::Real attenuation = 1.f;
+    if (emitter.positional){
+        const Ogre::Real distance = emitter.position.distance(m_listener);
+        if (distance > m_minDistance){
+            attenuation = m_minDistance / distance;
+        }
+    }
+
+    return attenuation * emitter.volume * emitter.priority;
+}
+
+// ========================================================================= //
+
+void AudioManager::promote(Emitter& emitter)
+{
+    // Not resident yet; stays virtual while the bank loads it.
+    AudioBackend::Source source = m_bank->acquire(emitter.sound);
+    if (source == nullptr){
+        return;
+    }
+    emitter.length = m_bank->getLength(emitter.sound);
+
+    // Resume where the virtual emitter would have been.
+    Ogre::Real playTime = emitter.playTime;
+    if (emitter.length > 0){
+        playTime = std::fmod(playTime, static_cast<Ogre::Real>(emitter.length));
+    }
+
+    emitter.voice = m_backend->start(source,
+                                     emitter.position,
+                                     emitter.positional,
+                                     emitter.looped,
+                                     emitter.volume,
+                                     static_cast<uint32_t>(playTime));
+    emitter.moved = false;
+    if (emitter.voice != nullptr){
+        ++m_physical;
+    }
+    else{
+        m_bank->release(emitter.sound);
+    }
+}
+
+// ========================================================================= //
+
+void AudioManager::demote(Emitter& emitter)
+{
+    emitter.playTime =
+        static_cast<Ogre::Real>(m_backend->getPlayPosition(emitter.voice));
+    m_backend->stop(emitter.voice);
+    m_bank->release(emitter.sound);
+    emitter.voice = nullptr;
+    --m_physical;
+}
+
+// ========================================================================= //
+
+void AudioManager::update(const Ogre::Real dt)
+{
+    m_backend->update(dt);
+    m_bank->update();
+
+    // Advance play time and collect emitters that could use a voice.
+    m_ranked.clear();
+    for (Handle i = 0; i < m_emitters.size(); ++i){
+        Emitter& emitter = m_emitters[i];
+        if (emitter.active == false || emitter.finished){
+            continue;
+        }
+
+        if (emitter.voice != nullptr){
+            if (m_backend->isFinished(emitter.voice)){
+                m_backend->stop(emitter.voice);
+                m_bank->release(emitter.sound);
+                emitter.voice = nullptr;
+                emitter.finished = true;
+                --m_physical;
+                continue;
+            }
+        }
+        else if (emitter.paused == false){
+            // Learn the length once the bank has loaded the sound.
+            if (emitter.length == 0){
+                emitter.length = m_bank->getLength(emitter.sound);
+            }
+
+            // Time is held only until the bank first loads the sound, so a
+            // sound audible as soon as it loads starts from its beginning.
+            // From then on it keeps time while virtual, resident or not.
+            if (emitter.length > 0 || m_bank->isResident(emitter.sound)){
+                emitter.playTime += dt;
+                if (emitter.looped == false &&
+                    emitter.length > 0 &&
+                    emitter.playTime >= emitter.length){
+                    emitter.finished = true;
+                    continue;
+                }
+            }
+            else if (m_bank->isFailed(emitter.sound)){
+                // Will never play.
+                emitter.finished = true;
+                continue;
+            }
+        }
+
+        // A paused emitter gives up its voice.
+        if (emitter.paused){
+            if (emitter.voice != nullptr){
+                this->demote(emitter);
+            }
+            continue;
+        }
+
+        emitter.audibility = this->getAudibility(emitter);
+        if (emitter.audibility < m_cutoff){
+            if (emitter.voice != nullptr){
+                this->demote(emitter);
+            }
+            continue;
+        }
+
+        // Playing voices get an edge so near-equal emitters don't swap
+        // voices every tick.
+        if (emitter.voice != nullptr){
+            emitter.audibility *= 1.1f;
+        }
+
+        m_ranked.push_back(i);
+    }
+
+    // Partition the most audible to the front.
+    const size_t voices = std::min(m_ranked.size(),
+                                   static_cast<size_t>(m_maxVoices));
+    if (voices < m_ranked.size()){
+        std::nth_element(m_ranked.begin(),
+                         m_ranked.begin() + voices,
+                         m_ranked.end(),
+                         [this](const Handle a, const Handle b){
+            return m_emitters[a].audibility > m_emitters[b].audibility;
+        });
+    }
+
+    // Release voices first so promotions stay within the cap.
+    for (size_t i = voices; i < m_ranked.size(); ++i){
+        Emitter& emitter = m_emitters[m_ranked[i]];
+        if (emitter.voice != nullptr){
+            this->demote(emitter);
+        }
+    }
+
+    for (size_t i = 0; i < voices; ++i){
+        Emitter& emitter = m_emitters[m_ranked[i]];
+        if (emitter.voice == nullptr){
+            this->promote(emitter);
+        }
+        else if (emitter.moved){
+            m_backend->setPosition(emitter.voice, emitter.position);
+            emitter.moved = false;
+        }
+    }
+
+    m_virtual = static_cast<uint32_t>(m_ranked.size()) - m_physical;
+}
+
+// ========================================================================= //
+
+// Getters:
+
+// ========================================================================= //
+
+const bool AudioManager::isFinished(const Handle handle) const
+{
+    return m_emitters[handle].finished;
+}
+
+// ========================================================================= //
+
+const bool AudioManager::isPhysical(const Handle handle) const
+{
+    return (m_emitters[handle].voice != nullptr);
+}
+
+// ========================================================================= //
+
+// Setters:
+
+// ========================================================================= //
+
+void AudioManager::setPosition(const Handle handle,
+                               const Ogre::Vector3& position)
+{
+    Emitter& emitter = m_emitters[handle];
+    if (emitter.positional && emitter.position != position){
+        emitter.position = position;
+        emitter.moved = true;
+    }
+}
+
+// ========================================================================= //
+
+void AudioManager::setVolume(const Handle handle, const Ogre::Real volume)
+{
+    Emitter& emitter = m_emitters[handle];
+    emitter.volume = volume;
+    if (emitter.voice != nullptr){
+        m_backend->setVolume(emitter.voice, volume);
+    }
+}
+
+// ========================================================================= //
+
+void AudioManager::setPaused(const Handle handle, const bool paused)
+{
+    m_emitters[handle].paused = paused;
+}
+
+// ========================================================================= //
+
+void AudioManager::setListener(const Ogre::Vector3& position,
+                               const Ogre::Vector3& look)
+{
+    m_listener = position;
+    m_backend->setListener(position, look);
+}
+
+// ========================================================================= //
\ No newline at end of file
@@ -0,0 +1,214 @@
+// ========================================================================= //
+// Talos - A 3D game engine with network multiplayer.
+// Copyright(C) 2015 Jordan Sparks <unixunited@live.com>
+//
+// This program is free software; you can redistribute it and / or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 3
+// of the License, or(at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+// ========================================================================= //
+// File: AudioManager.hpp
+// Author: Jordan Sparks <unixunited@live.com>
+// ========================================================================= //
+// Defines AudioManager class.
+// ========================================================================= //
+
+#ifndef __AUDIOMANAGER_HPP__
+#define __AUDIOMANAGER_HPP__
+
+// ========================================================================= //
+
+#include "AudioBackend.hpp"
+#include "SoundBank.hpp"
+
+// ========================================================================= //
+// Caps the number of physically mixed voices. Sounds are requested as
+// emitters; each tick they are ranked by audibility (distance attenuation
+// times volume and priority) and only the best get a backend voice. The
+// rest are virtual: their play time is tracked without mixing, and they
+// resume at the right point when promoted back. Emitter positions are
+// stored locally and only sent to the backend for physical voices that
+// moved, so mixing cost and position traffic are bounded by the voice cap
+// rather than the number of emitters. Sounds come from the SoundBank, which
+// starts loading each one when its emitter is created; an emitter's time
+// starts once its sound has loaded.
+class AudioManager final
+{
+public:
+    typedef uint32_t Handle;
+
+    static const Handle InvalidHandle = 0xFFFFFFFF;
+
+    // Takes ownership of the backend and creates a SoundBank on it.
+    explicit AudioManager(AudioBackend* backend);
+
+    // Stops all voices.
+    ~AudioManager(void);
+
+    // Requests a positional sound. A paused emitter neither plays nor
+    // advances until resumed. Higher priority wins voices over equally
+    // audible emitters.
+    Handle play(const SoundBank::Handle sound,
+                const Ogre::Vector3& position,
+                const bool looped = true,
+                const bool paused = false,
+                const Ogre::Real priority = 1.f);
+
+    // Requests a non-positional sound, e.g. music. It is always audible at
+    // its volume.
+    Handle play2D(const SoundBank::Handle sound,
+                  const bool looped = true,
+                  const Ogre::Real priority = 1.f);
+
+    // Stops a sound and frees its handle.
+    void stop(const Handle handle);
+
+    // Stops all sounds.
+    void stopAll(void);
+
+    // Advances virtual emitters by dt milliseconds and reassigns voices.
+    void update(const Ogre::Real dt);
+
+    // Getters:
+
+    // Returns true if a non-looped sound has played to its end.
+    const bool isFinished(const Handle handle) const;
+
+    // Returns true if the sound currently has a backend voice.
+    const bool isPhysical(const Handle handle) const;
+
+    // Returns number of sounds with a backend voice.
+    const uint32_t getPhysicalCount(void) const;
+
+    // Returns number of playing sounds without a backend voice.
+    const uint32_t getVirtualCount(void) const;
+
+    // Returns maximum number of backend voices.
+    const uint32_t getMaxVoices(void) const;
+
+    // Returns the backend.
+    AudioBackend* getBackend(void) const;
+
+    // Returns the cache sounds are registered with.
+    SoundBank* getSoundBank(void) const;
+
+    // Setters:
+
+    void setPosition(const Handle handle, const Ogre::Vector3& position);
+
+    void setVolume(const Handle handle, const Ogre::Real volume);
+
+    void setPaused(const Handle handle, const bool paused);
+
+    void setListener(const Ogre::Vector3& position, const Ogre::Vector3& look);
+
+    // Sets maximum number of backend voices.
+    void setMaxVoices(const uint32_t maxVoices);
+
+    // Sets distance within which a positional sound is at full volume;
+    // beyond it, volume falls off with 1 / distance.
+    void setMinDistance(const Ogre::Real minDistance);
+
+    // Sets audibility below which a sound is always virtual.
+    void setCutoff(const Ogre::Real cutoff);
+
+private:
+    struct Emitter{
+        SoundBank::Handle sound;
+        Ogre::Vector3 position;
+        Ogre::Real volume;
+        Ogre::Real priority;
+        // Length in milliseconds, 0 if unknown.
+        uint32_t length;
+        // Play time in milliseconds while virtual.
+        Ogre::Real playTime;
+        Ogre::Real audibility;
+        AudioBackend::Voice voice;
+        bool positional;
+        bool looped;
+        bool paused;
+        bool finished;
+        bool moved;
+        bool active;
+    };
+
+    Handle create(const SoundBank::Handle sound,
+                  const Ogre::Vector3& position,
+                  const bool positional,
+                  const bool looped,
+                  const bool paused,
+                  const Ogre::Real priority);
+
+    // Returns the emitter's audibility at the listener.
+    const Ogre::Real getAudibility(const Emitter& emitter) const;
+
+    // Gives the emitter a backend voice.
+    void promote(Emitter& emitter);
+
+    // Takes the emitter's backend voice, keeping its play time.
+    void demote(Emitter& emitter);
+
+    std::unique_ptr<AudioBackend> m_backend;
+    std::unique_ptr<SoundBank> m_bank;
+    std::vector<Emitter> m_emitters;
+    std::vector<Handle> m_free;
+    std::vector<Handle> m_ranked;
+    Ogre::Vector3 m_listener;
+    uint32_t m_maxVoices;
+    uint32_t m_physical;
+    uint32_t m_virtual;
+    Ogre::Real m_minDistance;
+    Ogre::Real m_cutoff;
+};
+
+// ========================================================================= //
+
+// Getters:
+
+inline const uint32_t AudioManager::getPhysicalCount(void) const{
+    return m_physical;
+}
+
+inline const uint32_t AudioManager::getVirtualCount(void) const{
+    return m_virtual;
+}
+
+inline const uint32_t AudioManager::getMaxVoices(void) const{
+    return m_maxVoices;
+}
+
+inline AudioBackend* AudioManager::getBackend(void) const{
+    return m_backend.get();
+}
+
+inline SoundBank* AudioManager::getSoundBank(void) const{
+    return m_bank.get();
+}
+
+// Setters:
+
+inline void AudioManager::setMaxVoices(const uint32_t maxVoices){
+    m_maxVoices = maxVoices;
+}
+
+inline void AudioManager::setMinDistance(const Ogre::Real minDistance){
+    m_minDistance = minDistance;
+}
+
+inline void AudioManager::setCutoff(const Ogre::Real cutoff){
+    m_cutoff = cutoff;
+}
+
+// ========================================================================= //
+
+#endif
+
+// ========================================================================= //
\ No newline at end of file
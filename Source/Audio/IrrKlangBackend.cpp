@@ -0,0 +1,206 @@
+// ========================================================================= //
+// Talos - A 3D game engine with network multiplayer.
+// Copyright(C) 2015 Jordan Sparks <unixunited@live.com>
+//
+// This program is free software; you can redistribute it and / or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 3
+// of the License, or(at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+// ========================================================================= //
+// File: IrrKlangBackend.cpp
+// Author: Jordan Sparks <unixunited@live.com>
+// ========================================================================= //
+// Implements IrrKlangBackend class.
+// ========================================================================= //
+
+#include "IrrKlangBackend.hpp"
+
+// ========================================================================= //
+
+IrrKlangBackend::IrrKlangBackend(irrklang::ISoundEngine* soundEngine) :
+m_soundEngine(soundEngine)
+{
+
+}
+
+// ========================================================================= //
+
+IrrKlangBackend::~IrrKlangBackend(void)
+{
+
+}
+
+// ========================================================================= //
+
+AudioBackend::Source IrrKlangBackend::load(const std::string& file,
+                                           const bool stream)
+{
+    // Streamed sources are decoded in chunks by irrKlang's own thread.
+    irrklang::ISoundSource* source = m_soundEngine->addSoundSourceFromFile(
+        file.c_str(),
+        (stream) ? irrklang::ESM_STREAMING : irrklang::ESM_NO_STREAMING,
+        true);
+
+    // irrKlang returns nullptr if the file was already added.
+    return (source != nullptr) ? source :
+        m_soundEngine->getSoundSource(file.c_str(), false);
+}
+
+// ========================================================================= //
+
+AudioBackend::Source IrrKlangBackend::load(const std::string& file,
+                                           const char* data,
+                                           const size_t size)
+{
+    irrklang::ISoundSource* source = m_soundEngine->addSoundSourceFromMemory(
+        const_cast<char*>(data),
+        static_cast<irrklang::ik_s32>(size),
+        file.c_str(),
+        true);
+    if (source == nullptr){
+        return m_soundEngine->getSoundSource(file.c_str(), false);
+    }
+
+    source->setStreamMode(irrklang::ESM_NO_STREAMING);
+
+    return source;
+}
+
+// ========================================================================= //
+
+void IrrKlangBackend::unload(Source source)
+{
+    m_soundEngine->removeSoundSource(
+        static_cast<irrklang::ISoundSource*>(source));
+}
+
+// ========================================================================= //
+
+AudioBackend::Voice IrrKlangBackend::start(Source source,
+                                           const Ogre::Vector3& position,
+                                           const bool positional,
+                                           const bool looped,
+                                           const Ogre::Real volume,
+                                           const uint32_t playPosition)
+{
+    irrklang::ISoundSource* soundSource =
+        static_cast<irrklang::ISoundSource*>(source);
+
+    // Start paused so the voice is set up before it is heard.
+    irrklang::ISound* sound = (positional) ?
+        m_soundEngine->play3D(soundSource,
+                              irrklang::vec3df(position.x,
+                                               position.y,
+                                               position.z),
+                              looped,
+                              true,
+                              true) :
+        m_soundEngine->play2D(soundSource, looped, true, true);
+    if (sound == nullptr){
+        return nullptr;
+    }
+
+    sound->setVolume(volume);
+    if (playPosition > 0){
+        sound->setPlayPosition(playPosition);
+    }
+    sound->setIsPaused(false);
+
+    return sound;
+}
+
+// ========================================================================= //
+
+void IrrKlangBackend::stop(Voice voice)
+{
+    irrklang::ISound* sound = static_cast<irrklang::ISound*>(voice);
+
+    sound->stop();
+    sound->drop();
+}
+
+// ========================================================================= //
+
+// Getters:
+
+// ========================================================================= //
+
+bool IrrKlangBackend::isFinished(Voice voice) const
+{
+    return static_cast<irrklang::ISound*>(voice)->isFinished();
+}
+
+// ========================================================================= //
+
+uint32_t IrrKlangBackend::getPlayPosition(Voice voice) const
+{
+    const irrklang::ik_u32 position =
+        static_cast<irrklang::ISound*>(voice)->getPlayPosition();
+
+    // -1 when unknown.
+    return (position == static_cast<irrklang::ik_u32>(-1)) ? 0 : position;
+}
+
+// ========================================================================= //
+
+uint32_t IrrKlangBackend::getLength(Source source) const
+{
+    const irrklang::ik_s32 length =
+        static_cast<irrklang::ISoundSource*>(source)->getPlayLength();
+
+    // -1 when unknown.
+    return (length < 0) ? 0 : static_cast<uint32_t>(length);
+}
+
+// ========================================================================= //
+
+size_t IrrKlangBackend::getSize(Source source) const
+{
+    irrklang::ISoundSource* soundSource =
+        static_cast<irrklang::ISoundSource*>(source);
+    if (soundSource->getStreamMode() == irrklang::ESM_STREAMING){
+        return 0;
+    }
+
+    return static_cast<size_t>(
+        soundSource->getAudioFormat().getSampleDataSize());
+}
+
+// ========================================================================= //
+
+// Setters:
+
+// ========================================================================= //
+
+void IrrKlangBackend::setPosition(Voice voice, const Ogre::Vector3& position)
+{
+    static_cast<irrklang::ISound*>(voice)->setPosition(
+        irrklang::vec3df(position.x, position.y, position.z));
+}
+
+// ========================================================================= //
+
+void IrrKlangBackend::setVolume(Voice voice, const Ogre::Real volume)
+{
+    static_cast<irrklang::ISound*>(voice)->setVolume(volume);
+}
+
+// ========================================================================= //
+
+void IrrKlangBackend::setListener(const Ogre::Vector3& position,
+                                  const Ogre::Vector3& look)
+{
+    m_soundEngine->setListenerPosition(
+        irrklang::vec3df(position.x, position.y, position.z),
+        irrklang::vec3df(-look.x, look.y, -look.z));
+}
+
+// ========================================================================= //
\ No newline at end of file
@@ -0,0 +1,87 @@
+// ========================================================================= //
+// Talos - A 3D game engine with network multiplayer.
+// Copyright(C) 2015 Jordan Sparks <unixunited@live.com>
+//
+// This program is free software; you can redistribute it and / or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 3
+// of the License, or(at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+// ========================================================================= //
+// File: IrrKlangBackend.hpp
+// Author: Jordan Sparks <unixunited@live.com>
+// ========================================================================= //
+// Defines IrrKlangBackend class.
+// ========================================================================= //
+
+#ifndef __IRRKLANGBACKEND_HPP__
+#define __IRRKLANGBACKEND_HPP__
+
+// ========================================================================= //
+
+#include "AudioBackend.hpp"
+
+// ========================================================================= //
+// Plays voices through an irrKlang device. The device is owned by Engine.
+class IrrKlangBackend final : public AudioBackend
+{
+public:
+    // Stores the sound engine.
+    explicit IrrKlangBackend(irrklang::ISoundEngine* soundEngine);
+
+    // Empty destructor.
+    virtual ~IrrKlangBackend(void) override;
+
+    virtual Source load(const std::string& file, const bool stream) override;
+
+    virtual Source load(const std::string& file,
+                        const char* data,
+                        const size_t size) override;
+
+    virtual void unload(Source source) override;
+
+    virtual Voice start(Source source,
+                        const Ogre::Vector3& position,
+                        const bool positional,
+                        const bool looped,
+                        const Ogre::Real volume,
+                        const uint32_t playPosition) override;
+
+    virtual void stop(Voice voice) override;
+
+    // Getters:
+
+    virtual bool isFinished(Voice voice) const override;
+
+    virtual uint32_t getPlayPosition(Voice voice) const override;
+
+    virtual uint32_t getLength(Source source) const override;
+
+    virtual size_t getSize(Source source) const override;
+
+    // Setters:
+
+    virtual void setPosition(Voice voice,
+                             const Ogre::Vector3& position) override;
+
+    virtual void setVolume(Voice voice, const Ogre::Real volume) override;
+
+    virtual void setListener(const Ogre::Vector3& position,
+                             const Ogre::Vector3& look) override;
+
+private:
+    irrklang::ISoundEngine* m_soundEngine;
+};
+
+// ========================================================================= //
+
+#endif
+
+// ========================================================================= //
\ No newline at end of file
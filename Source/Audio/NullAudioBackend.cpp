@@ -0,0 +1,202 @@
+// ========================================================================= //
+// Talos - A 3D game engine with network multiplayer.
+// Copyright(C) 2015 Jordan Sparks <unixunited@live.com>
+//
+// This program is free software; you can redistribute it and / or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 3
+// of the License, or(at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+// ========================================================================= //
+// File: NullAudioBackend.cpp
+// Author: Jordan Sparks <unixunited@live.com>
+// ========================================================================= //
+// Implements NullAudioBackend class.
+// ========================================================================= //
+
+#include "NullAudioBackend.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+// ========================================================================= //
+
+NullAudioBackend::NullAudioBackend(void) :
+m_sources(),
+m_voices(),
+m_lengths(),
+m_nextID(1),
+m_positionUpdates(0)
+{
+
+}
+
+// ========================================================================= //
+
+NullAudioBackend::~NullAudioBackend(void)
+{
+
+}
+
+// ========================================================================= //
+
+AudioBackend::Source NullAudioBackend::load(const std::string& file,
+                                            const bool stream)
+{
+    std::map<std::string, uint32_t>::const_iterator itr = m_lengths.find(file);
+
+    SourceData data;
+    data.length = (itr == m_lengths.end()) ? 0 : itr->second;
+    // 16-bit stereo at 44.1kHz is 176.4 bytes per millisecond.
+    data.size = (stream) ? 0 : static_cast<size_t>(data.length * 176.4);
+
+    const uintptr_t id = m_nextID++;
+    m_sources[id] = data;
+
+    return reinterpret_cast<Source>(id);
+}
+
+// ========================================================================= //
+
+AudioBackend::Source NullAudioBackend::load(const std::string& file,
+                                            const char* data,
+                                            const size_t size)
+{
+    return this->load(file, false);
+}
+
+// ========================================================================= //
+
+void NullAudioBackend::unload(Source source)
+{
+    m_sources.erase(reinterpret_cast<uintptr_t>(source));
+}
+
+// ========================================================================= //
+
+AudioBackend::Voice NullAudioBackend::start(Source source,
+                                            const Ogre::Vector3& position,
+                                            const bool positional,
+                                            const bool looped,
+                                            const Ogre::Real volume,
+                                            const uint32_t playPosition)
+{
+    VoiceData data;
+    data.length = this->getLength(source);
+    data.position = static_cast<Ogre::Real>(playPosition);
+    data.looped = looped;
+
+    const uintptr_t id = m_nextID++;
+    m_voices[id] = data;
+
+    return reinterpret_cast<Voice>(id);
+}
+
+// ========================================================================= //
+
+void NullAudioBackend::stop(Voice voice)
+{
+    m_voices.erase(reinterpret_cast<uintptr_t>(voice));
+}
+
+// ========================================================================= //
+
+void NullAudioBackend::update(const Ogre::Real dt)
+{
+    for (auto& voice : m_voices){
+        VoiceData& data = voice.second;
+        data.position += dt;
+        if (data.length > 0){
+            data.position = (data.looped) ?
+                std::fmod(data.position, static_cast<Ogre::Real>(data.length)) :
+                std::min(data.position, static_cast<Ogre::Real>(data.length));
+        }
+    }
+}
+
+// ========================================================================= //
+
+// Getters:
+
+// ========================================================================= //
+
+bool NullAudioBackend::isFinished(Voice voice) const
+{
+    std::map<uintptr_t, VoiceData>::const_iterator itr =
+        m_voices.find(reinterpret_cast<uintptr_t>(voice));
+    if (itr == m_voices.end()){
+        return true;
+    }
+
+    const VoiceData& data = itr->second;
+
+    return (data.looped == false &&
+            data.length > 0 &&
+            data.position >= data.length);
+}
+
+// ========================================================================= //
+
+uint32_t NullAudioBackend::getPlayPosition(Voice voice) const
+{
+    std::map<uintptr_t, VoiceData>::const_iterator itr =
+        m_voices.find(reinterpret_cast<uintptr_t>(voice));
+
+    return (itr == m_voices.end()) ? 0 :
+        static_cast<uint32_t>(itr->second.position);
+}
+
+// ========================================================================= //
+
+uint32_t NullAudioBackend::getLength(Source source) const
+{
+    std::map<uintptr_t, SourceData>::const_iterator itr =
+        m_sources.find(reinterpret_cast<uintptr_t>(source));
+
+    return (itr == m_sources.end()) ? 0 : itr->second.length;
+}
+
+// ========================================================================= //
+
+size_t NullAudioBackend::getSize(Source source) const
+{
+    std::map<uintptr_t, SourceData>::const_iterator itr =
+        m_sources.find(reinterpret_cast<uintptr_t>(source));
+
+    return (itr == m_sources.end()) ? 0 : itr->second.size;
+}
+
+// ========================================================================= //
+
+// Setters:
+
+// ========================================================================= //
+
+void NullAudioBackend::setPosition(Voice voice, const Ogre::Vector3& position)
+{
+    ++m_positionUpdates;
+}
+
+// ========================================================================= //
+
+void NullAudioBackend::setVolume(Voice voice, const Ogre::Real volume)
+{
+
+}
+
+// ========================================================================= //
+
+void NullAudioBackend::setListener(const Ogre::Vector3& position,
+                                   const Ogre::Vector3& look)
+{
+
+}
+
+// ========================================================================= //
\ No newline at end of file
@@ -0,0 +1,143 @@
+// ========================================================================= //
+// Talos - A 3D game engine with network multiplayer.
+// Copyright(C) 2015 Jordan Sparks <unixunited@live.com>
+//
+// This program is free software; you can redistribute it and / or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 3
+// of the License, or(at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+// ========================================================================= //
+// File: NullAudioBackend.hpp
+// Author: Jordan Sparks <unixunited@live.com>
+// ========================================================================= //
+// Defines NullAudioBackend class.
+// ========================================================================= //
+
+#ifndef __NULLAUDIOBACKEND_HPP__
+#define __NULLAUDIOBACKEND_HPP__
+
+// ========================================================================= //
+
+#include "AudioBackend.hpp"
+
+// ========================================================================= //
+// A silent backend for running without an audio device (dedicated servers,
+// headless runs). Sources are sized as 16-bit stereo at 44.1kHz and voices
+// only track play time, so the AudioManager and SoundBank behave as they
+// would with a real mixer. File lengths are unknown unless set.
+class NullAudioBackend final : public AudioBackend
+{
+public:
+    // Default initializes member data.
+    explicit NullAudioBackend(void);
+
+    // Empty destructor.
+    virtual ~NullAudioBackend(void) override;
+
+    virtual Source load(const std::string& file, const bool stream) override;
+
+    virtual Source load(const std::string& file,
+                        const char* data,
+                        const size_t size) override;
+
+    virtual void unload(Source source) override;
+
+    virtual Voice start(Source source,
+                        const Ogre::Vector3& position,
+                        const bool positional,
+                        const bool looped,
+                        const Ogre::Real volume,
+                        const uint32_t playPosition) override;
+
+    virtual void stop(Voice voice) override;
+
+    // Advances every voice's play position.
+    virtual void update(const Ogre::Real dt) override;
+
+    // Getters:
+
+    virtual bool isFinished(Voice voice) const override;
+
+    virtual uint32_t getPlayPosition(Voice voice) const override;
+
+    virtual uint32_t getLength(Source source) const override;
+
+    virtual size_t getSize(Source source) const override;
+
+    // Returns number of sources loaded and not yet unloaded.
+    const size_t getSourceCount(void) const;
+
+    // Returns number of voices started and not yet stopped.
+    const size_t getVoiceCount(void) const;
+
+    // Returns number of positional updates received.
+    const uint32_t getPositionUpdates(void) const;
+
+    // Setters:
+
+    virtual void setPosition(Voice voice,
+                             const Ogre::Vector3& position) override;
+
+    virtual void setVolume(Voice voice, const Ogre::Real volume) override;
+
+    virtual void setListener(const Ogre::Vector3& position,
+                             const Ogre::Vector3& look) override;
+
+    // Sets length of file in milliseconds.
+    void setLength(const std::string& file, const uint32_t length);
+
+private:
+    struct SourceData{
+        uint32_t length;
+        size_t size;
+    };
+
+    struct VoiceData{
+        uint32_t length;
+        Ogre::Real position;
+        bool looped;
+    };
+
+    std::map<uintptr_t, SourceData> m_sources;
+    std::map<uintptr_t, VoiceData> m_voices;
+    std::map<std::string, uint32_t> m_lengths;
+    uintptr_t m_nextID;
+    uint32_t m_positionUpdates;
+};
+
+// ========================================================================= //
+
+// Getters:
+
+inline const size_t NullAudioBackend::getSourceCount(void) const{
+    return m_sources.size();
+}
+
+inline const size_t NullAudioBackend::getVoiceCount(void) const{
+    return m_voices.size();
+}
+
+inline const uint32_t NullAudioBackend::getPositionUpdates(void) const{
+    return m_positionUpdates;
+}
+
+// Setters:
+
+inline void NullAudioBackend::setLength(const std::string& file,
+                                        const uint32_t length){
+    m_lengths[file] = length;
+}
+
+// ========================================================================= //
+
+#endif
+
+// ========================================================================= //
\ No newline at end of file
@@ -0,0 +1,273 @@
+// ========================================================================= //
+// Talos - A 3D game engine with network multiplayer.
+// Copyright(C) 2015 Jordan Sparks <unixunited@live.com>
+//
+// This program is free software; you can redistribute it and / or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 3
+// of the License, or(at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+// ========================================================================= //
+// File: SoundBank.cpp
+// Author: Jordan Sparks <unixunited@live.com>
+// ========================================================================= //
+// Implements SoundBank class.
+// ========================================================================= //
+
+#include "SoundBank.hpp"
+
+// ========================================================================= //
+
+SoundBank::SoundBank(AudioBackend* backend) :
+m_backend(backend),
+m_sounds(),
+m_files(),
+m_lru(),
+m_memory(0),
+m_budget(64 * 1024 * 1024),
+m_misses(0)
+{
+
+}
+
+// ========================================================================= //
+
+SoundBank::~SoundBank(void)
+{
+    this->clear();
+}
+
+// ========================================================================= //
+
+SoundBank::Handle SoundBank::add(const std::string& file, const Mode mode)
+{
+    std::unordered_map<std::string, Handle>::const_iterator itr =
+        m_files.find(file);
+    if (itr != m_files.end()){
+        return itr->second;
+    }
+
+    Sound sound;
+    sound.file = file;
+    sound.mode = mode;
+    sound.source = nullptr;
+    sound.size = 0;
+    sound.length = 0;
+    sound.uses = 0;
+    sound.request = Talos::IOService::InvalidRequest;
+    sound.failed = false;
+    sound.lru = m_lru.end();
+
+    const Handle handle = static_cast<Handle>(m_sounds.size());
+    m_sounds.push_back(sound);
+    m_files[file] = handle;
+
+    return handle;
+}
+
+// ========================================================================= //
+
+void SoundBank::install(const Handle handle, AudioBackend::Source source)
+{
+    Sound& sound = m_sounds[handle];
+    if (source == nullptr){
+        Talos::Log::getSingleton().log("SoundBank: Failed to load " +
+                                       sound.file);
+        sound.failed = true;
+        return;
+    }
+
+    sound.source = source;
+    sound.size = m_backend->getSize(source);
+    sound.length = m_backend->getLength(source);
+    m_memory += sound.size;
+
+    if (sound.mode == Mode::Preload){
+        sound.lru = m_lru.insert(m_lru.begin(), handle);
+    }
+}
+
+// ========================================================================= //
+
+void SoundBank::onRead(const Handle handle,
+                       const Talos::IOService::Result& result)
+{
+    Sound& sound = m_sounds[handle];
+    sound.request = Talos::IOService::InvalidRequest;
+    // Loaded by preload() in the meantime.
+    if (sound.source != nullptr){
+        return;
+    }
+
+    // The head read has brought the file into the OS cache, so opening the
+    // stream doesn't wait on disk. Files shorter than the head fail the
+    // read; opening tells whether they exist.
+    if (sound.mode == Mode::Stream){
+        this->install(handle, m_backend->load(sound.file, true));
+        return;
+    }
+
+    // Decode from memory here; the backend is not thread-safe.
+    this->install(handle, (result.ok) ?
+                  m_backend->load(sound.file, result.data, result.size) :
+                  nullptr);
+}
+
+// ========================================================================= //
+
+void SoundBank::read(const Handle handle,
+                     const Talos::IOService::Priority priority)
+{
+    Sound& sound = m_sounds[handle];
+
+    // Only the head of a stream is read; the mixer's thread reads the rest.
+    uint64_t size = Talos::IOService::WholeFile;
+    if (sound.mode == Mode::Stream){
+        size = StreamHeadSize;
+    }
+    sound.request = Talos::IOService::getSingleton().read(
+        sound.file,
+        [this, handle](const Talos::IOService::Result& result){
+            this->onRead(handle, result);
+        },
+        priority,
+        0,
+        size);
+}
+
+// ========================================================================= //
+
+void SoundBank::preload(void)
+{
+    for (Handle i = 0; i < m_sounds.size(); ++i){
+        const Sound& sound = m_sounds[i];
+        if (sound.source != nullptr || sound.failed){
+            continue;
+        }
+
+        const bool stream = (sound.mode == Mode::Stream);
+        if (stream == false && m_memory >= m_budget){
+            continue;
+        }
+
+        this->install(i, m_backend->load(sound.file, stream));
+    }
+}
+
+// ========================================================================= //
+
+void SoundBank::update(void)
+{
+    if (m_memory > m_budget){
+        this->evict(0);
+    }
+}
+
+// ========================================================================= //
+
+AudioBackend::Source SoundBank::acquire(const Handle handle)
+{
+    Sound& sound = m_sounds[handle];
+    if (sound.source != nullptr){
+        ++sound.uses;
+        if (sound.lru != m_lru.end()){
+            m_lru.splice(m_lru.begin(), m_lru, sound.lru);
+        }
+
+        return sound.source;
+    }
+
+    if (sound.failed || sound.request != Talos::IOService::InvalidRequest){
+        return nullptr;
+    }
+
+    ++m_misses;
+
+    // Something wants to play it, so it goes ahead of prefetching.
+    this->read(handle, Talos::IOService::Priority::High);
+
+    return nullptr;
+}
+
+// ========================================================================= //
+
+void SoundBank::prefetch(const Handle handle)
+{
+    const Sound& sound = m_sounds[handle];
+    if (sound.source != nullptr ||
+        sound.length > 0 ||
+        sound.failed ||
+        sound.request != Talos::IOService::InvalidRequest){
+        return;
+    }
+
+    this->read(handle, Talos::IOService::Priority::Normal);
+}
+
+// ========================================================================= //
+
+void SoundBank::release(const Handle handle)
+{
+    Assert(m_sounds[handle].uses > 0, "SoundBank release without acquire");
+
+    --m_sounds[handle].uses;
+}
+
+// ========================================================================= //
+
+void SoundBank::evict(const size_t needed)
+{
+    std::list<Handle>::iterator itr = m_lru.end();
+    while (itr != m_lru.begin() && m_memory + needed > m_budget){
+        --itr;
+
+        Sound& sound = m_sounds[*itr];
+        if (sound.uses > 0){
+            continue;
+        }
+
+        m_backend->unload(sound.source);
+        m_memory -= sound.size;
+        sound.source = nullptr;
+        sound.size = 0;
+        sound.lru = m_lru.end();
+        itr = m_lru.erase(itr);
+    }
+}
+
+// ========================================================================= //
+
+void SoundBank::clear(void)
+{
+    for (auto& sound : m_sounds){
+        Assert(sound.uses == 0, "SoundBank cleared while playing");
+        if (sound.source != nullptr){
+            m_backend->unload(sound.source);
+        }
+    }
+
+    // Reads still outstanding are for handles about to be forgotten. The
+    // IOService may already be gone when the bank is destroyed at exit.
+    Talos::IOService* io = Talos::IOService::getSingletonPtr();
+    if (io != nullptr){
+        for (auto& sound : m_sounds){
+            if (sound.request != Talos::IOService::InvalidRequest){
+                io->cancel(sound.request);
+            }
+        }
+    }
+
+    m_sounds.clear();
+    m_files.clear();
+    m_lru.clear();
+    m_memory = 0;
+}
+
+// ========================================================================= //
\ No newline at end of file
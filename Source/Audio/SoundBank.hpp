@@ -0,0 +1,197 @@
+// ========================================================================= //
+// Talos - A 3D game engine with network multiplayer.
+// Copyright(C) 2015 Jordan Sparks <unixunited@live.com>
+//
+// This program is free software; you can redistribute it and / or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 3
+// of the License, or(at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+// ========================================================================= //
+// File: SoundBank.hpp
+// Author: Jordan Sparks <unixunited@live.com>
+// ========================================================================= //
+// Defines SoundBank class.
+// ========================================================================= //
+
+#ifndef __SOUNDBANK_HPP__
+#define __SOUNDBANK_HPP__
+
+// ========================================================================= //
+
+#include "AudioBackend.hpp"
+#include "IO/IOService.hpp"
+
+#include <unordered_map>
+
+// ========================================================================= //
+// Cache of sound sources referenced by handle. Short effects are decoded
+// into shared in-memory buffers, long ambience and music are streamed from
+// disk by the mixer. Decoded sounds are kept within a memory budget,
+// evicting the least recently used ones not playing. Sounds are normally
+// loaded by preload() during state load; a sound that is not resident when
+// played is read by the IOService and installed when the read completes, as
+// is a stream not yet opened, so playing a sound never waits on disk on the
+// game thread.
+class SoundBank final
+{
+public:
+    typedef uint32_t Handle;
+
+    static const Handle InvalidHandle = 0xFFFFFFFF;
+
+    enum class Mode{
+        // Decoded into memory, counted against the budget.
+        Preload = 0,
+        // Streamed from disk while playing.
+        Stream
+    };
+
+    // Stores the backend.
+    explicit SoundBank(AudioBackend* backend);
+
+    // Cancels outstanding reads and unloads every sound.
+    ~SoundBank(void);
+
+    // Registers file and returns its handle, or the existing handle if
+    // already registered. Does not load anything.
+    Handle add(const std::string& file, const Mode mode = Mode::Preload);
+
+    // Loads every registered sound that is not resident, on the calling
+    // thread. Meant for state load; stops adding decoded sounds once the
+    // budget is full.
+    void preload(void);
+
+    // Enforces the budget. Called once per tick.
+    void update(void);
+
+    // Returns the sound's source for playing and marks it in use, or
+    // nullptr if it is not resident yet, in which case it is queued for
+    // loading. Each non-null acquire must be matched by release().
+    AudioBackend::Source acquire(const Handle handle);
+
+    // Queues the sound for loading if it is not resident and has never been
+    // loaded, so its length is known before anything tries to play it.
+    void prefetch(const Handle handle);
+
+    // Marks one use of the sound finished.
+    void release(const Handle handle);
+
+    // Unloads every sound and forgets all registrations. Nothing may be
+    // playing.
+    void clear(void);
+
+    // Getters:
+
+    // Returns length of sound in milliseconds, 0 if unknown or never loaded.
+    // Kept after the sound is evicted.
+    const uint32_t getLength(const Handle handle) const;
+
+    // Returns true if the sound can be played without loading.
+    const bool isResident(const Handle handle) const;
+
+    // Returns true if the sound could not be read or decoded.
+    const bool isFailed(const Handle handle) const;
+
+    // Returns bytes of decoded sound data held.
+    const size_t getMemoryUsage(void) const;
+
+    // Returns memory budget in bytes.
+    const size_t getBudget(void) const;
+
+    // Returns number of acquires that found the sound not resident.
+    const uint32_t getMisses(void) const;
+
+    // Setters:
+
+    // Sets memory budget in bytes for decoded sounds.
+    void setBudget(const size_t budget);
+
+private:
+    // Bytes of a stream read ahead of opening it.
+    static const uint64_t StreamHeadSize = 64 * 1024;
+
+    struct Sound{
+        std::string file;
+        Mode mode;
+        AudioBackend::Source source;
+        size_t size;
+        uint32_t length;
+        uint32_t uses;
+        // Outstanding read, or IOService::InvalidRequest.
+        Talos::IOService::RequestID request;
+        // Could not be read or decoded; not retried.
+        bool failed;
+        // Position in m_lru, valid while resident and decoded.
+        std::list<Handle>::iterator lru;
+    };
+
+    // Queues an IOService read of the sound, installed by onRead().
+    void read(const Handle handle, const Talos::IOService::Priority priority);
+
+    // Records a newly loaded source.
+    void install(const Handle handle, AudioBackend::Source source);
+
+    // Installs a sound read by the IOService. Runs on the main thread.
+    void onRead(const Handle handle, const Talos::IOService::Result& result);
+
+    // Unloads least recently used sounds not in use until memory usage
+    // plus needed fits the budget, or nothing more can go.
+    void evict(const size_t needed);
+
+    AudioBackend* m_backend;
+    std::vector<Sound> m_sounds;
+    std::unordered_map<std::string, Handle> m_files;
+    // Most recently used first.
+    std::list<Handle> m_lru;
+    size_t m_memory;
+    size_t m_budget;
+    uint32_t m_misses;
+};
+
+// ========================================================================= //
+
+// Getters:
+
+inline const uint32_t SoundBank::getLength(const Handle handle) const{
+    return m_sounds[handle].length;
+}
+
+inline const bool SoundBank::isResident(const Handle handle) const{
+    return (m_sounds[handle].source != nullptr);
+}
+
+inline const bool SoundBank::isFailed(const Handle handle) const{
+    return m_sounds[handle].failed;
+}
+
+inline const size_t SoundBank::getMemoryUsage(void) const{
+    return m_memory;
+}
+
+inline const size_t SoundBank::getBudget(void) const{
+    return m_budget;
+}
+
+inline const uint32_t SoundBank::getMisses(void) const{
+    return m_misses;
+}
+
+// Setters:
+
+inline void SoundBank::setBudget(const size_t budget){
+    m_budget = budget;
+}
+
+// ========================================================================= //
+
+#endif
+
+// ========================================================================= //
\ No newline at end of file
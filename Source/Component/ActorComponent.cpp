@@ -33,6 +33,11 @@
 
 // ========================================================================= //
 
+// Degrees turned per pixel of mouse motion.
+static const Ogre::Real SLookSensitivity = 0.2f;
+
+// ========================================================================= //
+
 ActorComponent::ActorComponent(void) :
 SceneComponent(),
 m_rootNode(nullptr),
@@ -185,7 +190,7 @@ void ActorComponent::update(void)
         return;
     }
 
-    printf("look: %.2f, %.2f\n", x, y);
+    LogDebug("look: %.2f, %.2f", x, y);
 
     const Ogre::Real sens = 0.70f;
 
@@ -358,6 +363,10 @@ void ActorComponent::applyInput(const CommandType& type)
     case CommandType::Jump:
         m_kcc->jump();
         return;        
+
+    case CommandType::Spectator:
+        this->setMode(Mode::Spectator);
+        return;
     }
 
     // Calculate movement vector.
@@ -464,10 +473,8 @@ void ActorComponent::look(const Sint16 relx, const Sint16 rely)
         return;
     }
 
-    const Ogre::Real sens = 0.2f;
-
-    m_yawNode->yaw(Ogre::Degree(-Ogre::Real(relx) * sens));
-    m_pitchNode->pitch(Ogre::Degree(-Ogre::Real(rely) * sens));
+    m_yawNode->yaw(Ogre::Degree(-Ogre::Real(relx) * SLookSensitivity));
+    m_pitchNode->pitch(Ogre::Degree(-Ogre::Real(rely) * SLookSensitivity));
     {
         // Prevent the camera from pitching upside down.
         Ogre::Real pitchAngle = 0.f;
@@ -506,6 +513,38 @@ void ActorComponent::look(const Sint16 relx, const Sint16 rely)
 
 // ========================================================================= //
 
+const Ogre::Quaternion ActorComponent::getLookOffset(const int32_t relx,
+                                                     const int32_t rely) const
+{
+    if (relx == 0 && rely == 0){
+        return Ogre::Quaternion::IDENTITY;
+    }
+
+    const Ogre::Quaternion yaw(
+        Ogre::Degree(-Ogre::Real(relx) * SLookSensitivity),
+        Ogre::Vector3::UNIT_Y);
+    Ogre::Quaternion pitch(
+        Ogre::Degree(-Ogre::Real(rely) * SLookSensitivity),
+        Ogre::Vector3::UNIT_X);
+
+    // Leave pitch out rather than show it past look()'s limit.
+    const Ogre::Quaternion& p = m_pitchNode->getOrientation();
+    const Ogre::Real pitchAngle = 2.f * Ogre::Degree(
+        Ogre::Math::ACos((p * pitch).w)).valueDegrees();
+    if (pitchAngle > 80.f){
+        pitch = Ogre::Quaternion::IDENTITY;
+    }
+
+    // Below the actor's root the view is Y * P * R now, and would be
+    // Y * yaw * P * pitch * R after look(). Solve for the rotation to
+    // append below the roll node.
+    const Ogre::Quaternion& r = m_rollNode->getOrientation();
+
+    return r.Inverse() * p.Inverse() * yaw * p * pitch * r;
+}
+
+// ========================================================================= //
+
 void ActorComponent::action(void)
 {    
     // Construct a direction from the player's origin going forward in the 
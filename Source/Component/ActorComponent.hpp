@@ -84,6 +84,12 @@ public:
     // Changes the actor's orientation based on relative x/y looking.
     void look(const Sint16 relx, const Sint16 rely);
 
+    // Returns the rotation, relative to the camera's node, that look() with
+    // this mouse motion would add to the view. Changes nothing; used to show
+    // mouse motion the simulation has not consumed yet.
+    const Ogre::Quaternion getLookOffset(const int32_t relx,
+                                         const int32_t rely) const;
+
     // Casts a ray forward from the player, sending an action message to the 
     // receiving entity, if one is hit and within range.
     void action(void);
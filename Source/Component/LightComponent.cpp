@@ -23,6 +23,7 @@
 
 #include "ComponentMessage.hpp"
 #include "LightComponent.hpp"
+#include "Rendering/ShadowManager.hpp"
 #include "World/World.hpp"
 
 // ========================================================================= //
@@ -47,7 +48,7 @@ LightComponent::~LightComponent(void)
 void LightComponent::init(void)
 {
     m_light = this->getWorld()->getSceneManager()->createLight();
-    m_light->setCastShadows(true);
+    this->getWorld()->getShadowManager()->addLight(m_light);
 
     // Set to point light by default.
     m_light->setType(Ogre::Light::LT_POINT);
@@ -60,6 +61,7 @@ void LightComponent::init(void)
 
 void LightComponent::destroy(void)
 {
+    this->getWorld()->getShadowManager()->removeLight(m_light);
     this->getWorld()->getSceneManager()->destroyLight(m_light);
 }
 
@@ -119,7 +121,7 @@ void LightComponent::setType(const Type& type)
     m_type = type;
 
     if (m_type == Type::Spotlight){
-        m_light->setCastShadows(true);
+        this->getWorld()->getShadowManager()->setCastShadows(m_light, true);
     }
 }
 
@@ -21,7 +21,7 @@
 // Implements MultiModelComponent class.
 // ========================================================================= //
 
-#include "Loader/DotSceneLoader.hpp"
+#include "Loader/SceneLoadQueue.hpp"
 #include "MultiModelComponent.hpp"
 #include "World/World.hpp"
 
@@ -29,7 +29,8 @@
 
 MultiModelComponent::MultiModelComponent(void) :
 m_sceneFile(),
-m_mat()
+m_mat(),
+m_loader(nullptr)
 {
 
 }
@@ -45,7 +46,11 @@ MultiModelComponent::~MultiModelComponent(void)
 
 void MultiModelComponent::destroy(void)
 {
-
+    // Stop streaming the scene in if it is still loading.
+    if (m_loader){
+        m_loader->cancel();
+        m_loader.reset();
+    }
 }
 
 // ========================================================================= //
@@ -72,13 +77,58 @@ void MultiModelComponent::setMesh(const std::string& file,
 
 void MultiModelComponent::setup(Ogre::SceneNode* attachNode)
 {
-    DotSceneLoader loader;
-    loader.parseDotScene(m_sceneFile,
-                         "General",
-                         this->getWorld()->getSceneManager(),
-                         attachNode);
+    // Scenes may live in a state's or map's resource group.
+    std::string group = Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME;
+    try{
+        group = Ogre::ResourceGroupManager::getSingleton().
+            findGroupContainingResource(m_sceneFile);
+    }
+    catch (Ogre::Exception&){
+        // Not found anywhere; the cache logs the failure.
+    }
+
+    // Only the first instance of a scene reads it; the rest clone the cached
+    // template. Node names are prefixed to keep instances unique.
+    SceneTemplateCache::SceneTemplatePtr sceneTemplate =
+        this->getWorld()->getSceneTemplateCache()->get(m_sceneFile, group);
+    if (sceneTemplate && sceneTemplate->isDotScene()){
+        // Cameras, particle systems and planes only come from the XML.
+        sceneTemplate->instantiate(this->getWorld()->getSceneManager(),
+                                   attachNode,
+                                   attachNode->getName() + "/");
+    }
+    else if (sceneTemplate){
+        // Nodes are created now; entities stream in over the next ticks.
+        m_loader.reset(new IncrementalSceneLoader(
+            sceneTemplate,
+            this->getWorld()->getSceneManager(),
+            attachNode,
+            attachNode->getName() + "/"));
+        m_loader->start();
+        this->getWorld()->getSceneLoadQueue()->add(m_loader);
+    }
 
     m_sceneFile.clear();
 }
 
+// ========================================================================= //
+
+void MultiModelComponent::setEntityCallback(
+    const IncrementalSceneLoader::EntityCallback& callback)
+{
+    if (m_loader){
+        m_loader->setEntityCallback(callback);
+    }
+}
+
+// ========================================================================= //
+
+void MultiModelComponent::createWithin(const Ogre::Vector3& focus,
+                                       const Ogre::Real radius)
+{
+    if (m_loader){
+        m_loader->createWithin(focus, radius);
+    }
+}
+
 // ========================================================================= //
\ No newline at end of file
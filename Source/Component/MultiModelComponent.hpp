@@ -27,6 +27,7 @@
 // ========================================================================= //
 
 #include "Component.hpp"
+#include "Loader/IncrementalSceneLoader.hpp"
 
 // ========================================================================= //
 // A 3D model consisting of multiple .mesh files, attached to a single scene
@@ -50,12 +51,24 @@ public:
     virtual void setMesh(const std::string& file,
                          const std::string& mat = "");
 
-    // Parses .scene file, attachs all entities to attachNode.
+    // Creates the scene file's nodes below attachNode and queues its
+    // entities to stream in over the following ticks. Scenes only
+    // DotSceneLoader can create are created whole, at once.
     void setup(Ogre::SceneNode* attachNode);
 
+    // Sets function called for each entity as it streams in. Must be called
+    // after setup().
+    void setEntityCallback(
+        const IncrementalSceneLoader::EntityCallback& callback);
+
+    // Creates the entities and lights within radius of focus immediately
+    // instead of streaming them in. Must be called after setup().
+    void createWithin(const Ogre::Vector3& focus, const Ogre::Real radius);
+
 private:
     std::string m_sceneFile;
     std::string m_mat;
+    std::shared_ptr<IncrementalSceneLoader> m_loader;
 };
 
 // ========================================================================= //
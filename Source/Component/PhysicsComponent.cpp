@@ -65,7 +65,8 @@ void PhysicsComponent::init(EntityPtr entity)
         m_mat = this->getWorld()->getPScene()->getDefaultMaterial();
     }
 
-    // Add all attach meshes for multi-model.
+    // Add meshes already attached for multi-model. Meshes streamed in later
+    // are added through MultiModelComponent's entity callback.
     if (entity->hasComponent<MultiModelComponent>()){
         auto rootNode = entity->getComponent<SceneComponent>()->getSceneNode();
         auto itr = rootNode->getChildIterator();
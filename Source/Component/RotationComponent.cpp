@@ -130,8 +130,14 @@ void RotationComponent::setup(SceneComponentPtr sceneC)
             rotation->node = sceneC->getSceneNode();
         }
         else{
-            // Find the child scene node with the name.
-            Ogre::SceneNode* node = findChild(sceneC->getSceneNode(), *name);
+            // Find the child scene node with the name. Multi-model scene
+            // nodes are prefixed with the root scene node's name.
+            Ogre::SceneNode* root = sceneC->getSceneNode();
+            Ogre::SceneNode* node = findChild(root,
+                                              root->getName() + "/" + *name);
+            if (node == nullptr){
+                node = findChild(root, *name);
+            }
             if (node){
                 rotation->node = node;
             }
@@ -86,7 +86,7 @@ void SceneComponent::message(ComponentMessage& msg)
         break;
 
     case ComponentMessage::Type::Hitscan:
-        printf("Hitscan received!\n");
+        LogDebug("Hitscan received!");
         break;
     }
 }
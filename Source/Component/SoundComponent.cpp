@@ -21,6 +21,7 @@
 // Implements SoundComponent class.
 // ========================================================================= //
 
+#include "Audio/AudioManager.hpp"
 #include "ComponentMessage.hpp"
 #include "SoundComponent.hpp"
 #include "World/World.hpp"
@@ -28,7 +29,7 @@
 // ========================================================================= //
 
 SoundComponent::SoundComponent(void) :
-m_sound(nullptr),
+m_sound(AudioManager::InvalidHandle),
 m_node(nullptr),
 m_looped(true)
 {
@@ -46,8 +47,9 @@ SoundComponent::~SoundComponent(void)
 
 void SoundComponent::destroy(void)
 {
-    if (m_sound){
-        m_sound->drop();
+    if (m_sound != AudioManager::InvalidHandle){
+        this->getWorld()->getAudioManager()->stop(m_sound);
+        m_sound = AudioManager::InvalidHandle;
     }
 }
 
@@ -55,15 +57,16 @@ void SoundComponent::destroy(void)
 
 void SoundComponent::update(void)
 {
-    // Update 3D position of sound.
-    if (m_sound){
-        Ogre::Vector3 pos = m_node->_getDerivedPosition();
+    // Update 3D position of sound; the manager only forwards it to the
+    // mixer if the sound is playing.
+    if (m_sound != AudioManager::InvalidHandle){
+        std::shared_ptr<AudioManager> audio = this->getWorld()->getAudioManager();
 
-        m_sound->setPosition(irrklang::vec3df(pos.x, pos.y, pos.z));
+        audio->setPosition(m_sound, m_node->_getDerivedPosition());
 
-        if (m_sound->isFinished()){
-            m_sound->drop();
-            m_sound = nullptr;
+        if (audio->isFinished(m_sound)){
+            audio->stop(m_sound);
+            m_sound = AudioManager::InvalidHandle;
         }
     }    
 }
@@ -78,8 +81,8 @@ void SoundComponent::message(ComponentMessage& msg)
 
     case ComponentMessage::Type::Action:
         if (!m_looped){
-            if (m_sound){
-                m_sound->setIsPaused(false);
+            if (m_sound != AudioManager::InvalidHandle){
+                this->getWorld()->getAudioManager()->setPaused(m_sound, false);
             }
         }
         break;
@@ -96,14 +99,18 @@ void SoundComponent::addSound(const std::string& file, const bool looped)
 {
     m_looped = looped;
 
-    irrklang::ISoundEngine* soundEngine = this->getWorld()->getSoundEngine();
-    irrklang::vec3df pos(0.f, 0.f, 0.f);
+    std::shared_ptr<AudioManager> audio = this->getWorld()->getAudioManager();
+    if (m_sound != AudioManager::InvalidHandle){
+        audio->stop(m_sound);
+    }
 
-    m_sound = soundEngine->play3D(file.c_str(),
-                                  pos,
-                                  m_looped,
-                                  !m_looped,
-                                  true);
+    // One-shot sounds wait for an Action message.
+    m_sound = audio->play(audio->getSoundBank()->add(file),
+                          (m_node != nullptr) ?
+                          m_node->_getDerivedPosition() :
+                          Ogre::Vector3::ZERO,
+                          m_looped,
+                          !m_looped);
 }
 
 // ========================================================================= //
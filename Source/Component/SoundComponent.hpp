@@ -29,7 +29,8 @@
 #include "Component.hpp"
 
 // ========================================================================= //
-// Associates a 3D sound with an entity.
+// Associates a 3D sound with an entity. The sound is an AudioManager
+// emitter, so it only holds a mixer voice while it is among the most audible.
 class SoundComponent final : public Component
 {
 public:
@@ -51,7 +52,7 @@ public:
     void setSceneNode(Ogre::SceneNode* node);
 
 private:
-    irrklang::ISound* m_sound;
+    uint32_t m_sound;
     Ogre::SceneNode* m_node;
     bool m_looped;
 };
@@ -24,6 +24,7 @@
 #include "ComponentMessage.hpp"
 #include "Core/Talos.hpp"
 #include "Entity/Entity.hpp"
+#include "Memory/FrameArena.hpp"
 #include "Physics/PScene.hpp"
 #include "WeaponComponent.hpp"
 #include "Weapon/AttackFlare.hpp"
@@ -186,20 +187,30 @@ void WeaponComponent::hitscan(void)
                                                                      ray.dir,
                                                                      ray.dist,
                                                                      buf);
-    if (hasHit){
-        for (PxU32 i = 0; i < buf.nbTouches; ++i){
-            if (buf.touches[i].distance > 0.f){
-                const EntityID id = Physics::toEntityID(buf.touches[i].actor);
-                EntityPtr entity = this->getWorld()->getEntityPtr(id);
-
-                if (entity){
-                    ComponentMessage msg(ComponentMessage::Type::Hitscan);
-                    entity->message(msg);
-                    printf("Hit iD: %d\n", id);
-                }
+    if (hasHit == false){
+        return;
+    }
+
+    // Collect a hit per touched shape. The list only lives for this tick, so
+    // it comes from the frame arena.
+    std::vector<EntityPtr, Talos::FrameAllocator<EntityPtr>> hits;
+    hits.reserve(buf.nbTouches);
+    for (PxU32 i = 0; i < buf.nbTouches; ++i){
+        if (buf.touches[i].distance > 0.f){
+            const EntityID id = Physics::toEntityID(buf.touches[i].actor);
+            EntityPtr entity = this->getWorld()->getEntityPtr(id);
+
+            if (entity){
+                hits.push_back(entity);
+                LogDebug("Hit ID: %d", id);
             }
         }
     }
+
+    for (auto& entity : hits){
+        ComponentMessage msg(ComponentMessage::Type::Hitscan);
+        entity->message(msg);
+    }
 }
 
 // ========================================================================= //
@@ -30,9 +30,13 @@ namespace Talos
 
 // ========================================================================= //
 
+// Returned for values that are not found.
+static const std::string SEmptyValue;
+
+// ========================================================================= //
+
 Config::Config(void) :
-m_file(),
-m_buffer(),
+m_sections(),
 m_loaded(false)
 {
 
@@ -41,8 +45,7 @@ m_loaded(false)
 // ========================================================================= //
 
 Config::Config(const std::string& file) :
-m_file(),
-m_buffer(),
+m_sections(),
 m_loaded(false)
 {
     this->load(file);
@@ -59,117 +62,120 @@ Config::~Config(void)
 
 bool Config::load(const std::string& file)
 {
-    if (m_loaded){
-        m_file.close();
-        m_loaded = false;
+    m_sections.clear();
+    m_loaded = false;
+
+    std::ifstream in(file);
+    if (in.is_open() == false){
+        return false;
     }
 
-    m_file.open(file);
-    if (m_file.is_open()){
-        m_loaded = true;
+    // Keys before the first section header belong to section "".
+    Section* section = &m_sections[""];
+    std::string line;
+    while (std::getline(in, line)){
+        Ogre::StringUtil::trim(line);
+
+        // Skip blank lines and comments.
+        if (line.empty() || line[0] == '#'){
+            continue;
+        }
+
+        if (line[0] == '[' && line[line.size() - 1] == ']'){
+            section = &m_sections[line.substr(1, line.size() - 2)];
+            continue;
+        }
+
+        const size_t assign = line.find_first_of('=');
+        if (assign == std::string::npos){
+            continue;
+        }
+
+        std::string key = line.substr(0, assign);
+        Ogre::StringUtil::trim(key);
+
+        // Convert once here; the first occurrence of a key wins, as it did
+        // when the file was scanned for each lookup.
+        if (section->find(key) != section->end()){
+            continue;
+        }
+        Value& value = (*section)[key];
+        value.str = line.substr(assign + 1);
+        Ogre::StringUtil::trim(value.str);
+        value.real = Ogre::StringConverter::parseReal(value.str);
+        value.integer = Ogre::StringConverter::parseInt(value.str);
+        value.boolean = (value.integer >= 1 ||
+                         Ogre::StringConverter::parseBool(value.str));
     }
-    
+
+    m_loaded = true;
+
     return m_loaded;
 }
 
 // ========================================================================= //
 
-std::string& Config::parseValue(const std::string& section,
-                                const std::string& key)
+const std::string& Config::parseValue(const std::string& section,
+                                      const std::string& key) const
 {
-    if (!m_loaded){
-        m_buffer.clear();
-        return m_buffer;
-    }
-
-    // Always start scanning from the first line.
-    m_file.clear();
-    m_file.seekg(0, m_file.beg);
-
-    while (!m_file.eof()){
-        std::getline(m_file, m_buffer);
-        // Find the right section first.
-        if (m_buffer[0] == '[' && m_buffer[m_buffer.size() - 1] == ']'){
-            std::string compare(section);
-            if (m_buffer.compare(1, m_buffer.size() - 2, compare) == 0){
-                // Section found, now find the value.
-                std::getline(m_file, m_buffer);
-                // @TODO: There must always be a \n at the end of a config
-                // file with !m_file.eof().
-                while (m_buffer[0] != '[' && !m_file.eof()){ 
-
-                    // Skip comments.
-                    if (m_buffer[0] != '#'){
-                        // Find location of assignment operator.
-                        size_t assign = m_buffer.find_first_of('=');
-
-                        // See if pos 0 to the assignment operator matches
-                        // value name.
-                        if (m_buffer.compare(0, assign, key) == 0){
-                            // Trim string to only contain the value.
-                            /*if (quotations){
-                                m_buffer = m_buffer.substr(
-                                    assign + 2, 
-                                    m_buffer.size() - key.size() - 3);
-                            }*/
-                            //else{
-                                m_buffer = m_buffer.substr(
-                                    assign + 1, 
-                                    m_buffer.size() - key.size() - 1);
-                            //}
-
-                            return m_buffer;
-                        }
-                    }
-
-                    std::getline(m_file, m_buffer);
-                }
-            }
-        }
-    }
+    const Value* value = this->getValue(section, key);
 
-    // Value not found.
-    m_buffer.clear();
-    return m_buffer;
+    return (value != nullptr) ? value->str : SEmptyValue;
 }
 
 // ========================================================================= //
 
 const Ogre::Real Config::parseReal(const std::string& section,
-                                   const std::string& key)
+                                   const std::string& key) const
 {
-    std::string str = this->parseValue(section, key);
-    if (!str.empty()){
-        return std::stof(str);
-    }
+    const Value* value = this->getValue(section, key);
 
-    return 0.f;
+    return (value != nullptr) ? value->real : 0.f;
 }
 
 // ========================================================================= //
 
 const int Config::parseInt(const std::string& section,
-                           const std::string& key)
+                           const std::string& key) const
 {
-    std::string str = this->parseValue(section, key);
-    if (!str.empty()){
-        return std::stoi(str);
-    }
+    const Value* value = this->getValue(section, key);
 
-    return 0;
+    return (value != nullptr) ? value->integer : 0;
 }
 
 // ========================================================================= //
 
 const bool Config::parseBool(const std::string& section,
-                             const std::string& key)
+                             const std::string& key) const
 {
-    std::string str = this->parseValue(section, key);
-    if (!str.empty()){
-        return (std::stoi(str) >= 1);
+    const Value* value = this->getValue(section, key);
+
+    return (value != nullptr) ? value->boolean : false;
+}
+
+// ========================================================================= //
+
+const Config::Value* Config::getValue(const std::string& section,
+                                      const std::string& key) const
+{
+    const Section* values = this->getSection(section);
+    if (values == nullptr){
+        return nullptr;
     }
 
-    return false;
+    Section::const_iterator itr = values->find(key);
+
+    return (itr != values->end()) ? &itr->second : nullptr;
+}
+
+// ========================================================================= //
+
+const Config::Section* Config::getSection(const std::string& section) const
+{
+    std::unordered_map<std::string, Section>::const_iterator itr =
+        m_sections.find(section);
+
+    return (itr != m_sections.end()) ? &itr->second : nullptr;
 }
 
 // ========================================================================= //
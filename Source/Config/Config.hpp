@@ -34,10 +34,23 @@ namespace Talos
 {; // Semicolon here as quick fix for visual studio's annoying indentation.
 
 // ========================================================================= //
-// A crude INI type config file parser.
+// A crude INI type config file parser. The file is parsed once on load into
+// sections of typed values, so lookups are hash lookups and need no string
+// conversion.
 class Config
 {
 public:
+    // A value converted to each type when the file is parsed.
+    struct Value{
+        std::string str;
+        Ogre::Real real;
+        int integer;
+        bool boolean;
+    };
+
+    // Values of one section by key.
+    typedef std::unordered_map<std::string, Value> Section;
+
     // Default initializes member data.
     explicit Config(void);
 
@@ -47,33 +60,40 @@ public:
     // Empty destructor.
     virtual ~Config(void);
 
-    // Opens the file in a std::ifstream.
+    // Parses the file into sections, replacing any previous contents.
     virtual bool load(const std::string& file);
 
-    // Parses value in section, returns string containing value.
-    virtual std::string& parseValue(const std::string& section, 
-                                    const std::string& key);
+    // Returns value in section as a string, empty if not found.
+    virtual const std::string& parseValue(const std::string& section,
+                                          const std::string& key) const;
 
-    // Parses value in section, returns Ogre::Real containing value.
+    // Returns value in section as Ogre::Real, 0 if not found.
     virtual const Ogre::Real parseReal(const std::string& section,
-                                       const std::string& key);
+                                       const std::string& key) const;
 
-    // Parses value in section, returns int containing value.
+    // Returns value in section as int, 0 if not found.
     virtual const int parseInt(const std::string& section,
-                               const std::string& key);
+                               const std::string& key) const;
 
-    // Parses value in section, returns bool containing value.
+    // Returns value in section as bool, false if not found.
     virtual const bool parseBool(const std::string& section,
-                                 const std::string& key);
+                                 const std::string& key) const;
 
     // Getters:
 
+    // Returns the value, or nullptr if not found. The pointer stays valid
+    // until the next load(), so hot code can look a value up once.
+    const Value* getValue(const std::string& section,
+                          const std::string& key) const;
+
+    // Returns the section, or nullptr if not found.
+    const Section* getSection(const std::string& section) const;
+
     // Returns true if file is loaded.
     const bool isLoaded(void) const;
 
 private:
-    std::ifstream m_file;
-    std::string m_buffer;
+    std::unordered_map<std::string, Section> m_sections;
     bool m_loaded;
 };
 
@@ -27,7 +27,10 @@
 #include "EngineState/LobbyState.hpp"
 #include "EngineState/MainMenuState.hpp"
 #include "EngineState/StartupState.hpp"
+#include "IO/IOService.hpp"
 #include "Input/Input.hpp"
+#include "Memory/FrameArena.hpp"
+#include "Metrics/Metrics.hpp"
 #include "Network/Client/Client.hpp"
 #include "Network/Server/Server.hpp"
 #include "Physics/Physics.hpp"
@@ -43,6 +46,7 @@ m_renderWindow(nullptr),
 m_viewport(nullptr),
 m_log(nullptr),
 m_timer(nullptr),
+m_packArchiveFactory(new PackArchiveFactory()),
 m_sdlWindow(nullptr),
 m_ceguiRenderer(nullptr),
 m_physics(nullptr),
@@ -79,8 +83,16 @@ bool Engine::init(void)
     // Allocate Talos Log singleton.
     new Talos::Log();
 
+    // Allocate runtime metrics registry.
+    new Talos::Metrics();
+
+    // Start file I/O threads.
+    new Talos::IOService();
+
     // Initialize Ogre's root component.
     m_root = new Ogre::Root();
+    Ogre::ArchiveManager::getSingleton().addArchiveFactory(
+        m_packArchiveFactory.get());
 
     // Set render system.
     Ogre::RenderSystem* rs = m_root->getRenderSystemByName(
@@ -177,6 +189,9 @@ bool Engine::init(void)
     m_ceguiRenderer = &CEGUI::OgreRenderer::bootstrapSystem(
         *(m_root->getRenderTarget("Talos"))); 
 
+    // UI enables rendering once it shows a layer.
+    m_ceguiRenderer->setRenderingEnabled(false);
+
     // === //
 
     // PhysX:
@@ -227,6 +242,11 @@ void Engine::shutdown(void)
     m_soundEngine->drop();
     m_physics->destroy();
     delete m_root;
+    delete Talos::IOService::getSingletonPtr();
+    Talos::Log::getSingleton().log("Frame arena high-water mark: " +
+        toString(Talos::FrameArena::get().getHighWaterMark()) + " bytes");
+    Talos::FrameArena::releaseThread();
+    delete Talos::Metrics::getSingletonPtr();
     delete Talos::Log::getSingletonPtr();
     delete Ogre::LogManager::getSingletonPtr();
 }
@@ -243,6 +263,22 @@ void Engine::start(const EngineStateID id)
     float prev = m_timer->getMilliseconds();
     float lag = 0.0;
 
+    Talos::Metrics& metrics = Talos::Metrics::getSingleton();
+    Talos::Metrics::Counter* ticks = metrics.getCounter(
+        "talos_ticks_total", "Fixed updates run.");
+    Talos::Metrics::Histogram* tickTime = metrics.getHistogram(
+        "talos_tick_duration_ms", "Time spent in one fixed update.");
+    Talos::Metrics::Histogram* frameTime = metrics.getHistogram(
+        "talos_frame_duration_ms", "Time spent rendering one frame.");
+    Talos::Metrics::Gauge* arenaHighWater = metrics.getGauge(
+        "talos_frame_arena_high_water_bytes", 
+        "Most frame arena memory used in one tick.");
+    Talos::Metrics::Gauge* arenaOverflows = metrics.getGauge(
+        "talos_frame_arena_overflows", 
+        "Frame arena allocations that fell back to the heap.");
+    Talos::FrameArena& arena = Talos::FrameArena::get();
+    Talos::IOService& io = Talos::IOService::getSingleton();
+
     while (m_active == true){
         // Check for window closing.
         if (m_renderWindow->isClosed()){
@@ -258,17 +294,37 @@ void Engine::start(const EngineStateID id)
             prev = current;
             lag += elapsed;
 
+            // Hand finished file reads to their requesters.
+            io.update();
+
             // Update the current state.
             while (lag >= Talos::MS_PER_UPDATE && m_active == true){
+                const unsigned long start = m_timer->getMicroseconds();
                 m_stateStack.top()->update();
+                tickTime->observe(
+                    (m_timer->getMicroseconds() - start) / 1000.0);
+                ticks->add();
+
+                // Transient data allocated during the tick is dead now.
+                arena.reset();
+                arenaHighWater->set(
+                    static_cast<double>(arena.getHighWaterMark()));
+                arenaOverflows->set(arena.getOverflowCount());
 
                 lag -= Talos::MS_PER_UPDATE;
             }
 
             //m_root->getRenderSystem()->clearFrameBuffer(Ogre::FBT_COLOUR | Ogre::FBT_DEPTH);
 
+            // Let the state show input the next update will handle.
+            if (m_active){
+                m_stateStack.top()->preRender();
+            }
+
             // Render the updated frame, compensating for lag.
+            const unsigned long start = m_timer->getMicroseconds();
             m_root->renderOneFrame(lag / Talos::MS_PER_UPDATE);
+            frameTime->observe((m_timer->getMicroseconds() - start) / 1000.0);
         }
     }
 }
@@ -342,6 +398,7 @@ void Engine::pushState(const EngineStateID id)
 
     // Initialize the state.
     state->setActive(true);
+    state->getResources()->load();
     state->enter();
 
     Talos::Log::getSingleton().log("Pushed engine state ID " + toString(id));
@@ -354,6 +411,7 @@ void Engine::popState(void)
     EngineStatePtr state = m_stateStack.top();
     state->setActive(false);
     state->exit();
+    state->getResources()->unload();
 
     Talos::Log::getSingleton().log("Popped engine state ID " + 
                                    toString(state->getID()));
@@ -380,6 +438,7 @@ void Engine::popAndPushState(const EngineStateID id)
     EngineStatePtr state = m_stateStack.top();
     state->setActive(false);
     state->exit();
+    state->getResources()->unload();
     m_stateStack.pop();
     
     Talos::Log::getSingleton().log("Popped engine state ID " +
@@ -391,6 +450,7 @@ void Engine::popAndPushState(const EngineStateID id)
 
     // Initialize.
     state->setActive(true);
+    state->getResources()->load();
     state->enter();
 
     Talos::Log::getSingleton().log("Pushed engine state ID " + toString(id));
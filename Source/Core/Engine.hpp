@@ -28,6 +28,7 @@
 
 #include "EngineState/EngineState.hpp"
 #include "EngineState/EngineStateID.hpp"
+#include "Loader/PackArchive.hpp"
 #include "Observer/Observer.hpp"
 #include "stdafx.hpp"
 
@@ -83,6 +84,9 @@ private:
     Ogre::Log* m_log;
     std::shared_ptr<Ogre::Timer> m_timer; // The core engine timer.
 
+    // Lets resource locations use packed archives ("Pack=...").
+    std::shared_ptr<PackArchiveFactory> m_packArchiveFactory;
+
     // Global graphics settings.
     Graphics m_graphics;
 
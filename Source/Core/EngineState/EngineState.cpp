@@ -26,10 +26,22 @@
 
 // ========================================================================= //
 
+// Resource manifest names by EngineStateID.
+static const char* SStateNames[] = {
+    "Startup",
+    "MainMenu",
+    "Lobby",
+    "Game",
+    "Paused"
+};
+
+// ========================================================================= //
+
 EngineState::EngineState(void) :
 m_subject(),
 m_world(new World()),
 m_ui(nullptr),
+m_resources(nullptr),
 m_active(false)
 {
 
@@ -42,4 +54,17 @@ EngineState::~EngineState(void)
 
 }
 
+// ========================================================================= //
+
+// Setters:
+
+// ========================================================================= //
+
+void EngineState::setID(const EngineStateID id)
+{
+    m_id = id;
+    m_resources.reset(new ResourceManifest(
+        std::string(ResourceManifest::StatePrefix) + SStateNames[id]));
+}
+
 // ========================================================================= //
\ No newline at end of file
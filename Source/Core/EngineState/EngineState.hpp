@@ -26,6 +26,7 @@
 
 // ========================================================================= //
 
+#include "Core/ResourceManifest.hpp"
 #include "EngineStateID.hpp"
 #include "Observer/Subject.hpp"
 #include "stdafx.hpp"
@@ -58,6 +59,9 @@ public:
     // Updates the state, should be called each frame when active.
     virtual void update(void) = 0;
 
+    // Called right before each frame is rendered, after any updates.
+    virtual void preRender(void) { }
+
     // Getters:
 
     // Returns Subject for adding Observer objects.
@@ -69,13 +73,17 @@ public:
     // Returns engine state ID.
     const EngineStateID getID(void) const;
 
+    // Returns the manifest of resources this state uses, loaded by Engine 
+    // around enter() and exit().
+    std::shared_ptr<ResourceManifest> getResources(void);
+
     // Setters:
 
     // Sets state to active or not. If true, the state will update itself.
     // Otherwise no updates will be performed.
     void setActive(const bool);
 
-    // Sets ID of this engine state.
+    // Sets ID of this engine state and names its resource manifest.
     void setID(const EngineStateID);
 
 protected:
@@ -85,6 +93,7 @@ protected:
     // State data.
     std::shared_ptr<World> m_world;
     std::shared_ptr<UI> m_ui;
+    std::shared_ptr<ResourceManifest> m_resources;
     bool m_active;
 
 private:
@@ -107,16 +116,16 @@ inline const EngineStateID EngineState::getID(void) const{
     return m_id;
 }
 
+inline std::shared_ptr<ResourceManifest> EngineState::getResources(void){
+    return m_resources;
+}
+
 // Setters:
 
 inline void EngineState::setActive(const bool active){
     m_active = active;
 }
 
-inline void EngineState::setID(const EngineStateID id){
-    m_id = id;
-}
-
 // ========================================================================= //
 
 #endif
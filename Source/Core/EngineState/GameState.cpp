@@ -21,6 +21,7 @@
 // Implements GameState class.
 // ========================================================================= //
 
+#include "Audio/AudioManager.hpp"
 #include "Command/Command.hpp"
 #include "Component/AllComponents.hpp"
 #include "Core/EngineNotifications.hpp"
@@ -35,12 +36,20 @@
 #include "System/CollisionSystem.hpp"
 #include "System/PhysicsSystem.hpp"
 #include "World/Environment.hpp"
+#include "World/WorldStreamer.hpp"
 
 // ========================================================================= //
 
-GameState::GameState(void)
-{
+// Map loaded unless setMap() chooses another.
+static const char* SDefaultMap = "tower-city";
+
+// ========================================================================= //
 
+GameState::GameState(void) :
+m_map(SDefaultMap),
+m_mapResources()
+{
+    this->setID(EngineStateID::Game);
 }
 
 // ========================================================================= //
@@ -54,6 +63,10 @@ GameState::~GameState(void)
 
 void GameState::enter(void)
 {
+    // The map's manifest and resource group are named after the map.
+    m_mapResources.reset(new ResourceManifest(
+        std::string(ResourceManifest::MapPrefix) + m_map));
+    m_mapResources->load();
     this->createScene();
     
     // Network game setup.
@@ -72,7 +85,7 @@ void GameState::enter(void)
 void GameState::exit(void)
 {
     m_world->destroy();
-    
+    m_mapResources->unload();
 }
 
 // ========================================================================= //
@@ -143,24 +156,8 @@ void GameState::update(void)
                 break;
 
             case SDL_MOUSEMOTION:
-                {
-                    MouseMove mm = m_world->getInput()->handleMouse(e);
-                    ComponentMessage msg(ComponentMessage::Type::Look);
-                    msg.data = mm;
-                    m_world->getPlayer()->message(msg);
-                    m_world->getNetwork()->sendMouseMove(mm.relx, mm.rely);
-                }
-                break;
-
-            case SDL_CONTROLLERAXISMOTION:                
-                {
-                    ControllerAxisMotion m = m_world->getInput()->handleControllerAxisMotion(e);
-                    //printf("AxisMotion:\n %d, %d\n%d, %d\n", m.x1, m.y1, m.x2, m.y2);
-
-                    ComponentMessage msg(ComponentMessage::Type::Move);
-                    msg.data = m;
-                    m_world->getPlayer()->message(msg);
-                }
+            case SDL_CONTROLLERAXISMOTION:
+                m_world->handleInput(e);
                 break;
 
             case SDL_CONTROLLERDEVICEADDED:
@@ -177,6 +174,23 @@ void GameState::update(void)
             }
         }
 
+        // Compile this tick's input. Look and sticks apply before the world
+        // steps, commands after, as they did when handled per event.
+        const InputFrame& input = m_world->getInput()->sample();
+        EntityPtr player = m_world->getPlayer();
+        if (input.look.relx != 0 || input.look.rely != 0){
+            ComponentMessage msg(ComponentMessage::Type::Look);
+            msg.data = input.look;
+            player->message(msg);
+            m_world->getNetwork()->sendMouseMove(input.look.relx,
+                                                 input.look.rely);
+        }
+        if (input.axesMoved){
+            ComponentMessage msg(ComponentMessage::Type::Move);
+            msg.data = input.axes;
+            player->message(msg);
+        }
+
         // Step through all World components.
         m_world->update();
         // Process network updates.
@@ -187,11 +201,15 @@ void GameState::update(void)
         }
 
         // Process local player input.
-        m_world->getInput()->update();
-        while (m_world->getInput()->hasPendingCommand()){
-            CommandPtr command = m_world->getInput()->getNextCommand();
-            m_world->getNetwork()->sendCommand(command);
-            command->execute(m_world->getPlayer());
+        for (uint32_t i = 1; i < InputFrame::CommandCount; ++i){
+            const CommandType type = static_cast<CommandType>(i);
+            if (input.isActive(type)){
+                m_world->getNetwork()->sendCommand(type);
+
+                ComponentMessage msg(ComponentMessage::Type::Command);
+                msg.data = type;
+                player->message(msg);
+            }
         }
         m_world->getPlayer()->getComponent<ActorComponent>()->update();
         m_world->getPlayer()->getComponent<WeaponComponent>()->update();
@@ -204,6 +222,24 @@ void GameState::update(void)
 
 // ========================================================================= //
 
+void GameState::preRender(void)
+{
+    EntityPtr player = m_world->getPlayer();
+    if (m_active == false || player == nullptr){
+        return;
+    }
+
+    // The offset only turns the camera; the actor's look, which gameplay and
+    // the server use, still changes when update() handles the events. Once
+    // it has, the pending motion is zero and the offset is identity again.
+    const MouseMove mm = m_world->getInput()->peekMouseMotion();
+    m_world->getMainCamera()->getCamera()->setOrientation(
+        player->getComponent<ActorComponent>()->getLookOffset(mm.relx,
+                                                              mm.rely));
+}
+
+// ========================================================================= //
+
 void GameState::createScene(void)
 {
     m_world->init(true);
@@ -236,11 +272,20 @@ void GameState::createScene(void)
 
     m_world->getEnvironment()->loadEffects();
 
-    // Tower city
-    EntityPtr tower = m_world->createEntity();
-    m_world->attachComponent<SceneComponent>(tower)->setPosition(Ogre::Vector3(1500.f, -150.f, 17000.f));
-    tower->getComponent<SceneComponent>()->getSceneNode()->scale(1000.f, 1000.f, 1000.f);
-    m_world->attachComponent<MultiModelComponent>(tower)->setMesh("tower-city.scene");
+    // The map (tower city by default), streamed in cells around the player.
+    // The skyline is drawn from spawn, 17 km away; collision only exists 
+    // near the player.
+    std::shared_ptr<WorldStreamer> streamer = m_world->getWorldStreamer();
+    streamer->addScene(m_map + ".scene",
+                       Ogre::Vector3(1500.f, -150.f, 17000.f),
+                       Ogre::Quaternion::IDENTITY,
+                       Ogre::Vector3(1000.f, 1000.f, 1000.f),
+                       1000.f,
+                       true,
+                       m_mapResources->getName());
+    streamer->addSource([player](void){
+        return player->getComponent<ActorComponent>()->getPosition();
+    }, 4000.f, 25000.f);
 
     // Chopper
     EntityPtr chopper = m_world->createEntity();
@@ -291,7 +336,8 @@ void GameState::createScene(void)
     //m_world->getEnvironment()->setSunColour(2.f, 1.75f, 1.89f);
     //m_world->getEnvironment()->setMoonColour(.50f, .50f, 5.f);
 
-    // Create Ocean.
+    // Create Ocean. Wave queries use the same surface at every detail level.
+    m_world->getEnvironment()->loadOceanWaves("HydraxDemo.hdx");
 #ifdef _DEBUG
     m_world->getEnvironment()->loadOcean("Ocean2_HLSL_GLSL");
 #else
@@ -307,6 +353,9 @@ void GameState::createScene(void)
 
     // Add music.
     //m_world->playMusic("Data/Audio/Music/flying.ogg");
+
+    // Decode this state's sounds now so playing them never waits on disk.
+    m_world->getAudioManager()->getSoundBank()->preload();
 }
 
 // ========================================================================= //
@@ -52,6 +52,16 @@ public:
     // Processes player/UI interaction.
     virtual void update(void) override;
 
+    // Setters:
+
+    // Sets the map loaded on the next enter(): the scene <map>.scene from 
+    // the resource group Map.<map>.
+    void setMap(const std::string& map);
+
+    // Late-latches mouse look: turns the camera by mouse motion the next
+    // update has not consumed yet, so the view does not wait for a tick.
+    virtual void preRender(void) override;
+
     // Constructs the virtual world.
     void createScene(void);
 
@@ -63,10 +73,25 @@ public:
 
     // Creates new Entities for players in Network.
     void addNetworkPlayers(void);
+
+private:
+    // Name of the map to load.
+    std::string m_map;
+
+    // Resources used by the loaded map.
+    std::shared_ptr<ResourceManifest> m_mapResources;
 };
 
 // ========================================================================= //
 
+// Setters:
+
+inline void GameState::setMap(const std::string& map){
+    m_map = map;
+}
+
+// ========================================================================= //
+
 #endif
 
 // ========================================================================= //
\ No newline at end of file
@@ -212,12 +212,7 @@ void LobbyState::handleNetEvents(void)
             break;
 
         case NetMessage::Chat:
-            {
-                CEGUI::Window* chat = m_ui->getWindow(
-                    LobbyUI::Layer::Root, "Chat");
-
-                chat->appendText(boost::get<std::string>(e.data));
-            }
+            m_ui->appendText("Chat", boost::get<std::string>(e.data));
             break;
 
         case NetMessage::PlayerList:
@@ -70,7 +70,8 @@ void MainMenuState::enter(void)
 
     m_world->setMainCamera(camera->getComponent<CameraComponent>());
 
-    // Create Ocean.
+    // Create Ocean. Wave queries use the same surface at every detail level.
+    m_world->getEnvironment()->loadOceanWaves("HydraxDemo.hdx");
 #ifdef _DEBUG
     m_world->getEnvironment()->loadOcean("Ocean2_HLSL_GLSL");
 #else
@@ -0,0 +1,336 @@
+// ========================================================================= //
+// Talos - A 3D game engine with network multiplayer.
+// Copyright(C) 2015 Jordan Sparks <unixunited@live.com>
+//
+// This program is free software; you can redistribute it and / or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 3
+// of the License, or(at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+// ========================================================================= //
+// File: ResourceManifest.cpp
+// Author: Jordan Sparks <unixunited@live.com>
+// ========================================================================= //
+// Implements ResourceManifest class.
+// ========================================================================= //
+
+#include "ResourceManifest.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+#ifdef _MSC_VER
+#include <direct.h>
+#else
+#include <sys/stat.h>
+#endif
+
+// ========================================================================= //
+
+const char* ResourceManifest::StatePrefix = "State.";
+const char* ResourceManifest::MapPrefix = "Map.";
+
+// Directory manifests are written to, relative to the working directory.
+static const std::string SManifestDir = "Manifests";
+
+// Manifests in load order; the last one records.
+static std::vector<ResourceManifest*> SActive;
+
+// Number of outstanding suspendRecording() calls.
+static int SSuspended = 0;
+
+// ========================================================================= //
+// Ogre allows a single loading listener, so one instance forwards loads to 
+// the recording manifest.
+class ManifestLoadingListener : public Ogre::ResourceLoadingListener
+{
+public:
+    virtual Ogre::DataStreamPtr resourceLoading(const Ogre::String& name,
+                                                const Ogre::String& group,
+                                                Ogre::Resource* resource){
+        // Let Ogre open the stream as usual.
+        return Ogre::DataStreamPtr();
+    }
+
+    virtual void resourceStreamOpened(const Ogre::String& name,
+                                      const Ogre::String& group,
+                                      Ogre::Resource* resource,
+                                      Ogre::DataStreamPtr& stream){
+        if (resource != nullptr && SActive.empty() == false && 
+            SSuspended == 0){
+            SActive.back()->record(resource);
+        }
+    }
+
+    virtual bool resourceCollision(Ogre::Resource* resource,
+                                   Ogre::ResourceManager* resourceManager){
+        // Ogre only throws for duplicates when no listener is installed;
+        // returning false would silently leave the new resource out of the
+        // manager. Throw as Ogre would without one.
+        OGRE_EXCEPT(Ogre::Exception::ERR_DUPLICATE_ITEM,
+                    "Resource with the name " + resource->getName() +
+                    " already exists.",
+                    "ResourceManager::add");
+    }
+};
+
+static ManifestLoadingListener SListener;
+
+// ========================================================================= //
+
+// Types unloaded first release their references to types unloaded later.
+static const char* SUnloadOrder[] = { "Mesh", "Skeleton", "Texture" };
+
+// ========================================================================= //
+
+ResourceManifest::ResourceManifest(const std::string& name) :
+m_name(name),
+m_entries(),
+m_recorded(),
+m_recordedKeys(),
+m_loaded(false)
+{
+
+}
+
+// ========================================================================= //
+
+ResourceManifest::~ResourceManifest(void)
+{
+    std::vector<ResourceManifest*>::iterator itr = 
+        std::find(SActive.begin(), SActive.end(), this);
+    if (itr != SActive.end()){
+        SActive.erase(itr);
+    }
+}
+
+// ========================================================================= //
+
+void ResourceManifest::load(void)
+{
+    Assert(m_loaded == false, "ResourceManifest loaded twice");
+
+    Ogre::ResourceGroupManager& rgm = 
+        Ogre::ResourceGroupManager::getSingleton();
+
+    if (rgm.resourceGroupExists(m_name) && 
+        rgm.isResourceGroupInitialised(m_name) == false){
+        rgm.initialiseResourceGroup(m_name);
+    }
+
+    // Record from here on, so the loads below are attributed to this 
+    // manifest rather than an enclosing one.
+    rgm.setLoadingListener(&SListener);
+    SActive.push_back(this);
+    m_recorded.clear();
+    m_recordedKeys.clear();
+    m_loaded = true;
+
+    if (this->read() == false){
+        Talos::Log::getSingleton().log("No resource manifest for " + m_name +
+                                       ", recording one");
+        return;
+    }
+
+    const Ogre::Real start = static_cast<Ogre::Real>(
+        Ogre::Root::getSingleton().getTimer()->getMilliseconds());
+    uint32_t count = 0;
+    for (std::vector<Entry>::const_iterator itr = m_entries.begin();
+         itr != m_entries.end();
+         ++itr){
+        // Skip content that has since been removed or isn't reachable yet.
+        if (rgm.resourceGroupExists(itr->group) == false ||
+            rgm.resourceExists(itr->group, itr->name) == false){
+            continue;
+        }
+
+        try{
+            Ogre::ResourcePtr resource;
+            if (itr->type == "Texture"){
+                resource = Ogre::TextureManager::getSingleton().load(
+                    itr->name, itr->group, 
+                    static_cast<Ogre::TextureType>(itr->textureType));
+            }
+            else{
+                resource = rgm._getResourceManager(itr->type)->
+                    createOrRetrieve(itr->name, itr->group).first;
+                resource->load();
+            }
+
+            // Already loaded elsewhere doesn't fire a load, but still 
+            // belongs to this content.
+            this->record(resource.get());
+            ++count;
+        }
+        catch (Ogre::Exception& e){
+            Talos::Log::getSingleton().log("Failed to preload " + itr->name +
+                                           ": " + e.getDescription());
+        }
+    }
+
+    Talos::Log::getSingleton().log("Preloaded " + toString(count) + "/" +
+        toString(m_entries.size()) + " resources for " + m_name + " in " +
+        toString(Ogre::Root::getSingleton().getTimer()->getMilliseconds() -
+                 start) + " ms");
+}
+
+// ========================================================================= //
+
+void ResourceManifest::unload(void)
+{
+    if (m_loaded == false){
+        return;
+    }
+    m_loaded = false;
+
+    std::vector<ResourceManifest*>::iterator active = 
+        std::find(SActive.begin(), SActive.end(), this);
+    if (active != SActive.end()){
+        SActive.erase(active);
+    }
+
+    this->write();
+
+    Ogre::ResourceGroupManager& rgm = 
+        Ogre::ResourceGroupManager::getSingleton();
+
+    // Materials hold their textures, so drop any nothing uses first.
+    Ogre::MaterialManager::getSingleton().unloadUnreferencedResources();
+
+    // Only unload what no entity, material or paused state still holds. The
+    // resource system keeps its own references, plus the one taken here.
+    const unsigned int unreferenced = 
+        Ogre::ResourceGroupManager::RESOURCE_SYSTEM_NUM_REFERENCE_COUNTS + 1;
+    uint32_t count = 0;
+    for (size_t i = 0; i < sizeof(SUnloadOrder) / sizeof(SUnloadOrder[0]); 
+         ++i){
+        for (std::vector<Entry>::const_iterator itr = m_recorded.begin();
+             itr != m_recorded.end();
+             ++itr){
+            if (itr->type != SUnloadOrder[i]){
+                continue;
+            }
+
+            Ogre::ResourcePtr resource = rgm._getResourceManager(
+                itr->type)->getResourceByName(itr->name, itr->group);
+            if (resource.isNull() == false && resource->isLoaded() &&
+                resource.useCount() <= unreferenced){
+                resource->unload();
+                ++count;
+            }
+        }
+    }
+
+    if (rgm.resourceGroupExists(m_name)){
+        rgm.unloadResourceGroup(m_name);
+    }
+
+    Talos::Log::getSingleton().log("Unloaded " + toString(count) + 
+                                   " resources for " + m_name);
+}
+
+// ========================================================================= //
+
+void ResourceManifest::suspendRecording(void)
+{
+    ++SSuspended;
+}
+
+// ========================================================================= //
+
+void ResourceManifest::resumeRecording(void)
+{
+    Assert(SSuspended > 0, "Unbalanced ResourceManifest::resumeRecording");
+    --SSuspended;
+}
+
+// ========================================================================= //
+
+void ResourceManifest::record(Ogre::Resource* resource)
+{
+    // Manual resources have no file to preload from.
+    if (resource->isManuallyLoaded() == true){
+        return;
+    }
+
+    Entry entry;
+    entry.type = resource->getCreator()->getResourceType();
+    entry.group = resource->getGroup();
+    entry.name = resource->getName();
+    entry.textureType = 0;
+    if (!m_recordedKeys.insert(std::make_pair(entry.type, entry.name)).second){
+        return;
+    }
+
+    Ogre::Texture* texture = dynamic_cast<Ogre::Texture*>(resource);
+    if (texture != nullptr){
+        entry.textureType = static_cast<int>(texture->getTextureType());
+    }
+
+    m_recorded.push_back(entry);
+}
+
+// ========================================================================= //
+
+const bool ResourceManifest::read(void)
+{
+    std::ifstream file(SManifestDir + "/" + m_name + ".manifest");
+    if (file.is_open() == false){
+        return false;
+    }
+
+    // One tab-separated line per resource: type, group, name, texture type.
+    m_entries.clear();
+    std::string line;
+    while (std::getline(file, line)){
+        std::istringstream fields(line);
+        Entry entry;
+        std::string textureType;
+        if (std::getline(fields, entry.type, '\t') &&
+            std::getline(fields, entry.group, '\t') &&
+            std::getline(fields, entry.name, '\t') &&
+            std::getline(fields, textureType)){
+            entry.textureType = std::atoi(textureType.c_str());
+            m_entries.push_back(entry);
+        }
+    }
+
+    return true;
+}
+
+// ========================================================================= //
+
+void ResourceManifest::write(void) const
+{
+#ifdef _MSC_VER
+    _mkdir(SManifestDir.c_str());
+#else
+    mkdir(SManifestDir.c_str(), 0755);
+#endif
+
+    std::ofstream file(SManifestDir + "/" + m_name + ".manifest",
+                       std::ios::out | std::ios::trunc);
+    if (file.is_open() == false){
+        Talos::Log::getSingleton().log("Failed to write resource manifest " +
+                                       m_name);
+        return;
+    }
+
+    for (std::vector<Entry>::const_iterator itr = m_recorded.begin();
+         itr != m_recorded.end();
+         ++itr){
+        file << itr->type << '\t' << itr->group << '\t' << itr->name << '\t' 
+             << itr->textureType << '\n';
+    }
+}
+
+// ========================================================================= //
\ No newline at end of file
@@ -0,0 +1,121 @@
+// ========================================================================= //
+// Talos - A 3D game engine with network multiplayer.
+// Copyright(C) 2015 Jordan Sparks <unixunited@live.com>
+//
+// This program is free software; you can redistribute it and / or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 3
+// of the License, or(at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+// ========================================================================= //
+// File: ResourceManifest.hpp
+// Author: Jordan Sparks <unixunited@live.com>
+// ========================================================================= //
+// Defines ResourceManifest class.
+// ========================================================================= //
+
+#ifndef __RESOURCEMANIFEST_HPP__
+#define __RESOURCEMANIFEST_HPP__
+
+// ========================================================================= //
+
+#include "stdafx.hpp"
+
+#include <set>
+
+// ========================================================================= //
+// Records which file-backed resources (meshes, textures, skeletons, ...) are
+// loaded while a piece of content is active -- an engine state or a map --
+// and writes them to Manifests/<name>.manifest. Next run, load() preloads 
+// exactly what was touched and unload() releases it again, so memory follows 
+// the active content. A resource group of the same name (e.g. [State.Game] 
+// in resources.cfg) is initialised on load() instead of at startup.
+//
+// Manifests nest: only the most recently loaded one records.
+class ResourceManifest
+{
+public:
+    // One recorded resource.
+    struct Entry{
+        std::string type;
+        std::string group;
+        std::string name;
+        // Texture type, or 0 for other resources.
+        int textureType;
+    };
+
+    // Prefixes of resource groups initialised by their manifest rather than
+    // at startup.
+    static const char* StatePrefix;
+    static const char* MapPrefix;
+
+    // Reads nothing yet; name selects the manifest file and resource group.
+    explicit ResourceManifest(const std::string& name);
+
+    // Stops recording if still active.
+    ~ResourceManifest(void);
+
+    // Initialises the content's resource group, preloads the manifest's 
+    // resources and starts recording.
+    void load(void);
+
+    // Stops recording, writes the manifest and unloads resources loaded 
+    // since load() that nothing references any more.
+    void unload(void);
+
+    // Excludes loads from recording until resumeRecording(), e.g. for 
+    // content that manages its own residency.
+    static void suspendRecording(void);
+
+    // Ends a suspendRecording().
+    static void resumeRecording(void);
+
+    // Records a resource loaded while this manifest is active.
+    void record(Ogre::Resource* resource);
+
+    // Getters:
+
+    // Returns manifest name.
+    const std::string& getName(void) const;
+
+    // Returns true between load() and unload().
+    const bool isLoaded(void) const;
+
+private:
+    // Reads the manifest file into m_entries, returns false if missing.
+    const bool read(void);
+
+    // Writes m_recorded to the manifest file.
+    void write(void) const;
+
+    std::string m_name;
+    std::vector<Entry> m_entries;
+    std::vector<Entry> m_recorded;
+    std::set<std::pair<std::string, std::string>> m_recordedKeys;
+    bool m_loaded;
+};
+
+// ========================================================================= //
+
+// Getters:
+
+inline const std::string& ResourceManifest::getName(void) const{
+    return m_name;
+}
+
+inline const bool ResourceManifest::isLoaded(void) const{
+    return m_loaded;
+}
+
+// ========================================================================= //
+
+#endif
+
+// ========================================================================= //
\ No newline at end of file
@@ -23,6 +23,7 @@
 
 #include "stdafx.hpp"
 #include "Resources.hpp"
+#include "ResourceManifest.hpp"
 
 // ========================================================================= //
 
@@ -53,8 +54,26 @@ void loadOgreResources(void)
         }
     }
 
-    // Now initialize the parsed resource groups.
-    Ogre::ResourceGroupManager::getSingleton().initialiseAllResourceGroups();
+    // Now initialize the parsed resource groups, except those belonging to a 
+    // state or map, which their ResourceManifest initialises on entry.
+    Ogre::ResourceGroupManager& rgm = 
+        Ogre::ResourceGroupManager::getSingleton();
+    const Ogre::StringVector groups = rgm.getResourceGroups();
+    for (Ogre::StringVector::const_iterator itr = groups.begin();
+         itr != groups.end();
+         ++itr){
+        if (Ogre::StringUtil::startsWith(*itr, 
+                                         ResourceManifest::StatePrefix, 
+                                         false) ||
+            Ogre::StringUtil::startsWith(*itr, 
+                                         ResourceManifest::MapPrefix, 
+                                         false)){
+            continue;
+        }
+        if (rgm.isResourceGroupInitialised(*itr) == false){
+            rgm.initialiseResourceGroup(*itr);
+        }
+    }
 
     // Also set the default texture settings here.
     Ogre::TextureManager::getSingleton().setDefaultNumMipmaps(5);
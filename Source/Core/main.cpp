@@ -22,6 +22,8 @@
 // ========================================================================= //
 
 #include "Engine.hpp"
+#include "Loader/PackBuilder.hpp"
+#include "Loader/SceneCompiler.hpp"
 
 #ifdef WIN32
 #define WIN32_LEAN_AND_MEAN
@@ -46,6 +48,55 @@ int main(int argc, char** argv)
     SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), FOREGROUND_GREEN);
 #endif
 
+    // Offline tool: "-compilescene <in.scene> <out.bscene>" converts a
+    // dotScene file to the binary scene format without starting the engine.
+#ifdef WIN32
+    const int argCount = __argc;
+    char** argValues = __argv;
+#else
+    const int argCount = argc;
+    char** argValues = argv;
+#endif
+    if (argCount == 4 && std::string(argValues[1]) == "-compilescene"){
+        SceneCompiler compiler;
+        if (compiler.compile(argValues[2], argValues[3]) == false){
+            printf("%s\n", compiler.getError().c_str());
+            return 1;
+        }
+
+        printf("Compiled %s: %u nodes, %u entities, %u lights, "
+               "%u elements skipped\n",
+               argValues[3],
+               static_cast<unsigned int>(compiler.getNodeCount()),
+               static_cast<unsigned int>(compiler.getEntityCount()),
+               static_cast<unsigned int>(compiler.getLightCount()),
+               compiler.getSkipped());
+        return 0;
+    }
+
+    // Offline tool: "-packarchive <dir> <out.pak>" packs the files of a 
+    // resource directory into an archive usable as "Pack=<out.pak>" in 
+    // resources.cfg. Subdirectories need archives of their own.
+    if (argCount == 4 && std::string(argValues[1]) == "-packarchive"){
+        PackBuilder builder;
+        if (builder.build(argValues[2], argValues[3]) == false){
+            printf("%s\n", builder.getError().c_str());
+            return 1;
+        }
+
+        printf("Packed %s: %u files (%u compressed), %llu -> %llu bytes\n",
+               argValues[3],
+               static_cast<unsigned int>(builder.getEntryCount()),
+               static_cast<unsigned int>(builder.getCompressedCount()),
+               static_cast<unsigned long long>(builder.getSize()),
+               static_cast<unsigned long long>(builder.getPackedSize()));
+        for (size_t i = 0; i < builder.getSkippedDirs().size(); ++i){
+            printf("Skipped subdirectory %s, pack it separately\n",
+                   builder.getSkippedDirs()[i].c_str());
+        }
+        return 0;
+    }
+
     Engine engine;
 
     try{
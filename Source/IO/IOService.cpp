@@ -0,0 +1,423 @@
+// ========================================================================= //
+// Talos - A 3D game engine with network multiplayer.
+// Copyright(C) 2015 Jordan Sparks <unixunited@live.com>
+//
+// This program is free software; you can redistribute it and / or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 3
+// of the License, or(at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+// ========================================================================= //
+// File: IOService.cpp
+// Author: Jordan Sparks <unixunited@live.com>
+// ========================================================================= //
+// Implements IOService class.
+// ========================================================================= //
+
+#include "IOService.hpp"
+
+#include <algorithm>
+#include <fstream>
+
+// ========================================================================= //
+
+template<> Talos::IOService* Ogre::Singleton<Talos::IOService>::msSingleton =
+    nullptr;
+
+// ========================================================================= //
+
+namespace Talos
+{;
+
+// ========================================================================= //
+
+// Returns one past the last byte of a range, or WholeFile if it runs to the
+// end of the file.
+static uint64_t rangeEnd(const uint64_t offset, const uint64_t size)
+{
+    return (size == IOService::WholeFile) ? IOService::WholeFile :
+        offset + size;
+}
+
+// ========================================================================= //
+
+IOService::IOService(const uint32_t threads) :
+m_callbacks(),
+m_delivering(),
+m_nextID(InvalidRequest),
+m_threads(),
+m_mutex(),
+m_condition(),
+m_finished(),
+m_completions(),
+m_pending(0),
+m_coalesced(0),
+m_running(true),
+m_requestCount(nullptr),
+m_readCount(nullptr),
+m_bytesRead(nullptr),
+m_latency(nullptr)
+{
+    Metrics& metrics = Metrics::getSingleton();
+    m_requestCount = metrics.getCounter(
+        "talos_io_requests_total", "File reads requested.");
+    m_readCount = metrics.getCounter(
+        "talos_io_reads_total", "File reads performed after coalescing.");
+    m_bytesRead = metrics.getCounter(
+        "talos_io_read_bytes_total", "Bytes read by I/O threads.");
+    m_latency = metrics.getHistogram(
+        "talos_io_latency_ms", "Time from a read request to its data.");
+
+    for (uint32_t i = 0; i < std::max<uint32_t>(threads, 1); ++i){
+        m_threads.push_back(std::thread(&IOService::run, this));
+    }
+}
+
+// ========================================================================= //
+
+IOService::~IOService(void)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_running = false;
+    }
+    m_condition.notify_all();
+
+    for (auto& thread : m_threads){
+        thread.join();
+    }
+}
+
+// ========================================================================= //
+
+IOService::RequestID IOService::read(const std::string& file,
+                                     const Callback& callback,
+                                     const Priority priority,
+                                     const uint64_t offset,
+                                     const uint64_t size)
+{
+    Assert(priority < Priority::Count, "Invalid I/O priority");
+
+    if (++m_nextID == InvalidRequest){
+        ++m_nextID;
+    }
+
+    Request request;
+    request.id = m_nextID;
+    request.file = file;
+    request.offset = offset;
+    request.size = size;
+    request.queued = std::chrono::steady_clock::now();
+
+    m_callbacks[request.id] = callback;
+    m_requestCount->add();
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_queues[static_cast<size_t>(priority)].push_back(request);
+        ++m_pending;
+    }
+    m_condition.notify_one();
+
+    return request.id;
+}
+
+// ========================================================================= //
+
+bool IOService::cancel(const RequestID id)
+{
+    std::unordered_map<RequestID, Callback>::iterator itr =
+        m_callbacks.find(id);
+    if (itr == m_callbacks.end()){
+        return false;
+    }
+    m_callbacks.erase(itr);
+
+    // Not read yet, so it doesn't need to be. A request already being read
+    // completes and is dropped by deliver().
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto& queue : m_queues){
+        for (std::deque<Request>::iterator request = queue.begin();
+             request != queue.end();
+             ++request){
+            if (request->id == id){
+                queue.erase(request);
+                --m_pending;
+                return true;
+            }
+        }
+    }
+
+    return true;
+}
+
+// ========================================================================= //
+
+void IOService::update(void)
+{
+    Assert(m_delivering.empty(), "IOService::update() called from a callback");
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_delivering.swap(m_completions);
+    }
+
+    // Callbacks may queue or wait on more requests; index since wait() can
+    // remove entries.
+    for (size_t i = 0; i < m_delivering.size(); ++i){
+        const Completion completion = m_delivering[i];
+        this->deliver(completion);
+    }
+    m_delivering.clear();
+}
+
+// ========================================================================= //
+
+bool IOService::wait(const RequestID id)
+{
+    if (m_callbacks.find(id) == m_callbacks.end()){
+        return false;
+    }
+
+    // Already finished but not delivered, when waited on from a callback.
+    for (std::vector<Completion>::iterator itr = m_delivering.begin();
+         itr != m_delivering.end();
+         ++itr){
+        if (itr->id == id){
+            const Completion completion = *itr;
+            m_delivering.erase(itr);
+            this->deliver(completion);
+            return true;
+        }
+    }
+
+    Completion completion;
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        // Move it ahead of everything else still queued.
+        const size_t urgent = static_cast<size_t>(Priority::Urgent);
+        for (size_t i = 0; i < urgent; ++i){
+            std::deque<Request>::iterator request = std::find_if(
+                m_queues[i].begin(), m_queues[i].end(),
+                [id](const Request& r){ return r.id == id; });
+            if (request != m_queues[i].end()){
+                m_queues[urgent].push_front(*request);
+                m_queues[i].erase(request);
+                break;
+            }
+        }
+
+        std::vector<Completion>::iterator itr;
+        m_finished.wait(lock, [this, id, &itr](){
+            itr = std::find_if(m_completions.begin(), m_completions.end(),
+                               [id](const Completion& c){
+                return c.id == id;
+            });
+            return itr != m_completions.end();
+        });
+
+        completion = *itr;
+        m_completions.erase(itr);
+    }
+
+    this->deliver(completion);
+
+    return true;
+}
+
+// ========================================================================= //
+
+void IOService::deliver(const Completion& completion)
+{
+    std::unordered_map<RequestID, Callback>::iterator itr =
+        m_callbacks.find(completion.id);
+    if (itr == m_callbacks.end()){
+        return;
+    }
+
+    // Erase before calling, the callback may queue requests of its own.
+    const Callback callback = itr->second;
+    m_callbacks.erase(itr);
+
+    Result result;
+    result.id = completion.id;
+    result.ok = completion.ok;
+    result.data = (completion.ok) ?
+        completion.buffer->data() + completion.begin : nullptr;
+    result.size = (completion.ok) ? completion.size : 0;
+    result.buffer = completion.buffer;
+
+    callback(result);
+}
+
+// ========================================================================= //
+
+void IOService::takeBatch(std::vector<Request>& batch)
+{
+    batch.clear();
+
+    for (size_t i = static_cast<size_t>(Priority::Count); i-- > 0;){
+        if (m_queues[i].empty() == false){
+            batch.push_back(m_queues[i].front());
+            m_queues[i].pop_front();
+            break;
+        }
+    }
+    if (batch.empty()){
+        return;
+    }
+
+    const std::string& file = batch.front().file;
+    uint64_t begin = batch.front().offset;
+    uint64_t end = rangeEnd(begin, batch.front().size);
+
+    // Grow the span until no queued request lies close enough to it.
+    bool grew = true;
+    while (grew){
+        grew = false;
+        for (auto& queue : m_queues){
+            std::deque<Request>::iterator itr = queue.begin();
+            while (itr != queue.end()){
+                const uint64_t reqEnd = rangeEnd(itr->offset, itr->size);
+                const uint64_t newBegin = std::min(begin, itr->offset);
+                const uint64_t newEnd = std::max(end, reqEnd);
+
+                bool join = false;
+                if (itr->file == file){
+                    const bool nearEnd = (end == WholeFile ||
+                                          itr->offset <= end + CoalesceGap);
+                    const bool nearBegin = (reqEnd == WholeFile ||
+                                            reqEnd + CoalesceGap >= begin);
+                    // A bounded span doesn't grow to the end of the file.
+                    const bool bounded = (end == WholeFile ||
+                                          (newEnd != WholeFile &&
+                                           newEnd - newBegin <=
+                                           MaxCoalescedSize));
+
+                    join = (nearEnd && nearBegin && bounded);
+                }
+
+                if (join){
+                    grew = grew || newBegin != begin || newEnd != end;
+                    begin = newBegin;
+                    end = newEnd;
+                    batch.push_back(*itr);
+                    itr = queue.erase(itr);
+                }
+                else{
+                    ++itr;
+                }
+            }
+        }
+    }
+}
+
+// ========================================================================= //
+
+void IOService::serve(const std::vector<Request>& batch,
+                      std::vector<Completion>& completions)
+{
+    uint64_t begin = WholeFile;
+    uint64_t end = 0;
+    for (auto& request : batch){
+        begin = std::min(begin, request.offset);
+        end = std::max(end, rangeEnd(request.offset, request.size));
+    }
+
+    std::shared_ptr<std::vector<char>> buffer(new std::vector<char>());
+    uint64_t length = 0;
+    bool ok = false;
+
+    std::ifstream file(batch.front().file.c_str(), std::ios::binary);
+    if (file.is_open()){
+        file.seekg(0, std::ios::end);
+        length = static_cast<uint64_t>(file.tellg());
+        ok = true;
+
+        const uint64_t readEnd = std::min(end, length);
+        if (begin < readEnd){
+            buffer->resize(static_cast<size_t>(readEnd - begin));
+            file.seekg(static_cast<std::streamoff>(begin), std::ios::beg);
+            file.read(buffer->data(), buffer->size());
+            ok = (file.fail() == false);
+        }
+    }
+
+    m_readCount->add();
+    m_bytesRead->add(buffer->size());
+
+    const std::chrono::steady_clock::time_point now =
+        std::chrono::steady_clock::now();
+    for (auto& request : batch){
+        const uint64_t reqEnd = (request.size == WholeFile) ? length :
+            request.offset + request.size;
+
+        Completion completion;
+        completion.id = request.id;
+        // Ranges past the end of the file fail rather than come back short.
+        completion.ok = (ok && request.offset <= reqEnd && reqEnd <= length);
+        completion.buffer = (completion.ok) ? buffer : nullptr;
+        completion.begin = (completion.ok) ?
+            static_cast<size_t>(request.offset - begin) : 0;
+        completion.size = (completion.ok) ?
+            static_cast<size_t>(reqEnd - request.offset) : 0;
+        completions.push_back(completion);
+
+        m_latency->observe(std::chrono::duration<double, std::milli>(
+            now - request.queued).count());
+    }
+}
+
+// ========================================================================= //
+
+void IOService::run(void)
+{
+    std::vector<Request> batch;
+    std::vector<Completion> completions;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true){
+        m_condition.wait(lock, [this](){
+            if (m_running == false){
+                return true;
+            }
+            for (auto& queue : m_queues){
+                if (queue.empty() == false){
+                    return true;
+                }
+            }
+            return false;
+        });
+        if (m_running == false){
+            break;
+        }
+
+        this->takeBatch(batch);
+        lock.unlock();
+
+        this->serve(batch, completions);
+
+        lock.lock();
+        m_completions.insert(m_completions.end(),
+                             completions.begin(),
+                             completions.end());
+        m_pending -= static_cast<uint32_t>(batch.size());
+        m_coalesced += batch.size() - 1;
+        completions.clear();
+        m_finished.notify_all();
+    }
+}
+
+// ========================================================================= //
+
+}
+
+// ========================================================================= //
\ No newline at end of file
@@ -0,0 +1,203 @@
+// ========================================================================= //
+// Talos - A 3D game engine with network multiplayer.
+// Copyright(C) 2015 Jordan Sparks <unixunited@live.com>
+//
+// This program is free software; you can redistribute it and / or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 3
+// of the License, or(at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+// ========================================================================= //
+// File: IOService.hpp
+// Author: Jordan Sparks <unixunited@live.com>
+// ========================================================================= //
+// Defines IOService class.
+// ========================================================================= //
+
+#ifndef __IOSERVICE_HPP__
+#define __IOSERVICE_HPP__
+
+// ========================================================================= //
+
+#include "stdafx.hpp"
+
+#include "Metrics/Metrics.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+
+// ========================================================================= //
+
+namespace Talos
+{;
+
+// ========================================================================= //
+// Reads files on a pool of I/O threads so disk access overlaps the
+// simulation. Requests are served highest priority first, oldest first
+// within a priority. Queued requests for nearby ranges of the same file are
+// coalesced into a single read. Completion callbacks run on the main
+// thread, from update() (called once per frame by the Engine) or wait().
+// read(), cancel(), update() and wait() are for the main thread only.
+class IOService : public Ogre::Singleton<IOService>
+{
+public:
+    typedef uint32_t RequestID;
+
+    static const RequestID InvalidRequest = 0;
+
+    // Passed as size to read a file from offset to its end.
+    static const uint64_t WholeFile = 0xFFFFFFFFFFFFFFFFULL;
+
+    // Ranges of one file at most this far apart are read together.
+    static const uint64_t CoalesceGap = 64 * 1024;
+
+    // Coalesced reads stop growing at this many bytes.
+    static const uint64_t MaxCoalescedSize = 4 * 1024 * 1024;
+
+    enum class Priority{
+        // Prefetching that nothing waits on yet.
+        Low = 0,
+        Normal,
+        // Data needed within a few ticks.
+        High,
+        // Something is blocked on it (see wait()).
+        Urgent,
+
+        Count
+    };
+
+    // A finished read. data points into buffer, which may be shared with
+    // other coalesced requests; keep buffer to use data after the callback.
+    struct Result{
+        RequestID id;
+        bool ok;
+        const char* data;
+        size_t size;
+        std::shared_ptr<const std::vector<char>> buffer;
+    };
+
+    typedef std::function<void(const Result&)> Callback;
+
+    // Starts the I/O threads.
+    explicit IOService(const uint32_t threads = 2);
+
+    // Stops the I/O threads, dropping queued requests without calling
+    // their callbacks.
+    virtual ~IOService(void);
+
+    // Queues a read of size bytes of file from offset and returns its id.
+    // callback receives the data on the main thread.
+    RequestID read(const std::string& file,
+                   const Callback& callback,
+                   const Priority priority = Priority::Normal,
+                   const uint64_t offset = 0,
+                   const uint64_t size = WholeFile);
+
+    // Cancels a request. Its callback is not called. Returns false if it
+    // was already delivered or unknown.
+    bool cancel(const RequestID id);
+
+    // Runs the callbacks of every request finished so far.
+    void update(void);
+
+    // Blocks until a request finishes, promoting it to Urgent if still
+    // queued, and runs its callback. Other finished requests wait for
+    // update(). Returns false if the request is unknown or was cancelled.
+    bool wait(const RequestID id);
+
+    // Getters:
+
+    // Returns number of requests queued or being read.
+    const uint32_t getPendingCount(void) const;
+
+    // Returns number of requests served by another request's read.
+    const uint64_t getCoalescedCount(void) const;
+
+private:
+    struct Request{
+        RequestID id;
+        std::string file;
+        uint64_t offset;
+        uint64_t size;
+        std::chrono::steady_clock::time_point queued;
+    };
+
+    // A read handed back to the main thread.
+    struct Completion{
+        RequestID id;
+        bool ok;
+        std::shared_ptr<std::vector<char>> buffer;
+        size_t begin;
+        size_t size;
+    };
+
+    // Moves the highest priority request and the queued requests it can
+    // be coalesced with into batch. The mutex must be held.
+    void takeBatch(std::vector<Request>& batch);
+
+    // Reads the span covering batch and produces its completions.
+    void serve(const std::vector<Request>& batch,
+               std::vector<Completion>& completions);
+
+    // Runs the callback for a completion, if it was not cancelled.
+    void deliver(const Completion& completion);
+
+    // I/O thread: serves queued requests.
+    void run(void);
+
+    // Main thread only.
+    std::unordered_map<RequestID, Callback> m_callbacks;
+    std::vector<Completion> m_delivering;
+    RequestID m_nextID;
+
+    // Shared with the I/O threads.
+    std::vector<std::thread> m_threads;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::condition_variable m_finished;
+    std::deque<Request> m_queues[static_cast<size_t>(Priority::Count)];
+    std::vector<Completion> m_completions;
+    std::atomic<uint32_t> m_pending;
+    std::atomic<uint64_t> m_coalesced;
+    bool m_running;
+
+    // Metrics.
+    Metrics::Counter* m_requestCount;
+    Metrics::Counter* m_readCount;
+    Metrics::Counter* m_bytesRead;
+    Metrics::Histogram* m_latency;
+};
+
+// ========================================================================= //
+
+// Getters:
+
+inline const uint32_t IOService::getPendingCount(void) const{
+    return m_pending;
+}
+
+inline const uint64_t IOService::getCoalescedCount(void) const{
+    return m_coalesced;
+}
+
+// ========================================================================= //
+
+}
+
+// ========================================================================= //
+
+#endif
+
+// ========================================================================= //
\ No newline at end of file
@@ -21,12 +21,13 @@
 // Implements Input class.
 // ========================================================================= //
 
-#include "Command/CommandRepository.hpp"
 #include "Component/ComponentMessage.hpp"
 #include "Entity/Entity.hpp"
 #include "Input.hpp"
 #include "UI/UI.hpp"
 
+#include <algorithm>
+
 // ========================================================================= //
 
 static const Uint8* keystate = SDL_GetKeyboardState(nullptr);
@@ -34,35 +35,46 @@ static const Uint8* keystate = SDL_GetKeyboardState(nullptr);
 // ========================================================================= //
 
 Input::Input(void) :
-m_commandRepo(new CommandRepository()),
-m_keymap(),
-m_commands(),
+m_heldMask(0),
+m_heldKeys(),
+m_pressed(0),
+m_axes(),
+m_axesMoved(false),
+m_look(),
+m_frame(),
 m_gamepads(),
 m_mode(Mode::UI)
 {
-    // @TODO: For every key on keyboard read from keymap file
-    // (add mapKey() function which is a switch-case on the command).
-    for (unsigned int i = 0; i < SDLK_z; ++i){
-        //m_keymap.insert(KM_VT(i, m_commandRepo->NullCommand));
-        m_keymap[i] = m_commandRepo->getCommand(CommandType::Null);
-    }
-    m_keymap[SDLK_LALT] = m_commandRepo->getCommand(CommandType::Null);
-
-    // @TODO: Store movement keys (and anything that must be held down in a 
-    // list for processing in update.
-    m_keymap[SDLK_w] = m_commandRepo->getCommand(CommandType::MoveForward);
-    m_keymap[SDLK_s] = m_commandRepo->getCommand(CommandType::MoveBackward);
-    m_keymap[SDLK_a] = m_commandRepo->getCommand(CommandType::MoveLeft);
-    m_keymap[SDLK_d] = m_commandRepo->getCommand(CommandType::MoveRight);
-    m_keymap[SDLK_e] = m_commandRepo->getCommand(CommandType::Action);
-    m_keymap[SDLK_f] = m_commandRepo->getCommand(CommandType::Flashlight);
-    m_keymap[SDLK_SPACE] = m_commandRepo->getCommand(CommandType::Jump);
-    m_keymap[SDLK_LSHIFT] = m_commandRepo->getCommand(CommandType::Spectator);
+    std::fill(std::begin(m_keyBindings), std::end(m_keyBindings),
+              CommandType::Null);
+    std::fill(std::begin(m_mouseBindings), std::end(m_mouseBindings),
+              CommandType::Null);
+    std::fill(std::begin(m_gamepadBindings), std::end(m_gamepadBindings),
+              CommandType::Null);
+
+    // Movement is active while held, everything else once per press.
+    this->setHeld(CommandType::MoveForward, true);
+    this->setHeld(CommandType::MoveBackward, true);
+    this->setHeld(CommandType::MoveLeft, true);
+    this->setHeld(CommandType::MoveRight, true);
+
+    // @TODO: Read bindings from a keymap file.
+    this->bindKey(SDL_SCANCODE_W, CommandType::MoveForward);
+    this->bindKey(SDL_SCANCODE_S, CommandType::MoveBackward);
+    this->bindKey(SDL_SCANCODE_A, CommandType::MoveLeft);
+    this->bindKey(SDL_SCANCODE_D, CommandType::MoveRight);
+    this->bindKey(SDL_SCANCODE_E, CommandType::Action);
+    this->bindKey(SDL_SCANCODE_F, CommandType::Flashlight);
+    this->bindKey(SDL_SCANCODE_SPACE, CommandType::Jump);
+    this->bindKey(SDL_SCANCODE_LSHIFT, CommandType::Spectator);
+
+    this->bindMouseButton(SDL_BUTTON_LEFT, CommandType::Weapon);
 
     // Gamepad map.
-    m_gamepadMap[0] = m_commandRepo->getCommand(CommandType::Jump);
-    m_gamepadMap[2] = m_commandRepo->getCommand(CommandType::Action);
-    m_gamepadMap[10] = m_commandRepo->getCommand(CommandType::Flashlight);
+    this->bindGamepadButton(SDL_CONTROLLER_BUTTON_A, CommandType::Jump);
+    this->bindGamepadButton(SDL_CONTROLLER_BUTTON_X, CommandType::Action);
+    this->bindGamepadButton(SDL_CONTROLLER_BUTTON_RIGHTSHOULDER,
+                            CommandType::Flashlight);
 }
 
 // ========================================================================= //
@@ -113,21 +125,20 @@ void Input::handle(const SDL_Event& e)
                 CEGUI::System::getSingleton().getDefaultGUIContext().
                     injectMouseButtonUp(button);
             }
+            UI::notifyInput();
         }
-        else{
-            switch (e.button.button){
-            default:
-                break;
-
-            case SDL_BUTTON_LEFT:
-                this->pushCommand(
-                    m_commandRepo->getCommand(CommandType::Weapon));
-                break;
-
-            case SDL_BUTTON_RIGHT:
+        else if (e.type == SDL_MOUSEBUTTONDOWN &&
+                 e.button.button < sizeof(m_mouseBindings) /
+                 sizeof(m_mouseBindings[0])){
+            m_pressed |= InputFrame::bit(m_mouseBindings[e.button.button]);
+        }
+        break;
 
-                break;
-            }
+    case SDL_MOUSEMOTION:
+        {
+            const MouseMove mm = this->handleMouse(e);
+            m_look.relx += mm.relx;
+            m_look.rely += mm.rely;
         }
         break;
 
@@ -136,24 +147,14 @@ void Input::handle(const SDL_Event& e)
             CEGUI::Key::Scan kc = SDLKeyToCEGUIKey(e.key.keysym.sym);
             CEGUI::System::getSingleton().getDefaultGUIContext().
                 injectKeyDown(kc);
+            UI::notifyInput();
         }
-        else{
-            switch (e.key.keysym.sym){
-            default:
-                {
-                    CommandPtr command = m_keymap[e.key.keysym.sym];
-                    if (command){
-                        this->pushCommand(command);
-                    }
-                }
-                break;
-
-            case SDLK_w:
-            case SDLK_s:
-            case SDLK_a:
-            case SDLK_d:
-            case SDLK_ESCAPE:
-                break;
+        else if (e.key.repeat == 0){
+            // Held commands are sampled in sample().
+            const uint32_t bit =
+                InputFrame::bit(m_keyBindings[e.key.keysym.scancode]);
+            if ((bit & m_heldMask) == 0){
+                m_pressed |= bit;
             }
         }
         break;
@@ -162,6 +163,7 @@ void Input::handle(const SDL_Event& e)
         if (m_mode == Mode::UI){
             CEGUI::System::getSingleton().getDefaultGUIContext().
                 injectChar(e.text.text[0]);
+            UI::notifyInput();
         }
         break;
 
@@ -170,26 +172,27 @@ void Input::handle(const SDL_Event& e)
             CEGUI::Key::Scan kc = SDLKeyToCEGUIKey(e.key.keysym.sym);
             CEGUI::System::getSingleton().getDefaultGUIContext().
                 injectKeyUp(kc);
-        }
-        else{
-            switch (e.key.keysym.sym){
-            default:
-                break;
-            }
+            UI::notifyInput();
         }
         break;
 
     case SDL_CONTROLLERBUTTONDOWN:
-        printf("Controller: %d\n", e.cbutton.button);        
-        {
-            CommandPtr command = m_gamepadMap[e.cbutton.button];
-            this->pushCommand(command);
+        LogDebug("Controller: %d", e.cbutton.button);
+        if (e.cbutton.button < SDL_CONTROLLER_BUTTON_MAX){
+            m_pressed |= InputFrame::bit(m_gamepadBindings[e.cbutton.button]);
         }
         break;
 
     case SDL_CONTROLLERBUTTONUP:
 
         break;
+
+    case SDL_CONTROLLERAXISMOTION:
+        if (m_mode != Mode::UI){
+            m_axes = this->handleControllerAxisMotion(e);
+            m_axesMoved = true;
+        }
+        break;
     }
 }
 
@@ -204,6 +207,7 @@ const MouseMove Input::handleMouse(const SDL_Event& e)
         CEGUI::System::getSingleton().getDefaultGUIContext().
             injectMousePosition(static_cast<float>(e.motion.x),
             static_cast<float>(e.motion.y));
+        UI::notifyInput();
     }
     else{
         mm.relx = e.motion.xrel;
@@ -215,6 +219,34 @@ const MouseMove Input::handleMouse(const SDL_Event& e)
 
 // ========================================================================= //
 
+const MouseMove Input::peekMouseMotion(void)
+{
+    MouseMove mm;
+    mm.relx = mm.rely = 0;
+
+    if (m_mode != Mode::Player){
+        return mm;
+    }
+
+    // Collect what the OS has delivered since the last update.
+    SDL_PumpEvents();
+
+    SDL_Event events[64];
+    const int count = SDL_PeepEvents(events,
+                                     64,
+                                     SDL_PEEKEVENT,
+                                     SDL_MOUSEMOTION,
+                                     SDL_MOUSEMOTION);
+    for (int i = 0; i < count; ++i){
+        mm.relx += events[i].motion.xrel;
+        mm.rely += events[i].motion.yrel;
+    }
+
+    return mm;
+}
+
+// ========================================================================= //
+
 const ControllerAxisMotion Input::handleControllerAxisMotion(const SDL_Event& e)
 {
     ControllerAxisMotion m;
@@ -245,47 +277,86 @@ const ControllerAxisMotion Input::handleControllerAxisMotion(const SDL_Event& e)
 
 // ========================================================================= //
 
-void Input::update(void)
+const InputFrame& Input::sample(void)
 {
-    if (keystate[SDL_SCANCODE_W]){
-        this->pushCommand(m_keymap[SDLK_w]);
-    }
-    if (keystate[SDL_SCANCODE_S]){
-        this->pushCommand(m_keymap[SDLK_s]);
-    }
-    if (keystate[SDL_SCANCODE_A]){
-        this->pushCommand(m_keymap[SDLK_a]);
-    }
-    if (keystate[SDL_SCANCODE_D]){
-        this->pushCommand(m_keymap[SDLK_d]);
+    uint32_t held = 0;
+    for (auto& key : m_heldKeys){
+        if (keystate[key.first]){
+            held |= key.second;
+        }
     }
+
+    m_frame.buttons = (held | m_pressed) &
+        ~InputFrame::bit(CommandType::Null);
+    m_frame.axes = m_axes;
+    m_frame.axesMoved = m_axesMoved;
+    m_frame.look = m_look;
+    ++m_frame.tick;
+
+    m_pressed = 0;
+    m_axesMoved = false;
+    m_look.relx = m_look.rely = 0;
+
+    return m_frame;
+}
+
+// ========================================================================= //
+
+// Bindings:
+
+// ========================================================================= //
+
+void Input::bindKey(const SDL_Scancode key, const CommandType type)
+{
+    m_keyBindings[key] = type;
+    this->compileHeldKeys();
 }
 
 // ========================================================================= //
 
-// Command queue:
+void Input::bindMouseButton(const Uint8 button, const CommandType type)
+{
+    Assert(button < sizeof(m_mouseBindings) / sizeof(m_mouseBindings[0]),
+           "Invalid mouse button");
+
+    m_mouseBindings[button] = type;
+}
 
 // ========================================================================= //
 
-void Input::pushCommand(CommandPtr command)
+void Input::bindGamepadButton(const Uint8 button, const CommandType type)
 {
-    m_commands.push(command);
+    Assert(button < SDL_CONTROLLER_BUTTON_MAX, "Invalid gamepad button");
+
+    m_gamepadBindings[button] = type;
 }
 
 // ========================================================================= //
 
-const bool Input::hasPendingCommand(void) const
+void Input::setHeld(const CommandType type, const bool held)
 {
-    return (m_commands.empty() == false);
+    if (held){
+        m_heldMask |= InputFrame::bit(type);
+    }
+    else{
+        m_heldMask &= ~InputFrame::bit(type);
+    }
+
+    this->compileHeldKeys();
 }
 
 // ========================================================================= //
 
-CommandPtr Input::getNextCommand(void)
+void Input::compileHeldKeys(void)
 {
-    CommandPtr command = m_commands.front();
-    m_commands.pop();
-    return command;
+    m_heldKeys.clear();
+    for (int i = 0; i < SDL_NUM_SCANCODES; ++i){
+        const uint32_t bit = InputFrame::bit(m_keyBindings[i]);
+        if (m_keyBindings[i] != CommandType::Null && (bit & m_heldMask) != 0){
+            m_heldKeys.push_back(
+                std::make_pair(static_cast<SDL_Scancode>(i), bit));
+        }
+    }
 }
 
 // ========================================================================= //
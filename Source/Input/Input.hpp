@@ -26,15 +26,13 @@
 
 // ========================================================================= //
 
+#include "InputFrame.hpp"
 #include "stdafx.hpp"
 
 // ========================================================================= //
-
-typedef std::unordered_map<uint32_t, CommandPtr> KeyMap;
-
-// ========================================================================= //
-// Handles input events generated by SDL. Pushes any events that need handling
-// into its internal queue for processing by the engine state.
+// Handles input events generated by SDL. In UI mode events are injected into
+// CEGUI; in Player mode they are compiled, through rebindable lookup tables,
+// into one InputFrame per tick for the engine state to read.
 class Input
 {
 public:
@@ -44,17 +42,23 @@ public:
     // Empty destructor.
     ~Input(void);
 
-    // Processes SDL input events, returns corresponding command object.
+    // Processes SDL input events, recording them for the next frame.
     void handle(const SDL_Event& e);
 
     // Returns a MouseMove struct with mouse movement data.
     const MouseMove handleMouse(const SDL_Event& e);
 
+    // Returns the sum of mouse motion queued in SDL and not yet handled,
+    // leaving the events for the next update. Zero outside Player mode.
+    const MouseMove peekMouseMotion(void);
+
     // Retrieves controller axis data and returns it in a struct.
     const ControllerAxisMotion handleControllerAxisMotion(const SDL_Event& e);
 
-    // Detects movement keys and pushes events as needed.
-    void update(void);
+    // Samples held keys, combines them with events handled since the last
+    // call and returns the frame for this tick. Call once per tick, after
+    // handling the tick's events.
+    const InputFrame& sample(void);
 
     // Holds an instance of a gamepad.
     struct Gamepad{
@@ -68,16 +72,20 @@ public:
         Locked
     };
 
-    // Command queue:
+    // Bindings:
 
-    // Inserts command into command queue.
-    void pushCommand(CommandPtr command);
+    // Binds a key to a command, CommandType::Null unbinds it.
+    void bindKey(const SDL_Scancode key, const CommandType type);
 
-    // Returns true if there are commands in the queue.
-    const bool hasPendingCommand(void) const;
+    // Binds a mouse button (SDL_BUTTON_*) to a command.
+    void bindMouseButton(const Uint8 button, const CommandType type);
 
-    // Returns pointer to next command in queue.
-    CommandPtr getNextCommand(void);
+    // Binds a gamepad button (SDL_CONTROLLER_BUTTON_*) to a command.
+    void bindGamepadButton(const Uint8 button, const CommandType type);
+
+    // Sets whether a command is active for as long as its key is held,
+    // rather than once per press.
+    void setHeld(const CommandType type, const bool held);
 
     // Gamepads:
 
@@ -95,16 +103,32 @@ public:
     // Returns current Input mode.
     const Mode getMode(void) const;
 
+    // Returns the last sampled frame.
+    const InputFrame& getFrame(void) const;
+
     // Setters:
 
     // Sets the mode of the Input handler.
     void setMode(const Mode mode);
 
 private:
-    std::shared_ptr<CommandRepository> m_commandRepo;
-    KeyMap m_keymap;
-    KeyMap m_gamepadMap;
-    std::queue<CommandPtr> m_commands;
+    // Rebuilds the list of keys sampled each tick.
+    void compileHeldKeys(void);
+
+    // Compiled bindings, indexed by scancode or button.
+    CommandType m_keyBindings[SDL_NUM_SCANCODES];
+    CommandType m_mouseBindings[8];
+    CommandType m_gamepadBindings[SDL_CONTROLLER_BUTTON_MAX];
+    // Commands active while held, and the keys bound to them.
+    uint32_t m_heldMask;
+    std::vector<std::pair<SDL_Scancode, uint32_t>> m_heldKeys;
+
+    // Input gathered since the last sample, and the last frame.
+    uint32_t m_pressed;
+    ControllerAxisMotion m_axes;
+    bool m_axesMoved;
+    MouseMove m_look;
+    InputFrame m_frame;
 
     // Keep a list of connected gamepads.
     std::unordered_map<Sint32, Gamepad> m_gamepads;
@@ -120,6 +144,10 @@ inline const Input::Mode Input::getMode(void) const{
     return m_mode;
 }
 
+inline const InputFrame& Input::getFrame(void) const{
+    return m_frame;
+}
+
 // ========================================================================= //
 
 #endif
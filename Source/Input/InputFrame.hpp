@@ -0,0 +1,70 @@
+// ========================================================================= //
+// Talos - A 3D game engine with network multiplayer.
+// Copyright(C) 2015 Jordan Sparks <unixunited@live.com>
+//
+// This program is free software; you can redistribute it and / or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 3
+// of the License, or(at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+// ========================================================================= //
+// File: InputFrame.hpp
+// Author: Jordan Sparks <unixunited@live.com>
+// ========================================================================= //
+// Defines InputFrame struct.
+// ========================================================================= //
+
+#ifndef __INPUTFRAME_HPP__
+#define __INPUTFRAME_HPP__
+
+// ========================================================================= //
+
+#include "Component/ComponentMessage.hpp"
+#include "stdafx.hpp"
+
+// ========================================================================= //
+// Player input sampled once per tick. Commands are bits, set if the bound
+// key or button is held (movement) or was pressed during the tick; mouse
+// motion is the sum over the tick.
+struct InputFrame{
+    // Number of CommandType values, all of which fit in buttons.
+    static const uint32_t CommandCount =
+        static_cast<uint32_t>(CommandType::Spectator) + 1;
+
+    // Returns the bit for a command.
+    static uint32_t bit(const CommandType type){
+        return 1u << static_cast<uint32_t>(type);
+    }
+
+    // Returns true if the command is active this tick.
+    bool isActive(const CommandType type) const{
+        return (buttons & bit(type)) != 0;
+    }
+
+    // Active commands.
+    uint32_t buttons;
+
+    // Left (x1, y1) and right (x2, y2) gamepad sticks, raw SDL range.
+    ControllerAxisMotion axes;
+    // True if axes changed during the tick.
+    bool axesMoved;
+
+    // Relative mouse motion accumulated over the tick.
+    MouseMove look;
+
+    // Number of the tick this frame was sampled on.
+    uint32_t tick;
+};
+
+// ========================================================================= //
+
+#endif
+
+// ========================================================================= //
\ No newline at end of file
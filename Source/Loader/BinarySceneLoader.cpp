@@ -0,0 +1,550 @@
+// ========================================================================= //
+// Talos - A 3D game engine with network multiplayer.
+// Copyright(C) 2015 Jordan Sparks <unixunited@live.com>
+//
+// This program is free software; you can redistribute it and / or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 3
+// of the License, or(at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+// ========================================================================= //
+// File: BinarySceneLoader.cpp
+// Author: Jordan Sparks <unixunited@live.com>
+// ========================================================================= //
+// Implements BinarySceneLoader class.
+// ========================================================================= //
+
+#include "BinarySceneLoader.hpp"
+
+#ifdef WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// ========================================================================= //
+
+BinarySceneLoader::BinarySceneLoader(void) :
+m_data(nullptr),
+m_size(0),
+m_buffer(),
+m_mapped(false),
+m_loadLights(false)
+{
+
+}
+
+// ========================================================================= //
+
+BinarySceneLoader::~BinarySceneLoader(void)
+{
+    this->close();
+}
+
+// ========================================================================= //
+
+bool BinarySceneLoader::load(const std::string& file,
+                             const std::string& group,
+                             Ogre::SceneManager* sceneMgr,
+                             Ogre::SceneNode* attachNode,
+                             const std::string& prependNode)
+{
+    Ogre::Timer timer;
+
+    if (this->open(file, group) == false){
+        return false;
+    }
+
+    this->instantiate(group, sceneMgr, attachNode, prependNode);
+
+    const SceneFile::Header& header = this->getHeader();
+    Talos::Log::getSingleton().log("Loaded binary scene " + file + " (" +
+                                   toString(header.nodeCount) + " nodes, " +
+                                   toString(header.entityCount) +
+                                   " entities) in " +
+                                   toString(timer.getMicroseconds() /
+                                            1000.f) + " ms");
+
+    this->close();
+
+    return true;
+}
+
+// ========================================================================= //
+
+bool BinarySceneLoader::open(const std::string& file,
+                             const std::string& group)
+{
+    if (this->openFile(file, group) == false){
+        return false;
+    }
+
+    if (this->validate(file) == false){
+        this->close();
+        return false;
+    }
+
+    return true;
+}
+
+// ========================================================================= //
+
+bool BinarySceneLoader::open(std::vector<char>& image,
+                             const std::string& name)
+{
+    this->close();
+
+    m_buffer.swap(image);
+    if (m_buffer.empty() == false){
+        m_data = &m_buffer[0];
+    }
+    m_size = m_buffer.size();
+
+    if (this->validate(name) == false){
+        this->close();
+        return false;
+    }
+
+    return true;
+}
+
+// ========================================================================= //
+
+void BinarySceneLoader::instantiate(
+    const std::string& group,
+    Ogre::SceneManager* sceneMgr,
+    Ogre::SceneNode* attachNode,
+    const std::string& prependNode,
+    const std::vector<Ogre::MeshPtr>* meshes) const
+{
+    Assert(this->isOpen(), "No binary scene open to instantiate");
+
+    const SceneFile::Header& header = this->getHeader();
+    Ogre::SceneNode* root = (attachNode != nullptr) ?
+        attachNode : sceneMgr->getRootSceneNode();
+
+    std::vector<Ogre::SceneNode*> nodes;
+    this->createNodes(root, prependNode, nodes);
+
+    for (uint32_t i = 0; i < header.entityCount; ++i){
+        this->createEntity(i,
+                           nodes,
+                           sceneMgr,
+                           group,
+                           (meshes != nullptr) ? &(*meshes)[i] : nullptr);
+    }
+
+    for (uint32_t i = 0; m_loadLights && i < header.lightCount; ++i){
+        this->createLight(i, nodes, sceneMgr);
+    }
+}
+
+// ========================================================================= //
+
+void BinarySceneLoader::createNodes(Ogre::SceneNode* root,
+                                    const std::string& prependNode,
+                                    std::vector<Ogre::SceneNode*>& nodes) const
+{
+    const SceneFile::Header* header =
+        this->getRecords<SceneFile::Header>(0);
+
+    if (header->flags & SceneFile::RootPosition){
+        root->setPosition(Ogre::Vector3(header->rootPosition));
+    }
+    if (header->flags & SceneFile::RootOrientation){
+        root->setOrientation(Ogre::Quaternion(
+            const_cast<Ogre::Real*>(header->rootOrientation)));
+    }
+    if (header->flags & SceneFile::RootScale){
+        root->setScale(Ogre::Vector3(header->rootScale));
+    }
+    if (header->flags != 0){
+        root->setInitialState();
+    }
+
+    // Nodes are stored parents first, so every parent already exists.
+    nodes.assign(header->nodeCount, nullptr);
+    const SceneFile::Node* nodeRecords =
+        this->getRecords<SceneFile::Node>(header->nodeOffset);
+    for (uint32_t i = 0; i < header->nodeCount; ++i){
+        const SceneFile::Node& record = nodeRecords[i];
+        Ogre::SceneNode* parent = (record.parent == SceneFile::NoParent) ?
+            root : nodes[record.parent];
+
+        const Ogre::Vector3 position(record.position);
+        const Ogre::Quaternion orientation(
+            const_cast<Ogre::Real*>(record.orientation));
+        const std::string name = prependNode + this->getString(record.name);
+
+        Ogre::SceneNode* node = (name.empty()) ?
+            parent->createChildSceneNode(position, orientation) :
+            parent->createChildSceneNode(name, position, orientation);
+        node->setScale(Ogre::Vector3(record.scale));
+        node->setInitialState();
+
+        nodes[i] = node;
+    }
+}
+
+// ========================================================================= //
+
+Ogre::Entity* BinarySceneLoader::createEntity(
+    const uint32_t index,
+    const std::vector<Ogre::SceneNode*>& nodes,
+    Ogre::SceneManager* sceneMgr,
+    const std::string& group,
+    const Ogre::MeshPtr* mesh) const
+{
+    return this->createEntity(index,
+                              nodes[this->getEntity(index).node],
+                              sceneMgr,
+                              group,
+                              mesh);
+}
+
+// ========================================================================= //
+
+Ogre::Entity* BinarySceneLoader::createEntity(
+    const uint32_t index,
+    Ogre::SceneNode* node,
+    Ogre::SceneManager* sceneMgr,
+    const std::string& group,
+    const Ogre::MeshPtr* mesh) const
+{
+    const SceneFile::Entity& record = this->getEntity(index);
+    const char* meshName = this->getString(record.mesh);
+
+    Ogre::Entity* entity = nullptr;
+    try{
+        if (mesh != nullptr){
+            // Already reported when the mesh was loaded.
+            if (mesh->isNull()){
+                return nullptr;
+            }
+            entity = sceneMgr->createEntity(*mesh);
+        }
+        else{
+            Ogre::MeshManager::getSingleton().load(meshName, group);
+            entity = sceneMgr->createEntity(meshName);
+        }
+        // Same default material as DotSceneLoader.
+        entity->setMaterialName("Airship");
+        entity->setCastShadows(
+            (record.flags & SceneFile::EntityCastShadows) != 0);
+        if (node != nullptr){
+            node->attachObject(entity);
+        }
+
+        if (record.material != SceneFile::NoString){
+            entity->setMaterialName(this->getString(record.material));
+        }
+        if (record.userData != SceneFile::NoString){
+            entity->setUserAny(Ogre::Any(Ogre::String(
+                this->getString(record.userData))));
+        }
+    }
+    catch (Ogre::Exception& e){
+        Talos::Log::getSingleton().log("Failed to load entity " +
+                                       std::string(meshName) + ": " +
+                                       e.getDescription());
+        return nullptr;
+    }
+
+    return entity;
+}
+
+// ========================================================================= //
+
+Ogre::Light* BinarySceneLoader::createLight(
+    const uint32_t index,
+    const std::vector<Ogre::SceneNode*>& nodes,
+    Ogre::SceneManager* sceneMgr) const
+{
+    const SceneFile::Light& record = this->getLight(index);
+
+    Ogre::Light* light = (record.name == SceneFile::NoString) ?
+        sceneMgr->createLight() :
+        sceneMgr->createLight(this->getString(record.name));
+    nodes[record.node]->attachObject(light);
+
+    light->setType(static_cast<Ogre::Light::LightTypes>(record.type));
+    light->setVisible((record.flags & SceneFile::LightVisible) != 0);
+    light->setCastShadows(
+        (record.flags & SceneFile::LightCastShadows) != 0);
+    if (record.flags & SceneFile::LightPosition){
+        light->setPosition(Ogre::Vector3(record.position));
+    }
+    if (record.flags & SceneFile::LightDirection){
+        light->setDirection(Ogre::Vector3(record.direction));
+    }
+    if (record.flags & SceneFile::LightDiffuse){
+        light->setDiffuseColour(Ogre::ColourValue(
+            record.diffuse[0], record.diffuse[1],
+            record.diffuse[2], record.diffuse[3]));
+    }
+    if (record.flags & SceneFile::LightSpecular){
+        light->setSpecularColour(Ogre::ColourValue(
+            record.specular[0], record.specular[1],
+            record.specular[2], record.specular[3]));
+    }
+    if (record.flags & SceneFile::LightRange){
+        light->setSpotlightRange(Ogre::Angle(record.range[0]),
+                                 Ogre::Angle(record.range[1]),
+                                 record.range[2]);
+    }
+    if (record.flags & SceneFile::LightAttenuation){
+        light->setAttenuation(record.attenuation[0],
+                              record.attenuation[1],
+                              record.attenuation[2],
+                              record.attenuation[3]);
+    }
+    if (record.userData != SceneFile::NoString){
+        light->setUserAny(Ogre::Any(Ogre::String(
+            this->getString(record.userData))));
+    }
+
+    return light;
+}
+
+// ========================================================================= //
+
+bool BinarySceneLoader::openFile(const std::string& file,
+                                 const std::string& group)
+{
+    this->close();
+
+    Ogre::ResourceGroupManager& resources =
+        Ogre::ResourceGroupManager::getSingleton();
+    if (resources.resourceExists(group, file) == false){
+        return false;
+    }
+
+    // Map the file directly when it lives on disk.
+    Ogre::FileInfoListPtr info = resources.findResourceFileInfo(group, file);
+    if (info->empty() == false &&
+        info->front().archive->getType() == "FileSystem"){
+        const std::string path = info->front().archive->getName() + "/" +
+            info->front().filename;
+        if (this->mapFile(path)){
+            return true;
+        }
+    }
+
+    // Otherwise (e.g. a Zip archive) read it into memory.
+    Ogre::DataStreamPtr stream = resources.openResource(file, group);
+    m_buffer.resize(stream->size());
+    if (m_buffer.empty() == false){
+        stream->read(&m_buffer[0], m_buffer.size());
+        m_data = &m_buffer[0];
+    }
+    m_size = m_buffer.size();
+
+    return true;
+}
+
+// ========================================================================= //
+
+bool BinarySceneLoader::mapFile(const std::string& path)
+{
+#ifdef WIN32
+    HANDLE file = CreateFileA(path.c_str(),
+                              GENERIC_READ,
+                              FILE_SHARE_READ,
+                              nullptr,
+                              OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+                              nullptr);
+    if (file == INVALID_HANDLE_VALUE){
+        return false;
+    }
+
+    LARGE_INTEGER size;
+    if (GetFileSizeEx(file, &size) == FALSE || size.QuadPart == 0){
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY,
+                                        0, 0, nullptr);
+    // The view keeps the mapping and file alive.
+    CloseHandle(file);
+    if (mapping == nullptr){
+        return false;
+    }
+
+    const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (view == nullptr){
+        return false;
+    }
+
+    m_data = static_cast<const char*>(view);
+    m_size = static_cast<size_t>(size.QuadPart);
+#else
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd == -1){
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0){
+        ::close(fd);
+        return false;
+    }
+
+    void* view = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (view == MAP_FAILED){
+        return false;
+    }
+
+    m_data = static_cast<const char*>(view);
+    m_size = static_cast<size_t>(st.st_size);
+#endif
+
+    m_mapped = true;
+
+    return true;
+}
+
+// ========================================================================= //
+
+void BinarySceneLoader::close(void)
+{
+    if (m_mapped){
+#ifdef WIN32
+        UnmapViewOfFile(m_data);
+#else
+        munmap(const_cast<char*>(m_data), m_size);
+#endif
+        m_mapped = false;
+    }
+
+    m_buffer.clear();
+    m_data = nullptr;
+    m_size = 0;
+}
+
+// ========================================================================= //
+
+bool BinarySceneLoader::validate(const std::string& file) const
+{
+    if (m_size < sizeof(SceneFile::Header)){
+        Talos::Log::getSingleton().log("Binary scene " + file +
+                                       " is truncated");
+        return false;
+    }
+
+    const SceneFile::Header* header =
+        this->getRecords<SceneFile::Header>(0);
+    if (header->magic != SceneFile::Magic){
+        Talos::Log::getSingleton().log(file + " is not a binary scene");
+        return false;
+    }
+    if (header->version != SceneFile::Version){
+        Talos::Log::getSingleton().log("Binary scene " + file +
+                                       " has version " +
+                                       toString(header->version) +
+                                       ", expected " +
+                                       toString(SceneFile::Version) +
+                                       "; recompile it");
+        return false;
+    }
+
+    // Every array must lie within the file at an aligned offset.
+    const uint64_t size = m_size;
+    const uint64_t nodesEnd = uint64_t(header->nodeOffset) +
+        uint64_t(header->nodeCount) * sizeof(SceneFile::Node);
+    const uint64_t entitiesEnd = uint64_t(header->entityOffset) +
+        uint64_t(header->entityCount) * sizeof(SceneFile::Entity);
+    const uint64_t lightsEnd = uint64_t(header->lightOffset) +
+        uint64_t(header->lightCount) * sizeof(SceneFile::Light);
+    const uint64_t stringsEnd = uint64_t(header->stringsOffset) +
+        header->stringsSize;
+    const uint32_t offsets = header->nodeOffset | header->entityOffset |
+        header->lightOffset | header->stringsOffset;
+    if (nodesEnd > size || entitiesEnd > size || lightsEnd > size ||
+        stringsEnd > size || (offsets & 3) != 0 ||
+        (header->stringsSize != 0 &&
+         m_data[header->stringsOffset + header->stringsSize - 1] != '\0')){
+        Talos::Log::getSingleton().log("Binary scene " + file +
+                                       " is corrupt");
+        return false;
+    }
+
+    bool valid = true;
+
+    const SceneFile::Node* nodes =
+        this->getRecords<SceneFile::Node>(header->nodeOffset);
+    for (uint32_t i = 0; valid && i < header->nodeCount; ++i){
+        valid = (nodes[i].parent == SceneFile::NoParent ||
+                 (nodes[i].parent >= 0 &&
+                  static_cast<uint32_t>(nodes[i].parent) < i)) &&
+            this->isValidString(nodes[i].name) &&
+            this->isValidString(nodes[i].userData);
+    }
+
+    const SceneFile::Entity* entities =
+        this->getRecords<SceneFile::Entity>(header->entityOffset);
+    for (uint32_t i = 0; valid && i < header->entityCount; ++i){
+        valid = entities[i].node < header->nodeCount &&
+            entities[i].mesh != SceneFile::NoString &&
+            this->isValidString(entities[i].mesh) &&
+            this->isValidString(entities[i].name) &&
+            this->isValidString(entities[i].material) &&
+            this->isValidString(entities[i].userData);
+    }
+
+    const SceneFile::Light* lights =
+        this->getRecords<SceneFile::Light>(header->lightOffset);
+    for (uint32_t i = 0; valid && i < header->lightCount; ++i){
+        valid = lights[i].node < header->nodeCount &&
+            lights[i].type <= Ogre::Light::LT_SPOTLIGHT &&
+            this->isValidString(lights[i].name) &&
+            this->isValidString(lights[i].userData);
+    }
+
+    if (valid == false){
+        Talos::Log::getSingleton().log("Binary scene " + file +
+                                       " has invalid records");
+    }
+
+    return valid;
+}
+
+// ========================================================================= //
+
+const char* BinarySceneLoader::getString(const uint32_t offset) const
+{
+    if (offset == SceneFile::NoString){
+        return "";
+    }
+
+    const SceneFile::Header* header =
+        this->getRecords<SceneFile::Header>(0);
+
+    return m_data + header->stringsOffset + offset;
+}
+
+// ========================================================================= //
+
+bool BinarySceneLoader::isValidString(const uint32_t offset) const
+{
+    const SceneFile::Header* header =
+        this->getRecords<SceneFile::Header>(0);
+
+    return offset == SceneFile::NoString || offset < header->stringsSize;
+}
+
+// ========================================================================= //
\ No newline at end of file
@@ -0,0 +1,206 @@
+// ========================================================================= //
+// Talos - A 3D game engine with network multiplayer.
+// Copyright(C) 2015 Jordan Sparks <unixunited@live.com>
+//
+// This program is free software; you can redistribute it and / or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 3
+// of the License, or(at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+// ========================================================================= //
+// File: BinarySceneLoader.hpp
+// Author: Jordan Sparks <unixunited@live.com>
+// ========================================================================= //
+// Defines BinarySceneLoader class.
+// ========================================================================= //
+
+#ifndef __BINARYSCENELOADER_HPP__
+#define __BINARYSCENELOADER_HPP__
+
+// ========================================================================= //
+
+#include "stdafx.hpp"
+
+#include "SceneFile.hpp"
+
+// ========================================================================= //
+// Instantiates scenes compiled by SceneCompiler. Files in a FileSystem
+// resource location are memory mapped, others are read into memory; either
+// way the records are used in place, so loading costs no text parsing.
+class BinarySceneLoader final
+{
+public:
+    // Default initializes member data.
+    explicit BinarySceneLoader(void);
+
+    // Unmaps any open file.
+    ~BinarySceneLoader(void);
+
+    // Opens the file, creates the scene below attachNode (the root scene
+    // node if null) and closes it again. Returns false if the file does not
+    // exist, is malformed or was compiled for another format version.
+    bool load(const std::string& file,
+              const std::string& group,
+              Ogre::SceneManager* sceneMgr,
+              Ogre::SceneNode* attachNode = nullptr,
+              const std::string& prependNode = "");
+
+    // Maps (or reads) and validates a compiled scene, keeping it open until
+    // close() or destruction.
+    bool open(const std::string& file, const std::string& group);
+
+    // Takes over an in-memory image, e.g. from SceneCompiler, and validates
+    // it. The name is only used for logging.
+    bool open(std::vector<char>& image, const std::string& name);
+
+    // Releases the mapping or buffer.
+    void close(void);
+
+    // Creates the open scene's nodes and entities (and lights, if enabled)
+    // below attachNode. Node names are prefixed with prependNode. If meshes
+    // is given it holds a loaded mesh for each entity record, otherwise
+    // meshes are loaded by name from group.
+    void instantiate(const std::string& group,
+                     Ogre::SceneManager* sceneMgr,
+                     Ogre::SceneNode* attachNode = nullptr,
+                     const std::string& prependNode = "",
+                     const std::vector<Ogre::MeshPtr>* meshes = nullptr) const;
+
+    // Single steps of instantiate(), for callers spreading the work out:
+
+    // Applies the root transform to root and creates every node below it,
+    // parents first. nodes receives one scene node per node record.
+    void createNodes(Ogre::SceneNode* root,
+                     const std::string& prependNode,
+                     std::vector<Ogre::SceneNode*>& nodes) const;
+
+    // Creates entity record index and attaches it to its node. mesh is the
+    // loaded mesh, or null to load it by name from group. Returns nullptr on
+    // failure.
+    Ogre::Entity* createEntity(const uint32_t index,
+                               const std::vector<Ogre::SceneNode*>& nodes,
+                               Ogre::SceneManager* sceneMgr,
+                               const std::string& group,
+                               const Ogre::MeshPtr* mesh = nullptr) const;
+
+    // As above, but attaches the entity to node, or to nothing if null.
+    Ogre::Entity* createEntity(const uint32_t index,
+                               Ogre::SceneNode* node,
+                               Ogre::SceneManager* sceneMgr,
+                               const std::string& group,
+                               const Ogre::MeshPtr* mesh = nullptr) const;
+
+    // Creates light record index and attaches it to its node.
+    Ogre::Light* createLight(const uint32_t index,
+                             const std::vector<Ogre::SceneNode*>& nodes,
+                             Ogre::SceneManager* sceneMgr) const;
+
+    // Getters:
+
+    // Returns true if a scene is open.
+    const bool isOpen(void) const;
+
+    // Returns header of the open scene.
+    const SceneFile::Header& getHeader(void) const;
+
+    // Returns node record of the open scene.
+    const SceneFile::Node& getNode(const uint32_t index) const;
+
+    // Returns entity record of the open scene.
+    const SceneFile::Entity& getEntity(const uint32_t index) const;
+
+    // Returns light record of the open scene.
+    const SceneFile::Light& getLight(const uint32_t index) const;
+
+    // Returns the string at offset in the pool, or "" for NoString.
+    const char* getString(const uint32_t offset) const;
+
+    // Returns true if lights are instantiated.
+    const bool getLoadLights(void) const;
+
+    // Setters:
+
+    // Lights are skipped by default, matching DotSceneLoader.
+    void setLoadLights(const bool);
+
+private:
+    // Maps (or reads) the file, setting m_data and m_size.
+    bool openFile(const std::string& file, const std::string& group);
+
+    // Maps the file at path. Returns false if it cannot be mapped.
+    bool mapFile(const std::string& path);
+
+    // Checks the header, record bounds and cross references.
+    bool validate(const std::string& file) const;
+
+    // Returns true if offset is NoString or inside the pool.
+    bool isValidString(const uint32_t offset) const;
+
+    template<typename T>
+    const T* getRecords(const uint32_t offset) const;
+
+    const char* m_data;
+    size_t m_size;
+    std::vector<char> m_buffer;
+    // True if m_data is a mapped view rather than m_buffer.
+    bool m_mapped;
+    bool m_loadLights;
+};
+
+// ========================================================================= //
+
+template<typename T>
+inline const T* BinarySceneLoader::getRecords(const uint32_t offset) const{
+    return reinterpret_cast<const T*>(m_data + offset);
+}
+
+// Getters:
+
+inline const bool BinarySceneLoader::isOpen(void) const{
+    return m_data != nullptr;
+}
+
+inline const SceneFile::Header& BinarySceneLoader::getHeader(void) const{
+    return *this->getRecords<SceneFile::Header>(0);
+}
+
+inline const SceneFile::Node&
+BinarySceneLoader::getNode(const uint32_t index) const{
+    return this->getRecords<SceneFile::Node>(
+        this->getHeader().nodeOffset)[index];
+}
+
+inline const SceneFile::Entity&
+BinarySceneLoader::getEntity(const uint32_t index) const{
+    return this->getRecords<SceneFile::Entity>(
+        this->getHeader().entityOffset)[index];
+}
+
+inline const SceneFile::Light&
+BinarySceneLoader::getLight(const uint32_t index) const{
+    return this->getRecords<SceneFile::Light>(
+        this->getHeader().lightOffset)[index];
+}
+
+inline const bool BinarySceneLoader::getLoadLights(void) const{
+    return m_loadLights;
+}
+
+// Setters:
+
+inline void BinarySceneLoader::setLoadLights(const bool loadLights){
+    m_loadLights = loadLights;
+}
+
+// ========================================================================= //
+
+#endif
+
+// ========================================================================= //
\ No newline at end of file
@@ -0,0 +1,215 @@
+// ========================================================================= //
+// Talos - A 3D game engine with network multiplayer.
+// Copyright(C) 2015 Jordan Sparks <unixunited@live.com>
+//
+// This program is free software; you can redistribute it and / or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 3
+// of the License, or(at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+// ========================================================================= //
+// File: IncrementalSceneLoader.cpp
+// Author: Jordan Sparks <unixunited@live.com>
+// ========================================================================= //
+// Implements IncrementalSceneLoader class.
+// ========================================================================= //
+
+#include "IncrementalSceneLoader.hpp"
+
+#include <algorithm>
+
+// ========================================================================= //
+
+// Distance the focus must move before the work list is re-ordered.
+static const Ogre::Real ResortDistance = 50.f;
+
+// ========================================================================= //
+
+IncrementalSceneLoader::IncrementalSceneLoader(
+    SceneTemplateCache::SceneTemplatePtr sceneTemplate,
+    Ogre::SceneManager* sceneMgr,
+    Ogre::SceneNode* attachNode,
+    const std::string& prependNode) :
+m_template(sceneTemplate),
+m_sceneMgr(sceneMgr),
+m_attachNode(attachNode),
+m_prependNode(prependNode),
+m_nodes(),
+m_work(),
+m_total(0),
+m_focus(Ogre::Vector3::ZERO),
+m_sorted(false),
+m_started(false),
+m_cancelled(false),
+m_entityCallback(),
+m_timer(),
+m_timeSpent(0.f)
+{
+
+}
+
+// ========================================================================= //
+
+IncrementalSceneLoader::~IncrementalSceneLoader(void)
+{
+
+}
+
+// ========================================================================= //
+
+void IncrementalSceneLoader::start(void)
+{
+    const BinarySceneLoader& scene = m_template->getScene();
+    const SceneFile::Header& header = scene.getHeader();
+
+    m_timer.reset();
+
+    scene.createNodes(m_attachNode, m_prependNode, m_nodes);
+
+    m_work.reserve(header.entityCount + header.lightCount);
+    for (uint32_t i = 0; i < header.entityCount; ++i){
+        WorkItem item;
+        item.index = i;
+        item.light = false;
+        item.distance = 0.f;
+        m_work.push_back(item);
+    }
+    for (uint32_t i = 0; scene.getLoadLights() && i < header.lightCount; ++i){
+        WorkItem item;
+        item.index = i;
+        item.light = true;
+        item.distance = 0.f;
+        m_work.push_back(item);
+    }
+    m_total = m_work.size();
+    m_started = true;
+
+    m_timeSpent += m_timer.getMicroseconds() / 1000.f;
+}
+
+// ========================================================================= //
+
+bool IncrementalSceneLoader::update(const Ogre::Real budget,
+                                    const Ogre::Vector3& focus)
+{
+    if (m_started == false){
+        this->start();
+    }
+    if (this->isFinished()){
+        return true;
+    }
+
+    m_timer.reset();
+
+    if (m_sorted == false ||
+        m_focus.squaredDistance(focus) > ResortDistance * ResortDistance){
+        this->sort(focus);
+    }
+
+    Ogre::Real spent = 0.f;
+    do{
+        this->create(m_work.back());
+        m_work.pop_back();
+
+        spent = m_timer.getMicroseconds() / 1000.f;
+    } while (m_work.empty() == false && spent < budget);
+
+    m_timeSpent += spent;
+
+    return m_work.empty();
+}
+
+// ========================================================================= //
+
+void IncrementalSceneLoader::createWithin(const Ogre::Vector3& focus,
+                                          const Ogre::Real radius)
+{
+    if (m_started == false){
+        this->start();
+    }
+    if (this->isFinished()){
+        return;
+    }
+
+    m_timer.reset();
+
+    // Distances are stored squared.
+    this->sort(focus);
+    while (m_work.empty() == false &&
+           m_work.back().distance <= radius * radius){
+        this->create(m_work.back());
+        m_work.pop_back();
+    }
+
+    m_timeSpent += m_timer.getMicroseconds() / 1000.f;
+}
+
+// ========================================================================= //
+
+void IncrementalSceneLoader::cancel(void)
+{
+    m_cancelled = true;
+    m_work.clear();
+}
+
+// ========================================================================= //
+
+void IncrementalSceneLoader::sort(const Ogre::Vector3& focus)
+{
+    const BinarySceneLoader& scene = m_template->getScene();
+
+    for (std::vector<WorkItem>::iterator itr = m_work.begin();
+         itr != m_work.end();
+         ++itr){
+        const uint32_t node = (itr->light) ?
+            scene.getLight(itr->index).node :
+            scene.getEntity(itr->index).node;
+        itr->distance =
+            m_nodes[node]->_getDerivedPosition().squaredDistance(focus);
+    }
+
+    // Farthest first, so the nearest item is popped from the back.
+    std::sort(m_work.begin(), m_work.end(),
+              [](const WorkItem& a, const WorkItem& b){
+        return a.distance > b.distance;
+    });
+
+    m_focus = focus;
+    m_sorted = true;
+}
+
+// ========================================================================= //
+
+void IncrementalSceneLoader::create(const WorkItem& item)
+{
+    const BinarySceneLoader& scene = m_template->getScene();
+
+    if (item.light){
+        scene.createLight(item.index, m_nodes, m_sceneMgr);
+        return;
+    }
+
+    // Templates built without meshes load them by name instead.
+    const std::vector<Ogre::MeshPtr>& meshes = m_template->getMeshes();
+    const Ogre::MeshPtr* mesh = (item.index < meshes.size()) ?
+        &meshes[item.index] : nullptr;
+
+    Ogre::Entity* entity = scene.createEntity(item.index,
+                                              m_nodes,
+                                              m_sceneMgr,
+                                              m_template->getGroup(),
+                                              mesh);
+    if (entity != nullptr && m_entityCallback){
+        m_entityCallback(entity,
+                         m_nodes[scene.getEntity(item.index).node]);
+    }
+}
+
+// ========================================================================= //
\ No newline at end of file
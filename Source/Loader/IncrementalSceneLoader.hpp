@@ -0,0 +1,173 @@
+// ========================================================================= //
+// Talos - A 3D game engine with network multiplayer.
+// Copyright(C) 2015 Jordan Sparks <unixunited@live.com>
+//
+// This program is free software; you can redistribute it and / or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 3
+// of the License, or(at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+// ========================================================================= //
+// File: IncrementalSceneLoader.hpp
+// Author: Jordan Sparks <unixunited@live.com>
+// ========================================================================= //
+// Defines IncrementalSceneLoader class.
+// ========================================================================= //
+
+#ifndef __INCREMENTALSCENELOADER_HPP__
+#define __INCREMENTALSCENELOADER_HPP__
+
+// ========================================================================= //
+
+#include "stdafx.hpp"
+
+#include "SceneTemplateCache.hpp"
+
+#include <functional>
+
+// ========================================================================= //
+// Instantiates a scene template over several ticks. Scene nodes are created
+// up front, since they are cheap and may be looked up by name while the
+// owning Entity is set up. Entities and lights form a work list which is
+// processed nearest the focus point first, within a per-call time budget.
+class IncrementalSceneLoader final
+{
+public:
+    // Receives each entity as it is created, with the node it is attached to.
+    typedef std::function<void(Ogre::Entity*, Ogre::SceneNode*)>
+        EntityCallback;
+
+    // Stores the template and where to instantiate it.
+    explicit IncrementalSceneLoader(
+        SceneTemplateCache::SceneTemplatePtr sceneTemplate,
+        Ogre::SceneManager* sceneMgr,
+        Ogre::SceneNode* attachNode,
+        const std::string& prependNode);
+
+    // Empty destructor.
+    ~IncrementalSceneLoader(void);
+
+    // Creates the scene nodes and builds the work list.
+    void start(void);
+
+    // Creates work items until budget milliseconds are spent, always at
+    // least one. The work list is re-ordered when focus has moved. Returns
+    // true once finished or cancelled.
+    bool update(const Ogre::Real budget, const Ogre::Vector3& focus);
+
+    // Creates every remaining item within radius of focus now, regardless
+    // of budget, e.g. the ground under a spawn point.
+    void createWithin(const Ogre::Vector3& focus, const Ogre::Real radius);
+
+    // Stops loading. Items already created stay in the scene.
+    void cancel(void);
+
+    // Getters:
+
+    // Returns the scene file name.
+    const std::string& getName(void) const;
+
+    // Returns fraction of work items created, in [0, 1].
+    const Ogre::Real getProgress(void) const;
+
+    // Returns number of work items.
+    const size_t getTotal(void) const;
+
+    // Returns number of work items not yet created.
+    const size_t getRemaining(void) const;
+
+    // Returns total time spent creating items in milliseconds.
+    const Ogre::Real getTimeSpent(void) const;
+
+    // Returns true if every item has been created or loading was cancelled.
+    const bool isFinished(void) const;
+
+    // Returns true if loading was cancelled.
+    const bool isCancelled(void) const;
+
+    // Setters:
+
+    // Sets function called for each entity created.
+    void setEntityCallback(const EntityCallback& callback);
+
+private:
+    struct WorkItem{
+        uint32_t index;
+        bool light;
+        Ogre::Real distance;
+    };
+
+    // Orders remaining work so the item nearest focus is at the back.
+    void sort(const Ogre::Vector3& focus);
+
+    // Creates one work item.
+    void create(const WorkItem& item);
+
+    SceneTemplateCache::SceneTemplatePtr m_template;
+    Ogre::SceneManager* m_sceneMgr;
+    Ogre::SceneNode* m_attachNode;
+    std::string m_prependNode;
+    std::vector<Ogre::SceneNode*> m_nodes;
+    std::vector<WorkItem> m_work;
+    size_t m_total;
+    Ogre::Vector3 m_focus;
+    bool m_sorted;
+    bool m_started;
+    bool m_cancelled;
+    EntityCallback m_entityCallback;
+    Ogre::Timer m_timer;
+    Ogre::Real m_timeSpent;
+};
+
+// ========================================================================= //
+
+// Getters:
+
+inline const std::string& IncrementalSceneLoader::getName(void) const{
+    return m_template->getName();
+}
+
+inline const Ogre::Real IncrementalSceneLoader::getProgress(void) const{
+    return (m_total == 0) ? 1.f :
+        static_cast<Ogre::Real>(m_total - m_work.size()) / m_total;
+}
+
+inline const size_t IncrementalSceneLoader::getTotal(void) const{
+    return m_total;
+}
+
+inline const size_t IncrementalSceneLoader::getRemaining(void) const{
+    return m_work.size();
+}
+
+inline const Ogre::Real IncrementalSceneLoader::getTimeSpent(void) const{
+    return m_timeSpent;
+}
+
+inline const bool IncrementalSceneLoader::isFinished(void) const{
+    return m_cancelled || (m_started && m_work.empty());
+}
+
+inline const bool IncrementalSceneLoader::isCancelled(void) const{
+    return m_cancelled;
+}
+
+// Setters:
+
+inline void IncrementalSceneLoader::setEntityCallback(
+    const EntityCallback& callback){
+    m_entityCallback = callback;
+}
+
+// ========================================================================= //
+
+#endif
+
+// ========================================================================= //
\ No newline at end of file
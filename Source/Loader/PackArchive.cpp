@@ -0,0 +1,382 @@
+// ========================================================================= //
+// Talos - A 3D game engine with network multiplayer.
+// Copyright(C) 2015 Jordan Sparks <unixunited@live.com>
+//
+// This program is free software; you can redistribute it and / or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 3
+// of the License, or(at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+// ========================================================================= //
+// File: PackArchive.cpp
+// Author: Jordan Sparks <unixunited@live.com>
+// ========================================================================= //
+// Implements PackArchive and PackArchiveFactory classes.
+// ========================================================================= //
+
+#include "PackArchive.hpp"
+
+#include <sys/stat.h>
+
+#ifdef WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+// ========================================================================= //
+
+static const Ogre::String SType = "Pack";
+
+// ========================================================================= //
+
+PackArchive::PackArchive(const Ogre::String& name, const Ogre::String& type) :
+Ogre::Archive(name, type),
+m_data(nullptr),
+m_size(0),
+m_header(nullptr),
+m_entries(nullptr),
+m_strings(nullptr),
+m_modifiedTime(0)
+{
+
+}
+
+// ========================================================================= //
+
+PackArchive::~PackArchive(void)
+{
+    this->unload();
+}
+
+// ========================================================================= //
+
+bool PackArchive::isCaseSensitive(void) const
+{
+    return false;
+}
+
+// ========================================================================= //
+
+void PackArchive::load(void)
+{
+    if (m_data != nullptr){
+        return;
+    }
+
+#ifdef WIN32
+    HANDLE file = CreateFileA(mName.c_str(),
+                              GENERIC_READ,
+                              FILE_SHARE_READ,
+                              nullptr,
+                              OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+                              nullptr);
+    LARGE_INTEGER size;
+    size.QuadPart = 0;
+    if (file != INVALID_HANDLE_VALUE){
+        GetFileSizeEx(file, &size);
+
+        HANDLE mapping = (size.QuadPart > 0) ? 
+            CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr) :
+            nullptr;
+        // The view keeps the mapping and file alive.
+        CloseHandle(file);
+        if (mapping != nullptr){
+            m_data = static_cast<const char*>(
+                MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+            CloseHandle(mapping);
+        }
+    }
+    m_size = static_cast<size_t>(size.QuadPart);
+#else
+    const int fd = ::open(mName.c_str(), O_RDONLY);
+    struct stat st;
+    if (fd != -1 && fstat(fd, &st) == 0 && st.st_size > 0){
+        void* view = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (view != MAP_FAILED){
+            m_data = static_cast<const char*>(view);
+            m_size = static_cast<size_t>(st.st_size);
+
+            // Read the file ahead in large sequential chunks rather than 
+            // faulting in pages as entries are opened.
+            madvise(view, m_size, MADV_WILLNEED);
+        }
+    }
+    if (fd != -1){
+        ::close(fd);
+    }
+#endif
+
+    if (m_data == nullptr){
+        OGRE_EXCEPT(Ogre::Exception::ERR_FILE_NOT_FOUND,
+                    "Cannot map pack archive " + mName,
+                    "PackArchive::load");
+    }
+
+    // Validate everything open() relies on up front.
+    m_header = reinterpret_cast<const PackFile::Header*>(m_data);
+    bool valid = (m_size >= sizeof(PackFile::Header) &&
+                  m_header->magic == PackFile::Magic &&
+                  m_header->version == PackFile::Version);
+    if (valid){
+        const uint64_t indexEnd = sizeof(PackFile::Header) +
+            static_cast<uint64_t>(m_header->entryCount) * 
+            sizeof(PackFile::Entry);
+        valid = (indexEnd <= m_header->stringsOffset &&
+                 m_header->stringsSize > 0 &&
+                 m_header->stringsOffset + m_header->stringsSize <= m_size &&
+                 m_data[m_header->stringsOffset + 
+                        m_header->stringsSize - 1] == '\0');
+    }
+    if (valid){
+        m_entries = reinterpret_cast<const PackFile::Entry*>(
+            m_data + sizeof(PackFile::Header));
+        m_strings = m_data + m_header->stringsOffset;
+        for (uint32_t i = 0; i < m_header->entryCount && valid; ++i){
+            const PackFile::Entry& entry = m_entries[i];
+            valid = (entry.name < m_header->stringsSize &&
+                     entry.offset + entry.storedSize <= m_size &&
+                     ((entry.flags & PackFile::Compressed) != 0 ||
+                      entry.storedSize == entry.size));
+        }
+    }
+    if (valid == false){
+        this->unload();
+        OGRE_EXCEPT(Ogre::Exception::ERR_INVALIDPARAMS,
+                    mName + " is not a valid pack archive",
+                    "PackArchive::load");
+    }
+
+    struct stat info;
+    if (stat(mName.c_str(), &info) == 0){
+        m_modifiedTime = info.st_mtime;
+    }
+}
+
+// ========================================================================= //
+
+void PackArchive::unload(void)
+{
+    if (m_data != nullptr){
+#ifdef WIN32
+        UnmapViewOfFile(m_data);
+#else
+        munmap(const_cast<char*>(m_data), m_size);
+#endif
+    }
+
+    m_data = nullptr;
+    m_size = 0;
+    m_header = nullptr;
+    m_entries = nullptr;
+    m_strings = nullptr;
+}
+
+// ========================================================================= //
+
+Ogre::DataStreamPtr PackArchive::open(const Ogre::String& filename,
+                                      bool readOnly) const
+{
+    const PackFile::Entry* entry = this->findEntry(filename);
+    if (entry == nullptr){
+        OGRE_EXCEPT(Ogre::Exception::ERR_FILE_NOT_FOUND,
+                    "Cannot find " + filename + " in " + mName,
+                    "PackArchive::open");
+    }
+
+    const char* stored = m_data + entry->offset;
+    const size_t size = static_cast<size_t>(entry->size);
+
+    if ((entry->flags & PackFile::Compressed) == 0){
+        // Read straight from the mapping, which outlives the stream.
+        return Ogre::DataStreamPtr(OGRE_NEW Ogre::MemoryDataStream(
+            filename, const_cast<char*>(stored), size, false, true));
+    }
+
+    Ogre::uchar* buffer = OGRE_ALLOC_T(Ogre::uchar, size, 
+                                       Ogre::MEMCATEGORY_GENERAL);
+    if (PackFile::decompress(stored, 
+                             static_cast<size_t>(entry->storedSize),
+                             reinterpret_cast<char*>(buffer),
+                             size) == false){
+        OGRE_FREE(buffer, Ogre::MEMCATEGORY_GENERAL);
+        OGRE_EXCEPT(Ogre::Exception::ERR_INVALID_STATE,
+                    filename + " in " + mName + " is corrupt",
+                    "PackArchive::open");
+    }
+
+    return Ogre::DataStreamPtr(OGRE_NEW Ogre::MemoryDataStream(
+        filename, buffer, size, true, readOnly));
+}
+
+// ========================================================================= //
+
+Ogre::StringVectorPtr PackArchive::list(bool recursive, bool dirs)
+{
+    return this->find("*", recursive, dirs);
+}
+
+// ========================================================================= //
+
+Ogre::FileInfoListPtr PackArchive::listFileInfo(bool recursive, bool dirs)
+{
+    return this->findFileInfo("*", recursive, dirs);
+}
+
+// ========================================================================= //
+
+Ogre::StringVectorPtr PackArchive::find(const Ogre::String& pattern,
+                                        bool recursive,
+                                        bool dirs)
+{
+    Ogre::StringVectorPtr names(OGRE_NEW_T(Ogre::StringVector, 
+                                           Ogre::MEMCATEGORY_GENERAL)(),
+                                Ogre::SPFM_DELETE_T);
+
+    Ogre::FileInfoListPtr infos = this->findFileInfo(pattern, recursive, dirs);
+    names->reserve(infos->size());
+    for (Ogre::FileInfoList::const_iterator itr = infos->begin();
+         itr != infos->end();
+         ++itr){
+        names->push_back(itr->filename);
+    }
+
+    return names;
+}
+
+// ========================================================================= //
+
+Ogre::FileInfoListPtr PackArchive::findFileInfo(const Ogre::String& pattern,
+                                                bool recursive,
+                                                bool dirs) const
+{
+    Ogre::FileInfoListPtr infos(OGRE_NEW_T(Ogre::FileInfoList,
+                                           Ogre::MEMCATEGORY_GENERAL)(),
+                                Ogre::SPFM_DELETE_T);
+
+    // The archive only holds files.
+    if (dirs == true || m_data == nullptr){
+        return infos;
+    }
+
+    // Patterns with a path match the whole name, as in a Zip archive.
+    const bool fullMatch = (pattern.find_first_of("/\\") != 
+                            Ogre::String::npos);
+    for (uint32_t i = 0; i < m_header->entryCount; ++i){
+        Ogre::FileInfo info;
+        this->getFileInfo(m_entries[i], info);
+        if ((recursive || fullMatch || info.path.empty()) &&
+            Ogre::StringUtil::match(fullMatch ? info.filename : info.basename,
+                                    pattern,
+                                    false)){
+            infos->push_back(info);
+        }
+    }
+
+    return infos;
+}
+
+// ========================================================================= //
+
+bool PackArchive::exists(const Ogre::String& filename)
+{
+    return (this->findEntry(filename) != nullptr);
+}
+
+// ========================================================================= //
+
+time_t PackArchive::getModifiedTime(const Ogre::String& filename)
+{
+    return m_modifiedTime;
+}
+
+// ========================================================================= //
+
+const PackFile::Entry* PackArchive::findEntry(
+    const Ogre::String& filename) const
+{
+    if (m_data == nullptr){
+        return nullptr;
+    }
+
+    // Binary search of the sorted index.
+    uint32_t first = 0;
+    uint32_t last = m_header->entryCount;
+    while (first < last){
+        const uint32_t middle = first + (last - first) / 2;
+        const int order = PackFile::compareNames(
+            this->getName(m_entries[middle]), filename.c_str());
+        if (order == 0){
+            return &m_entries[middle];
+        }
+        else if (order < 0){
+            first = middle + 1;
+        }
+        else{
+            last = middle;
+        }
+    }
+
+    return nullptr;
+}
+
+// ========================================================================= //
+
+const char* PackArchive::getName(const PackFile::Entry& entry) const
+{
+    return m_strings + entry.name;
+}
+
+// ========================================================================= //
+
+void PackArchive::getFileInfo(const PackFile::Entry& entry, 
+                              Ogre::FileInfo& info) const
+{
+    info.archive = this;
+    info.filename = this->getName(entry);
+    const size_t slash = info.filename.find_last_of('/');
+    if (slash == Ogre::String::npos){
+        info.basename = info.filename;
+    }
+    else{
+        info.path = info.filename.substr(0, slash + 1);
+        info.basename = info.filename.substr(slash + 1);
+    }
+    info.compressedSize = static_cast<size_t>(entry.storedSize);
+    info.uncompressedSize = static_cast<size_t>(entry.size);
+}
+
+// ========================================================================= //
+
+const Ogre::String& PackArchiveFactory::getType(void) const
+{
+    return SType;
+}
+
+// ========================================================================= //
+
+Ogre::Archive* PackArchiveFactory::createInstance(const Ogre::String& name,
+                                                  bool readOnly)
+{
+    return OGRE_NEW PackArchive(name, SType);
+}
+
+// ========================================================================= //
+
+void PackArchiveFactory::destroyInstance(Ogre::Archive* archive)
+{
+    OGRE_DELETE archive;
+}
+
+// ========================================================================= //
\ No newline at end of file
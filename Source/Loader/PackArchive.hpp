@@ -0,0 +1,116 @@
+// ========================================================================= //
+// Talos - A 3D game engine with network multiplayer.
+// Copyright(C) 2015 Jordan Sparks <unixunited@live.com>
+//
+// This program is free software; you can redistribute it and / or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 3
+// of the License, or(at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+// ========================================================================= //
+// File: PackArchive.hpp
+// Author: Jordan Sparks <unixunited@live.com>
+// ========================================================================= //
+// Defines PackArchive and PackArchiveFactory classes.
+// ========================================================================= //
+
+#ifndef __PACKARCHIVE_HPP__
+#define __PACKARCHIVE_HPP__
+
+// ========================================================================= //
+
+#include "stdafx.hpp"
+
+#include "PackFile.hpp"
+
+// ========================================================================= //
+// Ogre archive reading a .pak file built by PackBuilder. The whole file is 
+// memory mapped on load, so a resource location costs one open and the 
+// index is searched in memory. Stored entries are served straight from the 
+// mapping; compressed entries are decompressed into a new buffer. Names are
+// matched case-insensitively, like the Windows file system.
+class PackArchive : public Ogre::Archive
+{
+public:
+    explicit PackArchive(const Ogre::String& name, 
+                         const Ogre::String& type);
+
+    // Unmaps the file.
+    virtual ~PackArchive(void) override;
+
+    virtual bool isCaseSensitive(void) const override;
+
+    // Maps the file and validates the header and index.
+    virtual void load(void) override;
+
+    virtual void unload(void) override;
+
+    virtual Ogre::DataStreamPtr open(const Ogre::String& filename,
+                                     bool readOnly = true) const override;
+
+    virtual Ogre::StringVectorPtr list(bool recursive = true, 
+                                      bool dirs = false) override;
+
+    virtual Ogre::FileInfoListPtr listFileInfo(bool recursive = true,
+                                              bool dirs = false) override;
+
+    virtual Ogre::StringVectorPtr find(const Ogre::String& pattern,
+                                      bool recursive = true,
+                                      bool dirs = false) override;
+
+    virtual Ogre::FileInfoListPtr findFileInfo(const Ogre::String& pattern,
+                                              bool recursive = true,
+                                              bool dirs = false) const override;
+
+    virtual bool exists(const Ogre::String& filename) override;
+
+    virtual time_t getModifiedTime(const Ogre::String& filename) override;
+
+private:
+    // Returns the entry named filename, or nullptr.
+    const PackFile::Entry* findEntry(const Ogre::String& filename) const;
+
+    // Returns an entry's name from the string pool.
+    const char* getName(const PackFile::Entry& entry) const;
+
+    // Fills FileInfo for an entry.
+    void getFileInfo(const PackFile::Entry& entry, Ogre::FileInfo& info) const;
+
+    const char* m_data;
+    size_t m_size;
+    const PackFile::Header* m_header;
+    const PackFile::Entry* m_entries;
+    const char* m_strings;
+    time_t m_modifiedTime;
+};
+
+// ========================================================================= //
+// Registers PackArchive with Ogre under the type "Pack", e.g. 
+// "Pack=Data/Materials.pak" in resources.cfg.
+class PackArchiveFactory : public Ogre::ArchiveFactory
+{
+public:
+    virtual ~PackArchiveFactory(void) override { }
+
+    using Ogre::ArchiveFactory::createInstance;
+
+    virtual const Ogre::String& getType(void) const override;
+
+    virtual Ogre::Archive* createInstance(const Ogre::String& name,
+                                          bool readOnly) override;
+
+    virtual void destroyInstance(Ogre::Archive* archive) override;
+};
+
+// ========================================================================= //
+
+#endif
+
+// ========================================================================= //
\ No newline at end of file
@@ -0,0 +1,249 @@
+// ========================================================================= //
+// Talos - A 3D game engine with network multiplayer.
+// Copyright(C) 2015 Jordan Sparks <unixunited@live.com>
+//
+// This program is free software; you can redistribute it and / or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 3
+// of the License, or(at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+// ========================================================================= //
+// File: PackBuilder.cpp
+// Author: Jordan Sparks <unixunited@live.com>
+// ========================================================================= //
+// Implements PackBuilder class.
+// ========================================================================= //
+
+#include "PackBuilder.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#include <OgreFileSystem.h>
+
+// ========================================================================= //
+
+// Formats kept uncompressed: already compressed, or read in place.
+static const char* SStoredExtensions[] = {
+    "dds", "png", "jpg", "jpeg", "tga",
+    "ogg", "mp3", "wav",
+    "bscene", "zip", "pak"
+};
+
+// Compressed entries must save at least 1/SMinSavings of their size.
+static const size_t SMinSavings = 8;
+
+// ========================================================================= //
+
+PackBuilder::PackBuilder(void) :
+m_files(),
+m_skippedDirs(),
+m_error(),
+m_compressed(0),
+m_size(0),
+m_packedSize(0)
+{
+
+}
+
+// ========================================================================= //
+
+PackBuilder::~PackBuilder(void)
+{
+
+}
+
+// ========================================================================= //
+
+bool PackBuilder::build(const std::string& dir, const std::string& outPath)
+{
+    m_files.clear();
+    m_skippedDirs.clear();
+    m_error.clear();
+    m_compressed = 0;
+    m_size = 0;
+    m_packedSize = 0;
+
+    Ogre::FileSystemArchive archive(dir, "FileSystem", true);
+    archive.load();
+
+    // Top level only: a "Pack=" location is searched like a non-recursive
+    // "FileSystem=" one, so entries in subdirectories could never be found.
+    Ogre::StringVectorPtr names = archive.list(false);
+    for (Ogre::StringVector::const_iterator itr = names->begin();
+         itr != names->end();
+         ++itr){
+        if (this->addFile(archive, *itr) == false){
+            return false;
+        }
+    }
+
+    Ogre::StringVectorPtr dirs = archive.list(false, true);
+    m_skippedDirs.assign(dirs->begin(), dirs->end());
+
+    if (m_files.empty() == true){
+        m_error = "No files found in " + dir;
+        return false;
+    }
+
+    return this->write(outPath);
+}
+
+// ========================================================================= //
+
+bool PackBuilder::shouldCompress(const std::string& name)
+{
+    Ogre::String base, extension;
+    Ogre::StringUtil::splitBaseFilename(name, base, extension);
+    Ogre::StringUtil::toLowerCase(extension);
+
+    for (size_t i = 0; 
+         i < sizeof(SStoredExtensions) / sizeof(SStoredExtensions[0]); 
+         ++i){
+        if (extension == SStoredExtensions[i]){
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// ========================================================================= //
+
+bool PackBuilder::addFile(Ogre::Archive& archive, const std::string& name)
+{
+    Ogre::DataStreamPtr stream = archive.open(name);
+    if (stream.isNull() == true){
+        m_error = "Unable to open " + name;
+        return false;
+    }
+
+    File file;
+    file.name = name;
+    std::replace(file.name.begin(), file.name.end(), '\\', '/');
+    std::memset(&file.entry, 0, sizeof(file.entry));
+    file.entry.size = stream->size();
+    file.data.resize(static_cast<size_t>(file.entry.size));
+    if (file.data.empty() == false &&
+        stream->read(&file.data[0], file.data.size()) != file.data.size()){
+        m_error = "Failed reading " + name;
+        return false;
+    }
+    m_size += file.entry.size;
+
+    if (file.data.empty() == false && shouldCompress(file.name)){
+        std::vector<char> compressed(
+            PackFile::compressBound(file.data.size()));
+        const size_t size = PackFile::compress(&file.data[0],
+                                               file.data.size(),
+                                               &compressed[0]);
+        if (size < file.data.size() - file.data.size() / SMinSavings){
+            compressed.resize(size);
+            file.data.swap(compressed);
+            file.entry.flags |= PackFile::Compressed;
+            ++m_compressed;
+        }
+    }
+    file.entry.storedSize = file.data.size();
+
+    m_files.push_back(file);
+    return true;
+}
+
+// ========================================================================= //
+
+bool PackBuilder::write(const std::string& outPath)
+{
+    std::sort(m_files.begin(), m_files.end(),
+              [](const File& a, const File& b){
+        return PackFile::compareNames(a.name.c_str(), b.name.c_str()) < 0;
+    });
+
+    // Duplicates would differ only in case, which PackArchive can't tell
+    // apart.
+    for (size_t i = 1; i < m_files.size(); ++i){
+        if (PackFile::compareNames(m_files[i - 1].name.c_str(),
+                                   m_files[i].name.c_str()) == 0){
+            m_error = m_files[i - 1].name + " and " + m_files[i].name +
+                " differ only in case";
+            return false;
+        }
+    }
+
+    std::vector<char> strings;
+    for (std::vector<File>::iterator itr = m_files.begin();
+         itr != m_files.end();
+         ++itr){
+        itr->entry.name = static_cast<uint32_t>(strings.size());
+        strings.insert(strings.end(), itr->name.begin(), itr->name.end());
+        strings.push_back('\0');
+    }
+
+    PackFile::Header header;
+    std::memset(&header, 0, sizeof(header));
+    header.magic = PackFile::Magic;
+    header.version = PackFile::Version;
+    header.entryCount = static_cast<uint32_t>(m_files.size());
+    header.stringsSize = static_cast<uint32_t>(strings.size());
+    header.stringsOffset = sizeof(PackFile::Header) +
+        m_files.size() * sizeof(PackFile::Entry);
+
+    // Data follows the names, each blob aligned; small files sit together in
+    // index order so related files share reads.
+    const uint64_t align = PackFile::DataAlignment;
+    uint64_t offset = (header.stringsOffset + strings.size() + align - 1) &
+        ~(align - 1);
+    header.dataOffset = offset;
+    for (std::vector<File>::iterator itr = m_files.begin();
+         itr != m_files.end();
+         ++itr){
+        itr->entry.offset = offset;
+        offset = (offset + itr->entry.storedSize + align - 1) & ~(align - 1);
+    }
+
+    std::ofstream out(outPath.c_str(), std::ios::binary | std::ios::trunc);
+    if (out.is_open() == false){
+        m_error = "Unable to write " + outPath;
+        return false;
+    }
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    for (std::vector<File>::const_iterator itr = m_files.begin();
+         itr != m_files.end();
+         ++itr){
+        out.write(reinterpret_cast<const char*>(&itr->entry),
+                  sizeof(itr->entry));
+    }
+    out.write(&strings[0], strings.size());
+
+    const char padding[PackFile::DataAlignment] = { 0 };
+    uint64_t position = header.stringsOffset + strings.size();
+    for (std::vector<File>::const_iterator itr = m_files.begin();
+         itr != m_files.end();
+         ++itr){
+        out.write(padding, static_cast<std::streamsize>(
+            itr->entry.offset - position));
+        if (itr->data.empty() == false){
+            out.write(&itr->data[0], itr->data.size());
+        }
+        position = itr->entry.offset + itr->entry.storedSize;
+    }
+
+    if (out.good() == false){
+        m_error = "Failed writing " + outPath;
+        return false;
+    }
+    m_packedSize = position;
+
+    return true;
+}
+
+// ========================================================================= //
\ No newline at end of file
@@ -0,0 +1,132 @@
+// ========================================================================= //
+// Talos - A 3D game engine with network multiplayer.
+// Copyright(C) 2015 Jordan Sparks <unixunited@live.com>
+//
+// This program is free software; you can redistribute it and / or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 3
+// of the License, or(at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+// ========================================================================= //
+// File: PackBuilder.hpp
+// Author: Jordan Sparks <unixunited@live.com>
+// ========================================================================= //
+// Defines PackBuilder class.
+// ========================================================================= //
+
+#ifndef __PACKBUILDER_HPP__
+#define __PACKBUILDER_HPP__
+
+// ========================================================================= //
+
+#include "stdafx.hpp"
+
+#include "PackFile.hpp"
+
+// ========================================================================= //
+// Offline tool packing a directory into a .pak archive for PackArchive. Only
+// the files directly in the directory are packed, as resources.cfg locations
+// are not searched recursively; subdirectories are skipped and reported so
+// they can be packed as their own locations.
+// Entries are LZ4 compressed unless their format is already compressed or
+// meant to be used in place (textures, audio, compiled scenes), or unless
+// compression saves too little.
+class PackBuilder final
+{
+public:
+    // Default initializes member data.
+    explicit PackBuilder(void);
+
+    // Empty destructor.
+    ~PackBuilder(void);
+
+    // Packs every file directly in dir into the archive at outPath. Returns
+    // false and sets the error string on failure.
+    bool build(const std::string& dir, const std::string& outPath);
+
+    // Returns true if files named name should be compressed.
+    static bool shouldCompress(const std::string& name);
+
+    // Getters:
+
+    // Returns description of the last failure.
+    const std::string& getError(void) const;
+
+    // Returns number of files packed by the last build.
+    const size_t getEntryCount(void) const;
+
+    // Returns number of those stored compressed.
+    const size_t getCompressedCount(void) const;
+
+    // Returns total size of the packed files.
+    const uint64_t getSize(void) const;
+
+    // Returns size of the written archive.
+    const uint64_t getPackedSize(void) const;
+
+    // Returns subdirectories of dir the last build did not pack.
+    const std::vector<std::string>& getSkippedDirs(void) const;
+
+private:
+    // A file read into memory, compressed if worthwhile.
+    struct File{
+        std::string name;
+        PackFile::Entry entry;
+        std::vector<char> data;
+    };
+
+    // Reads and (maybe) compresses a file.
+    bool addFile(Ogre::Archive& archive, const std::string& name);
+
+    // Lays out header, index, names and data and writes them to outPath.
+    bool write(const std::string& outPath);
+
+    std::vector<File> m_files;
+    std::vector<std::string> m_skippedDirs;
+    std::string m_error;
+    size_t m_compressed;
+    uint64_t m_size;
+    uint64_t m_packedSize;
+};
+
+// ========================================================================= //
+
+// Getters:
+
+inline const std::string& PackBuilder::getError(void) const{
+    return m_error;
+}
+
+inline const size_t PackBuilder::getEntryCount(void) const{
+    return m_files.size();
+}
+
+inline const size_t PackBuilder::getCompressedCount(void) const{
+    return m_compressed;
+}
+
+inline const uint64_t PackBuilder::getSize(void) const{
+    return m_size;
+}
+
+inline const uint64_t PackBuilder::getPackedSize(void) const{
+    return m_packedSize;
+}
+
+inline const std::vector<std::string>& 
+PackBuilder::getSkippedDirs(void) const{
+    return m_skippedDirs;
+}
+
+// ========================================================================= //
+
+#endif
+
+// ========================================================================= //
\ No newline at end of file
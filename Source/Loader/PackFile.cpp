@@ -0,0 +1,227 @@
+// ========================================================================= //
+// Talos - A 3D game engine with network multiplayer.
+// Copyright(C) 2015 Jordan Sparks <unixunited@live.com>
+//
+// This program is free software; you can redistribute it and / or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 3
+// of the License, or(at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+// ========================================================================= //
+// File: PackFile.cpp
+// Author: Jordan Sparks <unixunited@live.com>
+// ========================================================================= //
+// Implements the LZ4 block codec used by packed resource archives.
+// ========================================================================= //
+
+#include "PackFile.hpp"
+
+#include <cstring>
+#include <vector>
+
+// ========================================================================= //
+
+namespace PackFile
+{;
+
+// ========================================================================= //
+
+// Block format limits: a match needs 4 bytes, the last match starts at least
+// 12 bytes before the end and the last 5 bytes are always literals.
+static const size_t SMinMatch = 4;
+static const size_t SMatchStartLimit = 12;
+static const size_t SLastLiterals = 5;
+static const size_t SMaxOffset = 65535;
+
+static const uint32_t SHashBits = 12;
+
+// ========================================================================= //
+
+static uint32_t SRead32(const char* p)
+{
+    uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+// ========================================================================= //
+
+static uint32_t SHash(const uint32_t v)
+{
+    return (v * 2654435761U) >> (32 - SHashBits);
+}
+
+// ========================================================================= //
+
+// Writes the remainder of a length over 15 as a run of 255s.
+static char* SWriteLength(char* op, size_t length)
+{
+    for (; length >= 255; length -= 255){
+        *op++ = static_cast<char>(255);
+    }
+    *op++ = static_cast<char>(length);
+    return op;
+}
+
+// ========================================================================= //
+
+// Writes literals and, if matchLength is non-zero, a match.
+static char* SWriteSequence(char* op, 
+                            const char* literals, 
+                            const size_t literalLength,
+                            const size_t offset,
+                            const size_t matchLength)
+{
+    char* token = op++;
+    const size_t ml = (matchLength != 0) ? matchLength - SMinMatch : 0;
+    *token = static_cast<char>(
+        ((literalLength >= 15) ? 15 : literalLength) << 4 |
+        ((ml >= 15) ? 15 : ml));
+
+    if (literalLength >= 15){
+        op = SWriteLength(op, literalLength - 15);
+    }
+    std::memcpy(op, literals, literalLength);
+    op += literalLength;
+
+    if (matchLength != 0){
+        *op++ = static_cast<char>(offset & 0xFF);
+        *op++ = static_cast<char>(offset >> 8);
+        if (ml >= 15){
+            op = SWriteLength(op, ml - 15);
+        }
+    }
+
+    return op;
+}
+
+// ========================================================================= //
+
+size_t compress(const char* src, const size_t n, char* dst)
+{
+    char* op = dst;
+    size_t anchor = 0;
+
+    if (n > SMatchStartLimit){
+        // Last position seen for each hashed 4-byte sequence.
+        std::vector<int32_t> table(1 << SHashBits, -1);
+
+        const size_t matchStartEnd = n - SMatchStartLimit;
+        const size_t matchEnd = n - SLastLiterals;
+        size_t i = 0;
+        while (i < matchStartEnd){
+            const uint32_t seq = SRead32(src + i);
+            const uint32_t h = SHash(seq);
+            const int32_t ref = table[h];
+            table[h] = static_cast<int32_t>(i);
+
+            if (ref < 0 || i - ref > SMaxOffset || SRead32(src + ref) != seq){
+                ++i;
+                continue;
+            }
+
+            size_t length = SMinMatch;
+            while (i + length < matchEnd && 
+                   src[ref + length] == src[i + length]){
+                ++length;
+            }
+
+            op = SWriteSequence(op, src + anchor, i - anchor, i - ref, length);
+            i += length;
+            anchor = i;
+        }
+    }
+
+    // The block always ends with literals.
+    op = SWriteSequence(op, src + anchor, n - anchor, 0, 0);
+
+    return static_cast<size_t>(op - dst);
+}
+
+// ========================================================================= //
+
+bool decompress(const char* src, const size_t n, 
+                char* dst, const size_t size)
+{
+    const unsigned char* ip = reinterpret_cast<const unsigned char*>(src);
+    const unsigned char* const iend = ip + n;
+    char* op = dst;
+    char* const oend = dst + size;
+
+    while (ip < iend){
+        const unsigned int token = *ip++;
+
+        // Literals.
+        size_t length = token >> 4;
+        if (length == 15){
+            unsigned int b = 255;
+            while (b == 255){
+                if (ip >= iend){
+                    return false;
+                }
+                b = *ip++;
+                length += b;
+            }
+        }
+        if (length > static_cast<size_t>(iend - ip) || 
+            length > static_cast<size_t>(oend - op)){
+            return false;
+        }
+        std::memcpy(op, ip, length);
+        ip += length;
+        op += length;
+
+        // The last sequence has no match.
+        if (ip == iend){
+            break;
+        }
+
+        // Match.
+        if (iend - ip < 2){
+            return false;
+        }
+        const size_t offset = ip[0] | (ip[1] << 8);
+        ip += 2;
+        if (offset == 0 || offset > static_cast<size_t>(op - dst)){
+            return false;
+        }
+
+        length = token & 15;
+        if (length == 15){
+            unsigned int b = 255;
+            while (b == 255){
+                if (ip >= iend){
+                    return false;
+                }
+                b = *ip++;
+                length += b;
+            }
+        }
+        length += SMinMatch;
+        if (length > static_cast<size_t>(oend - op)){
+            return false;
+        }
+
+        // Matches may overlap their output, so copy forwards bytewise.
+        const char* match = op - offset;
+        for (size_t i = 0; i < length; ++i){
+            op[i] = match[i];
+        }
+        op += length;
+    }
+
+    return (op == oend);
+}
+
+// ========================================================================= //
+
+}
+
+// ========================================================================= //
\ No newline at end of file
@@ -0,0 +1,115 @@
+// ========================================================================= //
+// Talos - A 3D game engine with network multiplayer.
+// Copyright(C) 2015 Jordan Sparks <unixunited@live.com>
+//
+// This program is free software; you can redistribute it and / or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 3
+// of the License, or(at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+// ========================================================================= //
+// File: PackFile.hpp
+// Author: Jordan Sparks <unixunited@live.com>
+// ========================================================================= //
+// Defines the packed resource archive layout and its LZ4 block codec.
+// ========================================================================= //
+
+#ifndef __PACKFILE_HPP__
+#define __PACKFILE_HPP__
+
+// ========================================================================= //
+
+#include <cstddef>
+#include <cstdint>
+
+// ========================================================================= //
+// Layout of a .pak archive, written offline by PackBuilder and read through 
+// PackArchive. The file is a Header, the Entry index sorted by lower-case 
+// name (for binary search), a pool of null-terminated names and then the 
+// entry data, each blob aligned to DataAlignment. Entries are either stored, 
+// so they can be used straight from the mapped file, or compressed in the 
+// LZ4 block format. Everything is little-endian.
+namespace PackFile
+{;
+
+// "TPAK".
+const uint32_t Magic = 0x4B415054;
+
+const uint32_t Version = 1;
+
+// Alignment of entry data within the file.
+const uint32_t DataAlignment = 16;
+
+// Entry flags.
+enum{
+    Compressed = 1 << 0
+};
+
+struct Header{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t entryCount;
+    uint32_t stringsSize;
+    // Offsets in bytes from the start of the file. The index follows the 
+    // header directly.
+    uint64_t stringsOffset;
+    uint64_t dataOffset;
+};
+
+struct Entry{
+    // Relative path using '/', offset into the string pool.
+    uint32_t name;
+    uint32_t flags;
+    uint64_t offset;
+    uint64_t size;
+    // Bytes stored in the archive; equals size unless compressed.
+    uint64_t storedSize;
+};
+
+// Orders names case-insensitively, treating '\\' as '/'. The index is 
+// sorted with this.
+inline int compareNames(const char* a, const char* b){
+    for (;; ++a, ++b){
+        char ca = (*a == '\\') ? '/' : *a;
+        char cb = (*b == '\\') ? '/' : *b;
+        if (ca >= 'A' && ca <= 'Z'){
+            ca += 'a' - 'A';
+        }
+        if (cb >= 'A' && cb <= 'Z'){
+            cb += 'a' - 'A';
+        }
+        if (ca != cb || ca == '\0'){
+            return static_cast<unsigned char>(ca) - 
+                static_cast<unsigned char>(cb);
+        }
+    }
+}
+
+// Returns the worst-case compressed size of n bytes.
+inline size_t compressBound(const size_t n){
+    return n + n / 255 + 16;
+}
+
+// Compresses n bytes from src into dst (of compressBound(n) bytes) as one 
+// LZ4 block. Returns the compressed size.
+size_t compress(const char* src, const size_t n, char* dst);
+
+// Decompresses an LZ4 block of n bytes into exactly size bytes at dst. 
+// Returns false on malformed input.
+bool decompress(const char* src, const size_t n, 
+                char* dst, const size_t size);
+
+}
+
+// ========================================================================= //
+
+#endif
+
+// ========================================================================= //
\ No newline at end of file
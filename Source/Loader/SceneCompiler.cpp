@@ -0,0 +1,428 @@
+// ========================================================================= //
+// Talos - A 3D game engine with network multiplayer.
+// Copyright(C) 2015 Jordan Sparks <unixunited@live.com>
+//
+// This program is free software; you can redistribute it and / or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 3
+// of the License, or(at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+// ========================================================================= //
+// File: SceneCompiler.cpp
+// Author: Jordan Sparks <unixunited@live.com>
+// ========================================================================= //
+// Implements SceneCompiler class.
+// ========================================================================= //
+
+#include "SceneCompiler.hpp"
+
+#include <cstring>
+#include <fstream>
+
+// ========================================================================= //
+
+SceneCompiler::SceneCompiler(void) :
+m_header(),
+m_nodes(),
+m_entities(),
+m_lights(),
+m_strings(),
+m_stringOffsets(),
+m_error(),
+m_skipped(0)
+{
+
+}
+
+// ========================================================================= //
+
+SceneCompiler::~SceneCompiler(void)
+{
+
+}
+
+// ========================================================================= //
+
+bool SceneCompiler::compile(const std::string& inPath,
+                            const std::string& outPath)
+{
+    std::ifstream in(inPath.c_str(), std::ios::binary);
+    if (in.is_open() == false){
+        m_error = "Unable to open " + inPath;
+        return false;
+    }
+    std::vector<char> text((std::istreambuf_iterator<char>(in)),
+                           std::istreambuf_iterator<char>());
+
+    std::vector<char> image;
+    if (this->compile(text, image, inPath) == false){
+        return false;
+    }
+
+    std::ofstream out(outPath.c_str(), std::ios::binary | std::ios::trunc);
+    if (out.is_open() == false){
+        m_error = "Unable to write " + outPath;
+        return false;
+    }
+
+    out.write(&image[0], image.size());
+    if (out.good() == false){
+        m_error = "Failed writing " + outPath;
+        return false;
+    }
+
+    return true;
+}
+
+// ========================================================================= //
+
+bool SceneCompiler::compile(std::vector<char>& text,
+                            std::vector<char>& image,
+                            const std::string& name)
+{
+    std::memset(&m_header, 0, sizeof(m_header));
+    m_nodes.clear();
+    m_entities.clear();
+    m_lights.clear();
+    m_strings.clear();
+    m_stringOffsets.clear();
+    m_error.clear();
+    m_skipped = 0;
+
+    // rapidxml parses in place and needs a null terminator.
+    text.push_back('\0');
+
+    rapidxml::xml_document<> XMLDoc;
+    try{
+        XMLDoc.parse<0>(&text[0]);
+    }
+    catch (rapidxml::parse_error& e){
+        m_error = name + ": " + e.what();
+        return false;
+    }
+
+    rapidxml::xml_node<>* XMLRoot = XMLDoc.first_node("scene");
+    if (XMLRoot == nullptr || getAttrib(XMLRoot, "formatVersion", "") == ""){
+        m_error = name + ": invalid .scene file, missing <scene>";
+        return false;
+    }
+
+    m_header.magic = SceneFile::Magic;
+    m_header.version = SceneFile::Version;
+
+    Ogre::Vector3 rootPosition = Ogre::Vector3::ZERO;
+    Ogre::Quaternion rootOrientation = Ogre::Quaternion::IDENTITY;
+    Ogre::Vector3 rootScale = Ogre::Vector3::UNIT_SCALE;
+
+    rapidxml::xml_node<>* XMLNodes = XMLRoot->first_node("nodes");
+    if (XMLNodes){
+        for (rapidxml::xml_node<>* pElement = XMLNodes->first_node("node");
+             pElement != nullptr;
+             pElement = pElement->next_sibling("node")){
+            this->compileNode(pElement, SceneFile::NoParent);
+        }
+
+        rapidxml::xml_node<>* pElement = XMLNodes->first_node("position");
+        if (pElement){
+            rootPosition = parseVector3(pElement);
+            m_header.flags |= SceneFile::RootPosition;
+        }
+
+        pElement = XMLNodes->first_node("rotation");
+        if (pElement){
+            rootOrientation = parseQuaternion(pElement);
+            m_header.flags |= SceneFile::RootOrientation;
+        }
+
+        pElement = XMLNodes->first_node("scale");
+        if (pElement){
+            rootScale = parseVector3(pElement);
+            m_header.flags |= SceneFile::RootScale;
+        }
+    }
+
+    std::memcpy(m_header.rootPosition, rootPosition.ptr(),
+                sizeof(m_header.rootPosition));
+    std::memcpy(m_header.rootOrientation, rootOrientation.ptr(),
+                sizeof(m_header.rootOrientation));
+    std::memcpy(m_header.rootScale, rootScale.ptr(),
+                sizeof(m_header.rootScale));
+
+    this->skip(XMLRoot, "environment");
+    this->skip(XMLRoot, "externals");
+    this->skip(XMLRoot, "octree");
+    this->skip(XMLRoot, "camera");
+
+    this->serialize(image);
+
+    return true;
+}
+
+// ========================================================================= //
+
+void SceneCompiler::compileNode(rapidxml::xml_node<>* XMLNode,
+                                const int32_t parent)
+{
+    const int32_t index = static_cast<int32_t>(m_nodes.size());
+
+    Ogre::Vector3 position = Ogre::Vector3::ZERO;
+    Ogre::Quaternion orientation = Ogre::Quaternion::IDENTITY;
+    Ogre::Vector3 scale = Ogre::Vector3::UNIT_SCALE;
+
+    rapidxml::xml_node<>* pElement = XMLNode->first_node("position");
+    if (pElement){
+        position = parseVector3(pElement);
+    }
+
+    pElement = XMLNode->first_node("rotation");
+    if (pElement){
+        orientation = parseQuaternion(pElement);
+    }
+
+    pElement = XMLNode->first_node("scale");
+    if (pElement){
+        scale = parseVector3(pElement);
+    }
+
+    SceneFile::Node node;
+    node.parent = parent;
+    node.name = this->addString(getAttrib(XMLNode, "name"));
+    node.userData = this->addUserData(XMLNode);
+    std::memcpy(node.position, position.ptr(), sizeof(node.position));
+    std::memcpy(node.orientation, orientation.ptr(),
+                sizeof(node.orientation));
+    std::memcpy(node.scale, scale.ptr(), sizeof(node.scale));
+    m_nodes.push_back(node);
+
+    // Children follow their parent, keeping parents first.
+    for (pElement = XMLNode->first_node("node");
+         pElement != nullptr;
+         pElement = pElement->next_sibling("node")){
+        this->compileNode(pElement, index);
+    }
+
+    for (pElement = XMLNode->first_node("entity");
+         pElement != nullptr;
+         pElement = pElement->next_sibling("entity")){
+        this->compileEntity(pElement, index);
+    }
+
+    for (pElement = XMLNode->first_node("light");
+         pElement != nullptr;
+         pElement = pElement->next_sibling("light")){
+        this->compileLight(pElement, index);
+    }
+
+    this->skip(XMLNode, "lookTarget");
+    this->skip(XMLNode, "trackTarget");
+    this->skip(XMLNode, "camera");
+    this->skip(XMLNode, "particleSystem");
+    this->skip(XMLNode, "billboardSet");
+    this->skip(XMLNode, "plane");
+}
+
+// ========================================================================= //
+
+void SceneCompiler::compileEntity(rapidxml::xml_node<>* XMLNode,
+                                  const uint32_t node)
+{
+    SceneFile::Entity entity;
+    entity.node = node;
+    entity.name = this->addString(getAttrib(XMLNode, "name"));
+    entity.mesh = this->addString(getAttrib(XMLNode, "meshFile"));
+    entity.material = this->addString(getAttrib(XMLNode, "materialFile"));
+    entity.userData = this->addUserData(XMLNode);
+    entity.flags = 0;
+    if (getAttribBool(XMLNode, "static", false)){
+        entity.flags |= SceneFile::EntityStatic;
+    }
+    if (getAttribBool(XMLNode, "castShadows", true)){
+        entity.flags |= SceneFile::EntityCastShadows;
+    }
+
+    m_entities.push_back(entity);
+}
+
+// ========================================================================= //
+
+void SceneCompiler::compileLight(rapidxml::xml_node<>* XMLNode,
+                                 const uint32_t node)
+{
+    SceneFile::Light light;
+    std::memset(&light, 0, sizeof(light));
+    light.node = node;
+    light.name = this->addString(getAttrib(XMLNode, "name"));
+    light.userData = this->addUserData(XMLNode);
+
+    const Ogre::String type = getAttrib(XMLNode, "type");
+    if (type == "directional"){
+        light.type = Ogre::Light::LT_DIRECTIONAL;
+    }
+    else if (type == "spot"){
+        light.type = Ogre::Light::LT_SPOTLIGHT;
+    }
+    else{
+        light.type = Ogre::Light::LT_POINT;
+    }
+
+    if (getAttribBool(XMLNode, "visible", true)){
+        light.flags |= SceneFile::LightVisible;
+    }
+    if (getAttribBool(XMLNode, "castShadows", true)){
+        light.flags |= SceneFile::LightCastShadows;
+    }
+
+    rapidxml::xml_node<>* pElement = XMLNode->first_node("position");
+    if (pElement){
+        std::memcpy(light.position, parseVector3(pElement).ptr(),
+                    sizeof(light.position));
+        light.flags |= SceneFile::LightPosition;
+    }
+
+    // A directionVector takes precedence over a normal.
+    pElement = XMLNode->first_node("directionVector");
+    if (pElement == nullptr){
+        pElement = XMLNode->first_node("normal");
+    }
+    if (pElement){
+        std::memcpy(light.direction, parseVector3(pElement).ptr(),
+                    sizeof(light.direction));
+        light.flags |= SceneFile::LightDirection;
+    }
+
+    pElement = XMLNode->first_node("colourDiffuse");
+    if (pElement){
+        std::memcpy(light.diffuse, parseColour(pElement).ptr(),
+                    sizeof(light.diffuse));
+        light.flags |= SceneFile::LightDiffuse;
+    }
+
+    pElement = XMLNode->first_node("colourSpecular");
+    if (pElement){
+        std::memcpy(light.specular, parseColour(pElement).ptr(),
+                    sizeof(light.specular));
+        light.flags |= SceneFile::LightSpecular;
+    }
+
+    if (type != "directional"){
+        pElement = XMLNode->first_node("lightRange");
+        if (pElement){
+            light.range[0] = getAttribReal(pElement, "inner");
+            light.range[1] = getAttribReal(pElement, "outer");
+            light.range[2] = getAttribReal(pElement, "falloff", 1.f);
+            light.flags |= SceneFile::LightRange;
+        }
+
+        pElement = XMLNode->first_node("lightAttenuation");
+        if (pElement){
+            light.attenuation[0] = getAttribReal(pElement, "range");
+            light.attenuation[1] = getAttribReal(pElement, "constant");
+            light.attenuation[2] = getAttribReal(pElement, "linear");
+            light.attenuation[3] = getAttribReal(pElement, "quadratic");
+            light.flags |= SceneFile::LightAttenuation;
+        }
+    }
+
+    m_lights.push_back(light);
+}
+
+// ========================================================================= //
+
+uint32_t SceneCompiler::addString(const std::string& str)
+{
+    if (str.empty()){
+        return SceneFile::NoString;
+    }
+
+    std::map<std::string, uint32_t>::iterator itr = m_stringOffsets.find(str);
+    if (itr != m_stringOffsets.end()){
+        return itr->second;
+    }
+
+    const uint32_t offset = static_cast<uint32_t>(m_strings.size());
+    m_strings.insert(m_strings.end(), str.begin(), str.end());
+    m_strings.push_back('\0');
+    m_stringOffsets[str] = offset;
+
+    return offset;
+}
+
+// ========================================================================= //
+
+uint32_t SceneCompiler::addUserData(rapidxml::xml_node<>* XMLNode)
+{
+    rapidxml::xml_node<>* pElement = XMLNode->first_node("userDataReference");
+    if (pElement == nullptr){
+        return SceneFile::NoString;
+    }
+
+    return this->addString(getAttrib(pElement, "id"));
+}
+
+// ========================================================================= //
+
+void SceneCompiler::skip(rapidxml::xml_node<>* XMLNode, const char* name)
+{
+    for (rapidxml::xml_node<>* pElement = XMLNode->first_node(name);
+         pElement != nullptr;
+         pElement = pElement->next_sibling(name)){
+        ++m_skipped;
+    }
+}
+
+// ========================================================================= //
+
+void SceneCompiler::serialize(std::vector<char>& image)
+{
+    // Pad the string pool so the image size stays 4-byte aligned.
+    while (m_strings.size() % 4 != 0){
+        m_strings.push_back('\0');
+    }
+
+    uint32_t offset = sizeof(SceneFile::Header);
+
+    m_header.nodeCount = static_cast<uint32_t>(m_nodes.size());
+    m_header.nodeOffset = offset;
+    offset += m_header.nodeCount * sizeof(SceneFile::Node);
+
+    m_header.entityCount = static_cast<uint32_t>(m_entities.size());
+    m_header.entityOffset = offset;
+    offset += m_header.entityCount * sizeof(SceneFile::Entity);
+
+    m_header.lightCount = static_cast<uint32_t>(m_lights.size());
+    m_header.lightOffset = offset;
+    offset += m_header.lightCount * sizeof(SceneFile::Light);
+
+    m_header.stringsSize = static_cast<uint32_t>(m_strings.size());
+    m_header.stringsOffset = offset;
+    offset += m_header.stringsSize;
+
+    image.resize(offset);
+    char* dst = &image[0];
+    std::memcpy(dst, &m_header, sizeof(m_header));
+    if (m_nodes.empty() == false){
+        std::memcpy(dst + m_header.nodeOffset, &m_nodes[0],
+                    m_nodes.size() * sizeof(SceneFile::Node));
+    }
+    if (m_entities.empty() == false){
+        std::memcpy(dst + m_header.entityOffset, &m_entities[0],
+                    m_entities.size() * sizeof(SceneFile::Entity));
+    }
+    if (m_lights.empty() == false){
+        std::memcpy(dst + m_header.lightOffset, &m_lights[0],
+                    m_lights.size() * sizeof(SceneFile::Light));
+    }
+    if (m_strings.empty() == false){
+        std::memcpy(dst + m_header.stringsOffset, &m_strings[0],
+                    m_strings.size());
+    }
+}
+
+// ========================================================================= //
\ No newline at end of file
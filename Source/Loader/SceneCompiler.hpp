@@ -0,0 +1,130 @@
+// ========================================================================= //
+// Talos - A 3D game engine with network multiplayer.
+// Copyright(C) 2015 Jordan Sparks <unixunited@live.com>
+//
+// This program is free software; you can redistribute it and / or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 3
+// of the License, or(at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+// ========================================================================= //
+// File: SceneCompiler.hpp
+// Author: Jordan Sparks <unixunited@live.com>
+// ========================================================================= //
+// Defines SceneCompiler class.
+// ========================================================================= //
+
+#ifndef __SCENECOMPILER_HPP__
+#define __SCENECOMPILER_HPP__
+
+// ========================================================================= //
+
+#include "stdafx.hpp"
+
+#include "DotSceneLoader.hpp"
+#include "SceneFile.hpp"
+
+// ========================================================================= //
+// Offline tool converting .scene XML into the SceneFile binary layout. Node
+// hierarchy, transforms, entities, lights and user data references are
+// kept; cameras, particle systems, planes and environment settings are
+// counted as skipped. Attribute parsing is shared with DotSceneLoader so both
+// paths read a file identically.
+class SceneCompiler final : private DotSceneLoader
+{
+public:
+    // Default initializes member data.
+    explicit SceneCompiler(void);
+
+    // Empty destructor.
+    virtual ~SceneCompiler(void) override;
+
+    // Compiles the .scene file at inPath and writes the result to outPath.
+    // Returns false and sets the error string on failure.
+    bool compile(const std::string& inPath, const std::string& outPath);
+
+    // Compiles .scene XML held in text (which is parsed in place) into a
+    // binary image. The name is only used in error messages.
+    bool compile(std::vector<char>& text,
+                 std::vector<char>& image,
+                 const std::string& name);
+
+    // Getters:
+
+    // Returns description of the last failure.
+    const std::string& getError(void) const;
+
+    // Returns number of elements the last compile could not represent.
+    const unsigned int getSkipped(void) const;
+
+    // Returns number of records written by the last compile.
+    const size_t getNodeCount(void) const;
+    const size_t getEntityCount(void) const;
+    const size_t getLightCount(void) const;
+
+private:
+    // Appends a node record and recurses into its children.
+    void compileNode(rapidxml::xml_node<>* XMLNode, const int32_t parent);
+
+    void compileEntity(rapidxml::xml_node<>* XMLNode, const uint32_t node);
+
+    void compileLight(rapidxml::xml_node<>* XMLNode, const uint32_t node);
+
+    // Returns offset of str in the string pool, adding it if needed.
+    uint32_t addString(const std::string& str);
+
+    // Returns offset of a user data reference's id, or NoString.
+    uint32_t addUserData(rapidxml::xml_node<>* XMLNode);
+
+    // Counts children of XMLNode named name towards the skipped total.
+    void skip(rapidxml::xml_node<>* XMLNode, const char* name);
+
+    // Lays out the header and record arrays in image.
+    void serialize(std::vector<char>& image);
+
+    SceneFile::Header m_header;
+    std::vector<SceneFile::Node> m_nodes;
+    std::vector<SceneFile::Entity> m_entities;
+    std::vector<SceneFile::Light> m_lights;
+    std::vector<char> m_strings;
+    std::map<std::string, uint32_t> m_stringOffsets;
+    std::string m_error;
+    unsigned int m_skipped;
+};
+
+// ========================================================================= //
+
+// Getters:
+
+inline const std::string& SceneCompiler::getError(void) const{
+    return m_error;
+}
+
+inline const unsigned int SceneCompiler::getSkipped(void) const{
+    return m_skipped;
+}
+
+inline const size_t SceneCompiler::getNodeCount(void) const{
+    return m_nodes.size();
+}
+
+inline const size_t SceneCompiler::getEntityCount(void) const{
+    return m_entities.size();
+}
+
+inline const size_t SceneCompiler::getLightCount(void) const{
+    return m_lights.size();
+}
+
+// ========================================================================= //
+
+#endif
+
+// ========================================================================= //
\ No newline at end of file
@@ -0,0 +1,145 @@
+// ========================================================================= //
+// Talos - A 3D game engine with network multiplayer.
+// Copyright(C) 2015 Jordan Sparks <unixunited@live.com>
+//
+// This program is free software; you can redistribute it and / or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 3
+// of the License, or(at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+// ========================================================================= //
+// File: SceneFile.hpp
+// Author: Jordan Sparks <unixunited@live.com>
+// ========================================================================= //
+// Defines the compiled binary scene layout.
+// ========================================================================= //
+
+#ifndef __SCENEFILE_HPP__
+#define __SCENEFILE_HPP__
+
+// ========================================================================= //
+
+#include <cstdint>
+#include <string>
+
+// ========================================================================= //
+// Flat binary layout of a .scene file, written offline by SceneCompiler and
+// instantiated in place by BinarySceneLoader. The file is a Header followed
+// by tightly packed record arrays at 4-byte aligned offsets, stored in the
+// target's (little-endian) byte order. Names are offsets into a pool of
+// null-terminated strings. Nodes are stored parents first so the hierarchy
+// can be created in a single pass.
+namespace SceneFile
+{;
+
+// "TSCN".
+const uint32_t Magic = 0x4E435354;
+
+// Bump whenever a record changes; stale files are rejected at load time.
+const uint32_t Version = 1;
+
+// String offset for an absent name.
+const uint32_t NoString = 0xFFFFFFFF;
+
+// Parent index of top-level nodes, which attach to the loader's attach node.
+const int32_t NoParent = -1;
+
+// Header flags, set when <nodes> carries its own transform.
+enum{
+    RootPosition = 1 << 0,
+    RootOrientation = 1 << 1,
+    RootScale = 1 << 2
+};
+
+// Entity flags.
+enum{
+    EntityStatic = 1 << 0,
+    EntityCastShadows = 1 << 1
+};
+
+// Light flags.
+enum{
+    LightVisible = 1 << 0,
+    LightCastShadows = 1 << 1,
+    LightPosition = 1 << 2,
+    LightDirection = 1 << 3,
+    LightDiffuse = 1 << 4,
+    LightSpecular = 1 << 5,
+    LightRange = 1 << 6,
+    LightAttenuation = 1 << 7
+};
+
+struct Header{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t flags;
+
+    // Transform applied to the attach node.
+    float rootPosition[3];
+    float rootOrientation[4]; // w, x, y, z.
+    float rootScale[3];
+
+    // Record arrays, offsets in bytes from the start of the file.
+    uint32_t nodeCount;
+    uint32_t nodeOffset;
+    uint32_t entityCount;
+    uint32_t entityOffset;
+    uint32_t lightCount;
+    uint32_t lightOffset;
+    uint32_t stringsSize;
+    uint32_t stringsOffset;
+};
+
+struct Node{
+    int32_t parent;
+    uint32_t name;
+    uint32_t userData;
+    float position[3];
+    float orientation[4]; // w, x, y, z.
+    float scale[3];
+};
+
+struct Entity{
+    uint32_t node;
+    uint32_t name;
+    uint32_t mesh;
+    uint32_t material;
+    uint32_t userData;
+    uint32_t flags;
+};
+
+struct Light{
+    uint32_t node;
+    uint32_t name;
+    uint32_t userData;
+    uint32_t type; // Ogre::Light::LightTypes.
+    uint32_t flags;
+    float position[3];
+    float direction[3];
+    float diffuse[4];
+    float specular[4];
+    float range[3]; // Inner and outer angle, falloff.
+    float attenuation[4]; // Range, constant, linear, quadratic.
+};
+
+// Returns the compiled file name for a .scene file, e.g. "tower-city.bscene".
+inline std::string getCompiledName(const std::string& sceneFile){
+    const size_t dot = sceneFile.find_last_of('.');
+
+    return sceneFile.substr(0, dot) + ".bscene";
+}
+
+}
+
+// ========================================================================= //
+
+#endif
+
+// ========================================================================= //
\ No newline at end of file
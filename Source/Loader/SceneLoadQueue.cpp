@@ -0,0 +1,118 @@
+// ========================================================================= //
+// Talos - A 3D game engine with network multiplayer.
+// Copyright(C) 2015 Jordan Sparks <unixunited@live.com>
+//
+// This program is free software; you can redistribute it and / or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 3
+// of the License, or(at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+// ========================================================================= //
+// File: SceneLoadQueue.cpp
+// Author: Jordan Sparks <unixunited@live.com>
+// ========================================================================= //
+// Implements SceneLoadQueue class.
+// ========================================================================= //
+
+#include "SceneLoadQueue.hpp"
+
+// ========================================================================= //
+
+SceneLoadQueue::SceneLoadQueue(void) :
+m_loaders(),
+m_budget(4.f),
+m_timer(),
+m_ticks(0)
+{
+
+}
+
+// ========================================================================= //
+
+SceneLoadQueue::~SceneLoadQueue(void)
+{
+
+}
+
+// ========================================================================= //
+
+void SceneLoadQueue::add(LoaderPtr loader)
+{
+    if (m_loaders.empty()){
+        m_ticks = 0;
+    }
+
+    m_loaders.push_back(loader);
+}
+
+// ========================================================================= //
+
+void SceneLoadQueue::update(const Ogre::Vector3& focus)
+{
+    if (m_loaders.empty()){
+        return;
+    }
+
+    ++m_ticks;
+
+    m_timer.reset();
+    Ogre::Real spent = 0.f;
+    std::list<LoaderPtr>::iterator itr = m_loaders.begin();
+    while (itr != m_loaders.end() && spent < m_budget){
+        const LoaderPtr& loader = *itr;
+        if (loader->update(m_budget - spent, focus)){
+            if (loader->isCancelled() == false){
+                Talos::Log::getSingleton().log(
+                    "Streamed scene " + loader->getName() + " (" +
+                    toString(loader->getTotal()) + " items) in " +
+                    toString(m_ticks) + " ticks, " +
+                    toString(loader->getTimeSpent()) + " ms of work");
+            }
+            itr = m_loaders.erase(itr);
+        }
+        else{
+            ++itr;
+        }
+
+        spent = m_timer.getMicroseconds() / 1000.f;
+    }
+
+    // Drop loads cancelled by their owners while waiting.
+    m_loaders.remove_if([](const LoaderPtr& loader){
+        return loader->isCancelled();
+    });
+}
+
+// ========================================================================= //
+
+void SceneLoadQueue::clear(void)
+{
+    for (auto& i : m_loaders){
+        i->cancel();
+    }
+    m_loaders.clear();
+}
+
+// ========================================================================= //
+
+const Ogre::Real SceneLoadQueue::getProgress(void) const
+{
+    size_t total = 0;
+    size_t remaining = 0;
+    for (auto& i : m_loaders){
+        total += i->getTotal();
+        remaining += i->getRemaining();
+    }
+
+    return (total == 0) ? 1.f :
+        static_cast<Ogre::Real>(total - remaining) / total;
+}
+
+// ========================================================================= //
\ No newline at end of file
@@ -0,0 +1,102 @@
+// ========================================================================= //
+// Talos - A 3D game engine with network multiplayer.
+// Copyright(C) 2015 Jordan Sparks <unixunited@live.com>
+//
+// This program is free software; you can redistribute it and / or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 3
+// of the License, or(at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+// ========================================================================= //
+// File: SceneLoadQueue.hpp
+// Author: Jordan Sparks <unixunited@live.com>
+// ========================================================================= //
+// Defines SceneLoadQueue class.
+// ========================================================================= //
+
+#ifndef __SCENELOADQUEUE_HPP__
+#define __SCENELOADQUEUE_HPP__
+
+// ========================================================================= //
+
+#include "stdafx.hpp"
+
+#include "IncrementalSceneLoader.hpp"
+
+// ========================================================================= //
+// Advances incremental scene loads each tick within a millisecond budget,
+// oldest load first, so large scenes stream in without stalling the game.
+class SceneLoadQueue final
+{
+public:
+    typedef std::shared_ptr<IncrementalSceneLoader> LoaderPtr;
+
+    // Default initializes member data.
+    explicit SceneLoadQueue(void);
+
+    // Empty destructor.
+    ~SceneLoadQueue(void);
+
+    // Queues a load, starting it on its first update if needed.
+    void add(LoaderPtr loader);
+
+    // Runs queued loads until the budget is spent, prioritising work near
+    // focus. Finished and cancelled loads are removed.
+    void update(const Ogre::Vector3& focus);
+
+    // Cancels and removes every queued load.
+    void clear(void);
+
+    // Getters:
+
+    // Returns per-tick budget in milliseconds.
+    const Ogre::Real getBudget(void) const;
+
+    // Returns fraction of queued work completed, in [0, 1].
+    const Ogre::Real getProgress(void) const;
+
+    // Returns true while any load is queued.
+    const bool isLoading(void) const;
+
+    // Setters:
+
+    // Sets per-tick budget in milliseconds.
+    void setBudget(const Ogre::Real);
+
+private:
+    std::list<LoaderPtr> m_loaders;
+    Ogre::Real m_budget;
+    Ogre::Timer m_timer;
+    uint32_t m_ticks;
+};
+
+// ========================================================================= //
+
+// Getters:
+
+inline const Ogre::Real SceneLoadQueue::getBudget(void) const{
+    return m_budget;
+}
+
+inline const bool SceneLoadQueue::isLoading(void) const{
+    return m_loaders.empty() == false;
+}
+
+// Setters:
+
+inline void SceneLoadQueue::setBudget(const Ogre::Real budget){
+    m_budget = budget;
+}
+
+// ========================================================================= //
+
+#endif
+
+// ========================================================================= //
\ No newline at end of file
@@ -0,0 +1,138 @@
+// ========================================================================= //
+// Talos - A 3D game engine with network multiplayer.
+// Copyright(C) 2015 Jordan Sparks <unixunited@live.com>
+//
+// This program is free software; you can redistribute it and / or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 3
+// of the License, or(at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+// ========================================================================= //
+// File: SceneTemplate.cpp
+// Author: Jordan Sparks <unixunited@live.com>
+// ========================================================================= //
+// Implements SceneTemplate class.
+// ========================================================================= //
+
+#include "DotSceneLoader.hpp"
+#include "SceneCompiler.hpp"
+#include "SceneTemplate.hpp"
+
+// ========================================================================= //
+
+SceneTemplate::SceneTemplate(void) :
+m_loader(),
+m_meshes(),
+m_name(),
+m_group(),
+m_dotScene(false)
+{
+
+}
+
+// ========================================================================= //
+
+SceneTemplate::~SceneTemplate(void)
+{
+
+}
+
+// ========================================================================= //
+
+bool SceneTemplate::init(const std::string& file,
+                         const std::string& group,
+                         const bool loadMeshes)
+{
+    m_name = file;
+    m_group = group;
+
+    if (m_loader.open(SceneFile::getCompiledName(file), group) == false){
+        Ogre::ResourceGroupManager& resources =
+            Ogre::ResourceGroupManager::getSingleton();
+        if (resources.resourceExists(group, file) == false){
+            Talos::Log::getSingleton().log("Scene " + file + " not found");
+            return false;
+        }
+
+        Talos::Log::getSingleton().log("No compiled scene for " + file +
+                                       ", compiling XML");
+
+        Ogre::DataStreamPtr stream = resources.openResource(file, group);
+        std::vector<char> text(stream->size());
+        if (text.empty() == false){
+            stream->read(&text[0], text.size());
+        }
+
+        SceneCompiler compiler;
+        std::vector<char> image;
+        if (compiler.compile(text, image, file) == false){
+            Talos::Log::getSingleton().log(compiler.getError());
+            return false;
+        }
+        if (compiler.getSkipped() != 0){
+            Talos::Log::getSingleton().log("Scene " + file + " has " +
+                                           toString(compiler.getSkipped()) +
+                                           " elements the compiled form "
+                                           "cannot hold, instancing it "
+                                           "with DotSceneLoader");
+            m_dotScene = true;
+        }
+
+        if (m_loader.open(image, file) == false){
+            return false;
+        }
+    }
+
+    if (loadMeshes == false){
+        return true;
+    }
+
+    // Load every mesh up front; instances share them.
+    const uint32_t entityCount = m_loader.getHeader().entityCount;
+    m_meshes.resize(entityCount);
+    for (uint32_t i = 0; i < entityCount; ++i){
+        const char* mesh = m_loader.getString(m_loader.getEntity(i).mesh);
+        try{
+            m_meshes[i] = Ogre::MeshManager::getSingleton().load(mesh, group);
+        }
+        catch (Ogre::Exception& e){
+            Talos::Log::getSingleton().log("Failed to load mesh " +
+                                           std::string(mesh) + " for " +
+                                           file + ": " + e.getDescription());
+        }
+    }
+
+    return true;
+}
+
+// ========================================================================= //
+
+void SceneTemplate::instantiate(Ogre::SceneManager* sceneMgr,
+                                Ogre::SceneNode* attachNode,
+                                const std::string& prependNode) const
+{
+    if (m_dotScene){
+        DotSceneLoader loader;
+        loader.parseDotScene(m_name,
+                             m_group,
+                             sceneMgr,
+                             attachNode,
+                             prependNode);
+        return;
+    }
+
+    m_loader.instantiate(m_group,
+                         sceneMgr,
+                         attachNode,
+                         prependNode,
+                         (m_meshes.empty()) ? nullptr : &m_meshes);
+}
+
+// ========================================================================= //
\ No newline at end of file
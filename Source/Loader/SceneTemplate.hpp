@@ -0,0 +1,131 @@
+// ========================================================================= //
+// Talos - A 3D game engine with network multiplayer.
+// Copyright(C) 2015 Jordan Sparks <unixunited@live.com>
+//
+// This program is free software; you can redistribute it and / or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 3
+// of the License, or(at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+// ========================================================================= //
+// File: SceneTemplate.hpp
+// Author: Jordan Sparks <unixunited@live.com>
+// ========================================================================= //
+// Defines SceneTemplate class.
+// ========================================================================= //
+
+#ifndef __SCENETEMPLATE_HPP__
+#define __SCENETEMPLATE_HPP__
+
+// ========================================================================= //
+
+#include "stdafx.hpp"
+
+#include "BinarySceneLoader.hpp"
+
+// ========================================================================= //
+// An immutable, validated scene image with every referenced mesh loaded.
+// Instances are created straight from memory and share the template's
+// meshes, so only the first instance of a scene touches disk or XML.
+class SceneTemplate final
+{
+public:
+    // Default initializes member data.
+    explicit SceneTemplate(void);
+
+    // Empty destructor.
+    ~SceneTemplate(void);
+
+    // Opens the compiled .bscene for file if there is one, otherwise
+    // compiles the .scene XML in memory, then loads the meshes unless
+    // loadMeshes is false. Returns false if the scene cannot be read.
+    bool init(const std::string& file,
+              const std::string& group,
+              const bool loadMeshes = true);
+
+    // Creates a copy of the scene below attachNode, prefixing node names
+    // with prependNode. Uses DotSceneLoader if isDotScene().
+    void instantiate(Ogre::SceneManager* sceneMgr,
+                     Ogre::SceneNode* attachNode,
+                     const std::string& prependNode) const;
+
+    // Getters:
+
+    // Returns the scene file name.
+    const std::string& getName(void) const;
+
+    // Returns the resource group meshes were loaded from.
+    const std::string& getGroup(void) const;
+
+    // Returns the validated scene image.
+    const BinarySceneLoader& getScene(void) const;
+
+    // Returns the loaded mesh for each entity record, or an empty list if
+    // meshes were not loaded.
+    const std::vector<Ogre::MeshPtr>& getMeshes(void) const;
+
+    // Returns number of scene nodes each instance creates.
+    const uint32_t getNodeCount(void) const;
+
+    // Returns number of entities each instance creates.
+    const uint32_t getEntityCount(void) const;
+
+    // Returns true if the XML has elements the compiled form cannot hold
+    // (cameras, particle systems, planes), so instances must be created by
+    // DotSceneLoader rather than from getScene(). getScene() still lists
+    // the entities.
+    const bool isDotScene(void) const;
+
+private:
+    BinarySceneLoader m_loader;
+    std::vector<Ogre::MeshPtr> m_meshes;
+    std::string m_name;
+    std::string m_group;
+    bool m_dotScene;
+};
+
+// ========================================================================= //
+
+// Getters:
+
+inline const std::string& SceneTemplate::getName(void) const{
+    return m_name;
+}
+
+inline const std::string& SceneTemplate::getGroup(void) const{
+    return m_group;
+}
+
+inline const BinarySceneLoader& SceneTemplate::getScene(void) const{
+    return m_loader;
+}
+
+inline const std::vector<Ogre::MeshPtr>&
+SceneTemplate::getMeshes(void) const{
+    return m_meshes;
+}
+
+inline const uint32_t SceneTemplate::getNodeCount(void) const{
+    return m_loader.getHeader().nodeCount;
+}
+
+inline const uint32_t SceneTemplate::getEntityCount(void) const{
+    return m_loader.getHeader().entityCount;
+}
+
+inline const bool SceneTemplate::isDotScene(void) const{
+    return m_dotScene;
+}
+
+// ========================================================================= //
+
+#endif
+
+// ========================================================================= //
\ No newline at end of file
@@ -0,0 +1,94 @@
+// ========================================================================= //
+// Talos - A 3D game engine with network multiplayer.
+// Copyright(C) 2015 Jordan Sparks <unixunited@live.com>
+//
+// This program is free software; you can redistribute it and / or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 3
+// of the License, or(at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+// ========================================================================= //
+// File: SceneTemplateCache.cpp
+// Author: Jordan Sparks <unixunited@live.com>
+// ========================================================================= //
+// Implements SceneTemplateCache class.
+// ========================================================================= //
+
+#include "SceneTemplateCache.hpp"
+
+// ========================================================================= //
+
+SceneTemplateCache::SceneTemplateCache(void) :
+m_templates(),
+m_hits(0),
+m_misses(0)
+{
+
+}
+
+// ========================================================================= //
+
+SceneTemplateCache::~SceneTemplateCache(void)
+{
+
+}
+
+// ========================================================================= //
+
+SceneTemplateCache::SceneTemplatePtr SceneTemplateCache::get(
+    const std::string& file,
+    const std::string& group)
+{
+    std::map<std::string, SceneTemplatePtr>::iterator itr =
+        m_templates.find(file);
+    if (itr != m_templates.end()){
+        ++m_hits;
+        return itr->second;
+    }
+
+    ++m_misses;
+
+    Ogre::Timer timer;
+    std::shared_ptr<SceneTemplate> sceneTemplate(new SceneTemplate());
+    if (sceneTemplate->init(file, group) == false){
+        sceneTemplate.reset();
+    }
+    else{
+        Talos::Log::getSingleton().log("Built scene template " + file +
+                                       " (" +
+                                       toString(sceneTemplate->getNodeCount()) +
+                                       " nodes, " +
+                                       toString(
+                                           sceneTemplate->getEntityCount()) +
+                                       " entities) in " +
+                                       toString(timer.getMicroseconds() /
+                                                1000.f) + " ms");
+    }
+
+    m_templates[file] = sceneTemplate;
+
+    return sceneTemplate;
+}
+
+// ========================================================================= //
+
+void SceneTemplateCache::remove(const std::string& file)
+{
+    m_templates.erase(file);
+}
+
+// ========================================================================= //
+
+void SceneTemplateCache::clear(void)
+{
+    m_templates.clear();
+}
+
+// ========================================================================= //
\ No newline at end of file
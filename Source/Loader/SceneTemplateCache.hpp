@@ -0,0 +1,88 @@
+// ========================================================================= //
+// Talos - A 3D game engine with network multiplayer.
+// Copyright(C) 2015 Jordan Sparks <unixunited@live.com>
+//
+// This program is free software; you can redistribute it and / or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 3
+// of the License, or(at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+// ========================================================================= //
+// File: SceneTemplateCache.hpp
+// Author: Jordan Sparks <unixunited@live.com>
+// ========================================================================= //
+// Defines SceneTemplateCache class.
+// ========================================================================= //
+
+#ifndef __SCENETEMPLATECACHE_HPP__
+#define __SCENETEMPLATECACHE_HPP__
+
+// ========================================================================= //
+
+#include "stdafx.hpp"
+
+#include "SceneTemplate.hpp"
+
+// ========================================================================= //
+// Scene templates keyed by file name. The first request for a scene builds
+// its template; every later request shares it.
+class SceneTemplateCache final
+{
+public:
+    typedef std::shared_ptr<const SceneTemplate> SceneTemplatePtr;
+
+    // Default initializes member data.
+    explicit SceneTemplateCache(void);
+
+    // Empty destructor.
+    ~SceneTemplateCache(void);
+
+    // Returns the template for file, building it on first use. Returns
+    // nullptr if the scene cannot be loaded; failures are remembered too.
+    SceneTemplatePtr get(const std::string& file,
+                         const std::string& group = "General");
+
+    // Drops the template for file. Existing instances are unaffected.
+    void remove(const std::string& file);
+
+    // Drops all templates.
+    void clear(void);
+
+    // Getters:
+
+    // Returns number of requests served from the cache.
+    const uint32_t getHits(void) const;
+
+    // Returns number of requests that built a template.
+    const uint32_t getMisses(void) const;
+
+private:
+    std::map<std::string, SceneTemplatePtr> m_templates;
+    uint32_t m_hits;
+    uint32_t m_misses;
+};
+
+// ========================================================================= //
+
+// Getters:
+
+inline const uint32_t SceneTemplateCache::getHits(void) const{
+    return m_hits;
+}
+
+inline const uint32_t SceneTemplateCache::getMisses(void) const{
+    return m_misses;
+}
+
+// ========================================================================= //
+
+#endif
+
+// ========================================================================= //
\ No newline at end of file
@@ -23,34 +23,342 @@
 
 #include "Log.hpp"
 
+#include <cstdarg>
+#include <cstdio>
+#include <functional>
+
 // ========================================================================= //
 
 template<> Talos::Log* Ogre::Singleton<Talos::Log>::msSingleton = nullptr;
 
 // ========================================================================= //
 
+#ifdef _MSC_VER
+#define TALOS_THREAD_LOCAL __declspec(thread)
+#else
+#define TALOS_THREAD_LOCAL __thread
+#endif
+
+// ========================================================================= //
+
 namespace Talos
 {;
 
 // ========================================================================= //
 
-Log::Log(void)
-{
+// The calling thread's ring and the Log it belongs to, so a ring from a
+// destroyed Log is never reused.
+static TALOS_THREAD_LOCAL void* SThreadRing = nullptr;
+static TALOS_THREAD_LOCAL Log* SThreadLog = nullptr;
+
+static const char* SLevelNames[] = { "Debug", "Info", "Warning", "Error" };
 
+// ========================================================================= //
+
+Log::Log(const std::string& file) :
+m_rings(),
+m_ringsMutex(),
+m_writer(),
+m_running(true),
+m_level(Debug),
+m_dropped(0),
+m_reportedDropped(0),
+m_rateLimit(10),
+m_echo(true),
+m_file(file, std::ios::out | std::ios::trunc),
+m_start(std::chrono::steady_clock::now()),
+m_drainRings(),
+m_line(),
+m_rates()
+{
+    m_writer = std::thread(&Log::run, this);
 }
 
 // ========================================================================= //
 
 Log::~Log(void)
 {
-
+    m_running.store(false);
+    m_writer.join();
 }
 
 // ========================================================================= //
 
 void Log::log(const std::string& str)
 {
-    Ogre::LogManager::getSingleton().logMessage("[Talos]: " + str);
+    this->log(Info, str);
+}
+
+// ========================================================================= //
+
+void Log::log(const Level level, const std::string& str)
+{
+    if (level < m_level.load(std::memory_order_relaxed)){
+        return;
+    }
+
+    // Long text spans several records; very long text is truncated rather
+    // than filling the ring.
+    uint32_t count = static_cast<uint32_t>(
+        (str.size() + PayloadSize - 1) / PayloadSize);
+    count = std::min(std::max(count, 1U), RingCapacity / 8);
+
+    uint32_t head = 0;
+    Ring* ring = this->reserve(count, head);
+    if (ring == nullptr){
+        return;
+    }
+
+    const uint32_t time = this->getTime();
+    size_t offset = 0;
+    for (uint32_t i = 0; i < count; ++i){
+        Record& record = ring->records[(head + i) & (RingCapacity - 1)];
+        const size_t length = std::min(static_cast<size_t>(PayloadSize),
+                                       str.size() - offset);
+
+        record.format = nullptr;
+        record.fmt = nullptr;
+        record.time = time;
+        record.length = static_cast<uint16_t>(length);
+        record.level = static_cast<uint8_t>(level);
+        record.more = (i + 1 < count) ? 1 : 0;
+        std::memcpy(record.payload, str.data() + offset, length);
+
+        offset += length;
+    }
+
+    this->commit(ring, head + count);
+}
+
+// ========================================================================= //
+
+void Log::flush(void)
+{
+    // Wait for the writer to catch up with every ring's current head.
+    std::vector<std::pair<Ring*, uint32_t>> targets;
+    {
+        std::lock_guard<std::mutex> lock(m_ringsMutex);
+        for (auto& ring : m_rings){
+            targets.push_back(std::make_pair(ring.get(), ring->head.load()));
+        }
+    }
+
+    for (auto& target : targets){
+        while (static_cast<int32_t>(target.first->tail.load() -
+                                    target.second) < 0){
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+}
+
+// ========================================================================= //
+
+void Log::print(char* out, const size_t size, const char* fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+#ifdef _MSC_VER
+    _vsnprintf_s(out, size, _TRUNCATE, fmt, args);
+#else
+    vsnprintf(out, size, fmt, args);
+#endif
+    va_end(args);
+}
+
+// ========================================================================= //
+
+Log::Ring* Log::getRing(void)
+{
+    if (SThreadLog == this){
+        return static_cast<Ring*>(SThreadRing);
+    }
+
+    // First message from this thread; the only time a producer locks.
+    std::lock_guard<std::mutex> lock(m_ringsMutex);
+
+    std::unique_ptr<Ring> ring(new Ring());
+    ring->head.store(0);
+    ring->tail.store(0);
+    ring->thread = static_cast<uint32_t>(m_rings.size());
+
+    SThreadRing = ring.get();
+    SThreadLog = this;
+    m_rings.push_back(std::move(ring));
+
+    return static_cast<Ring*>(SThreadRing);
+}
+
+// ========================================================================= //
+
+Log::Ring* Log::reserve(const uint32_t count, uint32_t& head)
+{
+    Ring* ring = this->getRing();
+
+    head = ring->head.load(std::memory_order_relaxed);
+    const uint32_t tail = ring->tail.load(std::memory_order_acquire);
+    if (head - tail + count > RingCapacity){
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    return ring;
+}
+
+// ========================================================================= //
+
+void Log::commit(Ring* ring, const uint32_t head)
+{
+    ring->head.store(head, std::memory_order_release);
+}
+
+// ========================================================================= //
+
+const uint32_t Log::getTime(void) const
+{
+    return static_cast<uint32_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - m_start).count());
+}
+
+// ========================================================================= //
+
+void Log::run(void)
+{
+    while (m_running.load()){
+        if (this->drain() == false){
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+    }
+
+    // Write anything queued before shutdown.
+    while (this->drain()){ }
+
+    for (auto& rate : m_rates){
+        if (rate.second.suppressed > 0){
+            this->write(Info, 0, this->getTime(),
+                        std::to_string(rate.second.suppressed) +
+                        " repeated messages suppressed");
+        }
+    }
+    m_file.flush();
+}
+
+// ========================================================================= //
+
+bool Log::drain(void)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_ringsMutex);
+        if (m_drainRings.size() != m_rings.size()){
+            m_drainRings.clear();
+            for (auto& ring : m_rings){
+                m_drainRings.push_back(ring.get());
+            }
+        }
+    }
+
+    bool wrote = false;
+    char buffer[1024];
+    for (auto ring : m_drainRings){
+        uint32_t tail = ring->tail.load(std::memory_order_relaxed);
+        const uint32_t head = ring->head.load(std::memory_order_acquire);
+
+        while (tail != head){
+            const Record& record = ring->records[tail & (RingCapacity - 1)];
+
+            if (record.format != nullptr){
+                record.format(buffer, sizeof(buffer), record.fmt,
+                              record.payload);
+                m_line.append(buffer);
+            }
+            else{
+                m_line.append(record.payload, record.length);
+            }
+
+            // Formatted messages are limited per call site, text per content.
+            if (record.more == 0){
+                const size_t key = (record.fmt != nullptr) ?
+                    reinterpret_cast<size_t>(record.fmt) :
+                    std::hash<std::string>()(m_line);
+                if (this->allow(key, record.time)){
+                    this->write(record.level, ring->thread, record.time,
+                                m_line);
+                }
+                m_line.clear();
+            }
+
+            ++tail;
+            wrote = true;
+        }
+
+        ring->tail.store(tail, std::memory_order_release);
+    }
+
+    const uint32_t dropped = m_dropped.load(std::memory_order_relaxed);
+    if (dropped != m_reportedDropped){
+        this->write(Warning, 0, this->getTime(),
+                    std::to_string(dropped - m_reportedDropped) +
+                    " messages dropped, log ring full");
+        m_reportedDropped = dropped;
+        wrote = true;
+    }
+
+    if (wrote){
+        m_file.flush();
+    }
+
+    return wrote;
+}
+
+// ========================================================================= //
+
+bool Log::allow(const size_t key, const uint32_t time)
+{
+    const uint32_t limit = m_rateLimit.load(std::memory_order_relaxed);
+    if (limit == 0){
+        return true;
+    }
+
+    const uint32_t window = time / 1000;
+    RateState& state = m_rates[key];
+    if (state.window != window || state.count == 0){
+        if (state.suppressed > 0){
+            this->write(Info, 0, time, std::to_string(state.suppressed) +
+                        " repeated messages suppressed");
+        }
+        state.window = window;
+        state.count = 0;
+        state.suppressed = 0;
+    }
+
+    if (state.count >= limit){
+        ++state.suppressed;
+        return false;
+    }
+
+    ++state.count;
+
+    return true;
+}
+
+// ========================================================================= //
+
+void Log::write(const uint8_t level,
+                const uint32_t thread,
+                const uint32_t time,
+                const std::string& text)
+{
+    char prefix[64];
+    Log::print(prefix, sizeof(prefix), "[%u.%03u] [%s] [T%u] ",
+               time / 1000, time % 1000, SLevelNames[level], thread);
+
+    m_file << prefix << text << '\n';
+
+    if (m_echo.load(std::memory_order_relaxed)){
+        std::fputs(prefix, stdout);
+        std::fputs(text.c_str(), stdout);
+        std::fputc('\n', stdout);
+    }
 }
 
 // ========================================================================= //
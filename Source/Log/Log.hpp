@@ -18,7 +18,7 @@
 // File: Log.hpp
 // Author: Jordan Sparks <unixunited@live.com>
 // ========================================================================= //
-// Defines Log class.
+// Defines Log class and logging macros.
 // ========================================================================= //
 
 #ifndef __LOG_HPP__
@@ -28,31 +28,299 @@
 
 #include <Ogre.h>
 
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+
+// ========================================================================= //
+
+// Messages below this level compile away: 0 debug, 1 info, 2 warning,
+// 3 error.
+#ifndef TALOS_LOG_LEVEL
+#ifdef _DEBUG
+#define TALOS_LOG_LEVEL 0
+#else
+#define TALOS_LOG_LEVEL 1
+#endif
+#endif
+
+// Formatted logging, e.g. LogDebug("Hit ID: %d", id). The format must be a
+// string literal and arguments plain values; formatting happens later on
+// the writer thread.
+#if TALOS_LOG_LEVEL <= 0
+#define LogDebug(...)\
+Talos::Log::getSingleton().logf(Talos::Log::Debug, __VA_ARGS__)
+#else
+#define LogDebug(...) ((void)0)
+#endif
+
+#if TALOS_LOG_LEVEL <= 1
+#define LogInfo(...)\
+Talos::Log::getSingleton().logf(Talos::Log::Info, __VA_ARGS__)
+#else
+#define LogInfo(...) ((void)0)
+#endif
+
+#if TALOS_LOG_LEVEL <= 2
+#define LogWarning(...)\
+Talos::Log::getSingleton().logf(Talos::Log::Warning, __VA_ARGS__)
+#else
+#define LogWarning(...) ((void)0)
+#endif
+
+#define LogError(...)\
+Talos::Log::getSingleton().logf(Talos::Log::Error, __VA_ARGS__)
+
 // ========================================================================= //
 
 namespace Talos
 {;
 
 // ========================================================================= //
-// Currently just a wrapper for logging to the Ogre log file.
+// Asynchronous logger. Each thread writes messages into its own lock-free
+// ring buffer; a writer thread formats them and appends them to the log
+// file, so logging never waits on disk. Messages are dropped (and counted)
+// if a ring is full. Repeated messages from one call site are rate limited.
 class Log : public Ogre::Singleton<Log>
 {
 public:
-    // Empty constructor.
-    explicit Log(void);
+    enum Level{
+        Debug = 0,
+        Info,
+        Warning,
+        Error
+    };
 
-    // Empty destructor.
+    // Opens the log file and starts the writer thread.
+    explicit Log(const std::string& file = "Game.log");
+
+    // Writes pending messages and stops the writer thread.
     virtual ~Log(void);
 
-    // Logs to Ogre log file with "Talos" prefix.
+    // Logs a copy of str at Info level.
     virtual void log(const std::string& str);
 
+    // Logs a copy of str at level.
+    void log(const Level level, const std::string& str);
+
+    // Queues fmt and args to be formatted with printf rules on the writer
+    // thread. Pointer arguments must outlive the call, so use log() for
+    // strings that are not literals.
+    template<typename... Args>
+    void logf(const Level level, const char* fmt, const Args&... args);
+
+    // Blocks until every message queued so far has been written.
+    void flush(void);
+
+    // Getters:
+
+    // Returns lowest level logged.
+    const Level getLevel(void) const;
+
+    // Returns number of messages dropped because a ring was full.
+    const uint32_t getDropped(void) const;
+
+    // Setters:
+
+    // Sets lowest level logged. Levels below TALOS_LOG_LEVEL are already
+    // compiled away.
+    void setLevel(const Level);
+
+    // Sets messages per second written from each call site, 0 for no limit.
+    void setRateLimit(const uint32_t);
+
+    // Also writes messages to stdout if true (default).
+    void setEcho(const bool);
+
 private:
+    // Formats a record's payload into out.
+    typedef void(*FormatFunc)(char* out,
+                              const size_t size,
+                              const char* fmt,
+                              const char* payload);
+
+    static const size_t PayloadSize = 104;
+    static const uint32_t RingCapacity = 1024;
+
+    // A formatted message, or a chunk of text when format is null.
+    struct Record{
+        FormatFunc format;
+        const char* fmt;
+        uint32_t time;
+        uint16_t length;
+        uint8_t level;
+        // Text continues in the next record.
+        uint8_t more;
+        char payload[PayloadSize];
+    };
+
+    // Single producer, single consumer.
+    struct Ring{
+        Record records[RingCapacity];
+        std::atomic<uint32_t> head;
+        std::atomic<uint32_t> tail;
+        uint32_t thread;
+    };
+
+    // Per-call-site rate limiting state.
+    struct RateState{
+        uint32_t window;
+        uint32_t count;
+        uint32_t suppressed;
+    };
+
+    template<size_t... I> struct Indices{ };
+
+    template<size_t N, size_t... I>
+    struct MakeIndices : MakeIndices<N - 1, N - 1, I...>{ };
+
+    template<size_t... I>
+    struct MakeIndices<0, I...>{ typedef Indices<I...> type; };
+
+    template<typename... Args>
+    struct AllScalar : std::true_type{ };
+
+    template<typename T, typename... Args>
+    struct AllScalar<T, Args...> : std::integral_constant<bool,
+        std::is_scalar<T>::value && AllScalar<Args...>::value>{ };
 
+    template<typename... Args>
+    struct Formatter{
+        static void format(char* out,
+                           const size_t size,
+                           const char* fmt,
+                           const char* payload){
+            std::tuple<Args...> args;
+            std::memcpy(static_cast<void*>(&args), payload, sizeof(args));
+            call(out, size, fmt, args,
+                 typename MakeIndices<sizeof...(Args)>::type());
+        }
+
+        template<size_t... I>
+        static void call(char* out,
+                         const size_t size,
+                         const char* fmt,
+                         const std::tuple<Args...>& args,
+                         Indices<I...>){
+            Log::print(out, size, fmt, std::get<I>(args)...);
+        }
+    };
+
+    // snprintf that always terminates out.
+    static void print(char* out, const size_t size, const char* fmt, ...);
+
+    // Returns the calling thread's ring, creating it on first use.
+    Ring* getRing(void);
+
+    // Reserves count records in the calling thread's ring, setting head to
+    // the first. Returns null, counting a drop, if the ring is full.
+    Ring* reserve(const uint32_t count, uint32_t& head);
+
+    // Publishes records reserved up to head.
+    void commit(Ring* ring, const uint32_t head);
+
+    // Returns milliseconds since the log was created.
+    const uint32_t getTime(void) const;
+
+    // Writer thread loop.
+    void run(void);
+
+    // Writes every published record. Returns false if there were none.
+    bool drain(void);
+
+    // Applies the rate limit. Returns false if the message is suppressed.
+    bool allow(const size_t key, const uint32_t time);
+
+    // Writes a finished line to the file and stdout.
+    void write(const uint8_t level,
+               const uint32_t thread,
+               const uint32_t time,
+               const std::string& text);
+
+    std::vector<std::unique_ptr<Ring>> m_rings;
+    std::mutex m_ringsMutex;
+    std::thread m_writer;
+    std::atomic<bool> m_running;
+    std::atomic<int> m_level;
+    std::atomic<uint32_t> m_dropped;
+    uint32_t m_reportedDropped;
+    std::atomic<uint32_t> m_rateLimit;
+    std::atomic<bool> m_echo;
+    std::ofstream m_file;
+    std::chrono::steady_clock::time_point m_start;
+
+    // Writer thread state.
+    std::vector<Ring*> m_drainRings;
+    std::string m_line;
+    std::map<size_t, RateState> m_rates;
 };
 
 // ========================================================================= //
 
+template<typename... Args>
+inline void Log::logf(const Level level,
+                      const char* fmt,
+                      const Args&... args){
+    static_assert(AllScalar<Args...>::value,
+                  "Log arguments must be numbers or pointers");
+    static_assert(sizeof(std::tuple<Args...>) <= PayloadSize,
+                  "Too many log arguments");
+
+    if (level < m_level.load(std::memory_order_relaxed)){
+        return;
+    }
+
+    uint32_t head = 0;
+    Ring* ring = this->reserve(1, head);
+    if (ring == nullptr){
+        return;
+    }
+
+    Record& record = ring->records[head & (RingCapacity - 1)];
+    record.format = &Formatter<Args...>::format;
+    record.fmt = fmt;
+    record.time = this->getTime();
+    record.length = 0;
+    record.level = static_cast<uint8_t>(level);
+    record.more = 0;
+    const std::tuple<Args...> tuple(args...);
+    std::memcpy(record.payload, &tuple, sizeof(tuple));
+
+    this->commit(ring, head + 1);
+}
+
+// Getters:
+
+inline const Log::Level Log::getLevel(void) const{
+    return static_cast<Level>(m_level.load());
+}
+
+inline const uint32_t Log::getDropped(void) const{
+    return m_dropped.load();
+}
+
+// Setters:
+
+inline void Log::setLevel(const Level level){
+    m_level.store(level);
+}
+
+inline void Log::setRateLimit(const uint32_t limit){
+    m_rateLimit = limit;
+}
+
+inline void Log::setEcho(const bool echo){
+    m_echo = echo;
+}
+
+// ========================================================================= //
+
 }
 
 // ========================================================================= //
@@ -0,0 +1,187 @@
+// ========================================================================= //
+// Talos - A 3D game engine with network multiplayer.
+// Copyright(C) 2015 Jordan Sparks <unixunited@live.com>
+//
+// This program is free software; you can redistribute it and / or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 3
+// of the License, or(at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+// ========================================================================= //
+// File: FrameArena.cpp
+// Author: Jordan Sparks <unixunited@live.com>
+// ========================================================================= //
+// Implements FrameArena class.
+// ========================================================================= //
+
+#include "FrameArena.hpp"
+
+#include <cstring>
+
+// ========================================================================= //
+
+#ifdef _MSC_VER
+#define TALOS_THREAD_LOCAL __declspec(thread)
+#else
+#define TALOS_THREAD_LOCAL __thread
+#endif
+
+// ========================================================================= //
+
+namespace Talos
+{;
+
+// ========================================================================= //
+
+// The calling thread's arena.
+static TALOS_THREAD_LOCAL FrameArena* SThreadArena = nullptr;
+
+#ifdef _DEBUG
+// Fill patterns for memory handed out and memory reclaimed.
+static const int SAllocatedPoison = 0xCD;
+static const int SReclaimedPoison = 0xDD;
+#endif
+
+// ========================================================================= //
+
+FrameArena::FrameArena(const size_t capacity) :
+m_begin(new char[capacity]),
+m_end(m_begin + capacity),
+m_current(m_begin),
+m_overflow(),
+m_overflowBytes(0),
+m_overflowCount(0),
+m_highWaterMark(0)
+{
+#ifdef _DEBUG
+    std::memset(m_begin, SReclaimedPoison, capacity);
+#endif
+}
+
+// ========================================================================= //
+
+FrameArena::~FrameArena(void)
+{
+    for (std::vector<void*>::iterator itr = m_overflow.begin();
+         itr != m_overflow.end();
+         ++itr){
+        ::operator delete(*itr);
+    }
+
+    delete[] m_begin;
+}
+
+// ========================================================================= //
+
+void* FrameArena::allocate(const size_t size, const size_t align)
+{
+    Assert((align & (align - 1)) == 0, "Alignment must be a power of two");
+
+    const uintptr_t current = reinterpret_cast<uintptr_t>(m_current);
+    const uintptr_t aligned = (current + align - 1) & ~(align - 1);
+    const uintptr_t end = reinterpret_cast<uintptr_t>(m_end);
+
+    void* p = nullptr;
+    if (aligned <= end && size <= end - aligned){
+        p = reinterpret_cast<void*>(aligned);
+        m_current = reinterpret_cast<char*>(aligned + size);
+    }
+    else{
+        // The block is full; operator new is aligned for any fundamental 
+        // type, which covers every alignment asked for here.
+        p = ::operator new(size);
+        m_overflow.push_back(p);
+        m_overflowBytes += size;
+        ++m_overflowCount;
+    }
+
+#ifdef _DEBUG
+    std::memset(p, SAllocatedPoison, size);
+#endif
+
+    m_highWaterMark = std::max(m_highWaterMark, this->getUsed());
+
+    return p;
+}
+
+// ========================================================================= //
+
+void FrameArena::deallocate(void* p, const size_t size)
+{
+#ifdef _DEBUG
+    std::memset(p, SReclaimedPoison, size);
+#endif
+}
+
+// ========================================================================= //
+
+void FrameArena::reset(void)
+{
+#ifdef _DEBUG
+    std::memset(m_begin, SReclaimedPoison, m_current - m_begin);
+#endif
+    m_current = m_begin;
+
+    if (m_overflow.empty() == true){
+        return;
+    }
+
+    for (std::vector<void*>::iterator itr = m_overflow.begin();
+         itr != m_overflow.end();
+         ++itr){
+        ::operator delete(*itr);
+    }
+    m_overflow.clear();
+    m_overflowBytes = 0;
+
+    // Nothing is alive now, so grow the block to fit the worst tick so far.
+    size_t capacity = this->getCapacity();
+    while (capacity < m_highWaterMark){
+        capacity *= 2;
+    }
+
+    Talos::Log::getSingleton().log(Talos::Log::Warning,
+                                   "FrameArena overflowed, growing from " +
+                                   toString(this->getCapacity()) + " to " +
+                                   toString(capacity) + " bytes");
+
+    delete[] m_begin;
+    m_begin = new char[capacity];
+    m_end = m_begin + capacity;
+    m_current = m_begin;
+#ifdef _DEBUG
+    std::memset(m_begin, SReclaimedPoison, capacity);
+#endif
+}
+
+// ========================================================================= //
+
+FrameArena& FrameArena::get(void)
+{
+    if (SThreadArena == nullptr){
+        SThreadArena = new FrameArena();
+    }
+
+    return *SThreadArena;
+}
+
+// ========================================================================= //
+
+void FrameArena::releaseThread(void)
+{
+    delete SThreadArena;
+    SThreadArena = nullptr;
+}
+
+// ========================================================================= //
+
+}
+
+// ========================================================================= //
\ No newline at end of file
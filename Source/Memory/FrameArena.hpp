@@ -0,0 +1,204 @@
+// ========================================================================= //
+// Talos - A 3D game engine with network multiplayer.
+// Copyright(C) 2015 Jordan Sparks <unixunited@live.com>
+//
+// This program is free software; you can redistribute it and / or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 3
+// of the License, or(at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+// ========================================================================= //
+// File: FrameArena.hpp
+// Author: Jordan Sparks <unixunited@live.com>
+// ========================================================================= //
+// Defines FrameArena class and FrameAllocator STL adaptor.
+// ========================================================================= //
+
+#ifndef __FRAMEARENA_HPP__
+#define __FRAMEARENA_HPP__
+
+// ========================================================================= //
+
+#include "stdafx.hpp"
+
+#include <limits>
+#include <type_traits>
+
+// ========================================================================= //
+
+namespace Talos
+{;
+
+// ========================================================================= //
+// Linear allocator for data that lives no longer than one tick. Allocation
+// bumps a pointer, deallocation is a no-op and reset() reclaims everything at
+// once. Each thread has its own arena (see get()); the main thread's arena is
+// reset by the Engine at the end of every tick, so nothing allocated from it
+// may be kept across ticks. Requests that don't fit fall back to the heap
+// until the next reset, which then grows the arena to the high-water mark.
+// Debug builds poison allocated and reclaimed memory.
+class FrameArena
+{
+public:
+    // Default capacity in bytes.
+    static const size_t DefaultCapacity = 1 << 20;
+
+    // Allocates the arena's block.
+    explicit FrameArena(const size_t capacity = DefaultCapacity);
+
+    // Frees the block and any overflow allocations.
+    ~FrameArena(void);
+
+    // Returns size bytes aligned to align (a power of two).
+    void* allocate(const size_t size, 
+                   const size_t align = sizeof(void*));
+
+    // Memory is reclaimed by reset(); debug builds poison the range.
+    void deallocate(void* p, const size_t size);
+
+    // Reclaims all allocations. Everything allocated since the last reset is
+    // invalid afterwards.
+    void reset(void);
+
+    // Returns the calling thread's arena, creating it on first use.
+    static FrameArena& get(void);
+
+    // Destroys the calling thread's arena. Threads using get() call this
+    // before they exit.
+    static void releaseThread(void);
+
+    // Getters:
+
+    // Returns size of the block in bytes.
+    const size_t getCapacity(void) const;
+
+    // Returns bytes allocated since the last reset, including overflow.
+    const size_t getUsed(void) const;
+
+    // Returns the most bytes used between two resets.
+    const size_t getHighWaterMark(void) const;
+
+    // Returns number of allocations that fell back to the heap.
+    const uint32_t getOverflowCount(void) const;
+
+private:
+    char* m_begin;
+    char* m_end;
+    char* m_current;
+
+    // Heap allocations made while the block was full.
+    std::vector<void*> m_overflow;
+    size_t m_overflowBytes;
+    uint32_t m_overflowCount;
+
+    size_t m_highWaterMark;
+};
+
+// ========================================================================= //
+
+// Getters:
+
+inline const size_t FrameArena::getCapacity(void) const{
+    return static_cast<size_t>(m_end - m_begin);
+}
+
+inline const size_t FrameArena::getUsed(void) const{
+    return static_cast<size_t>(m_current - m_begin) + m_overflowBytes;
+}
+
+inline const size_t FrameArena::getHighWaterMark(void) const{
+    return m_highWaterMark;
+}
+
+inline const uint32_t FrameArena::getOverflowCount(void) const{
+    return m_overflowCount;
+}
+
+// ========================================================================= //
+// STL allocator drawing from a FrameArena (the calling thread's by default),
+// e.g. std::vector<EntityID, FrameAllocator<EntityID>>. Containers using it 
+// must not outlive the tick.
+template<typename T>
+class FrameAllocator
+{
+public:
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+
+    template<typename U>
+    struct rebind{
+        typedef FrameAllocator<U> other;
+    };
+
+    FrameAllocator(void) : m_arena(&FrameArena::get()) { }
+
+    explicit FrameAllocator(FrameArena& arena) : m_arena(&arena) { }
+
+    template<typename U>
+    FrameAllocator(const FrameAllocator<U>& other) : 
+    m_arena(other.getArena()) { }
+
+    T* allocate(const size_t n){
+        return static_cast<T*>(m_arena->allocate(
+            n * sizeof(T), std::alignment_of<T>::value));
+    }
+
+    void deallocate(T* p, const size_t n){
+        m_arena->deallocate(p, n * sizeof(T));
+    }
+
+    const size_t max_size(void) const{
+        return std::numeric_limits<size_t>::max() / sizeof(T);
+    }
+
+    template<typename U, typename... Args>
+    void construct(U* p, Args&&... args){
+        new (p) U(std::forward<Args>(args)...);
+    }
+
+    template<typename U>
+    void destroy(U* p){
+        p->~U();
+    }
+
+    FrameArena* getArena(void) const{
+        return m_arena;
+    }
+
+private:
+    FrameArena* m_arena;
+};
+
+template<typename T, typename U>
+inline bool operator==(const FrameAllocator<T>& a, 
+                       const FrameAllocator<U>& b){
+    return a.getArena() == b.getArena();
+}
+
+template<typename T, typename U>
+inline bool operator!=(const FrameAllocator<T>& a, 
+                       const FrameAllocator<U>& b){
+    return a.getArena() != b.getArena();
+}
+
+// ========================================================================= //
+
+}
+
+// ========================================================================= //
+
+#endif
+
+// ========================================================================= //
\ No newline at end of file
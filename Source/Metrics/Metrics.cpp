@@ -0,0 +1,387 @@
+// ========================================================================= //
+// Talos - A 3D game engine with network multiplayer.
+// Copyright(C) 2015 Jordan Sparks <unixunited@live.com>
+//
+// This program is free software; you can redistribute it and / or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 3
+// of the License, or(at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+// ========================================================================= //
+// File: Metrics.cpp
+// Author: Jordan Sparks <unixunited@live.com>
+// ========================================================================= //
+// Implements Metrics class.
+// ========================================================================= //
+
+#include "Metrics.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+// ========================================================================= //
+
+template<> Talos::Metrics* Ogre::Singleton<Talos::Metrics>::msSingleton =
+    nullptr;
+
+// ========================================================================= //
+
+#ifdef _MSC_VER
+#define TALOS_THREAD_LOCAL __declspec(thread)
+#else
+#define TALOS_THREAD_LOCAL __thread
+#endif
+
+// ========================================================================= //
+
+namespace Talos
+{;
+
+// ========================================================================= //
+
+// Shard index of the calling thread, plus one so zero means unassigned.
+static TALOS_THREAD_LOCAL uint32_t SThreadSlot = 0;
+static std::atomic<uint32_t> SNextThreadSlot(0);
+
+// ========================================================================= //
+
+// Returns value written for the exposition format.
+static std::string formatValue(const double value)
+{
+    if (value == std::numeric_limits<double>::infinity()){
+        return "+Inf";
+    }
+
+    std::ostringstream oss;
+    oss << std::setprecision(12) << value;
+    return oss.str();
+}
+
+// ========================================================================= //
+
+// Returns "name{labels}" or "name".
+static std::string formatName(const std::string& name,
+                              const std::string& labels)
+{
+    return (labels.empty()) ? name : name + "{" + labels + "}";
+}
+
+// ========================================================================= //
+
+// Adds delta to an atomic double.
+static void addDouble(std::atomic<double>& target, const double delta)
+{
+    double current = target.load(std::memory_order_relaxed);
+    while (target.compare_exchange_weak(current, current + delta,
+                                        std::memory_order_relaxed) == false){ }
+}
+
+// ========================================================================= //
+
+Metrics::Counter::Counter(void)
+{
+    for (uint32_t i = 0; i < Shards; ++i){
+        m_shards[i].value.store(0);
+    }
+}
+
+// ========================================================================= //
+
+void Metrics::Counter::add(const uint64_t n)
+{
+    m_shards[Metrics::getThreadSlot()].value.fetch_add(
+        n, std::memory_order_relaxed);
+}
+
+// ========================================================================= //
+
+const uint64_t Metrics::Counter::get(void) const
+{
+    uint64_t total = 0;
+    for (uint32_t i = 0; i < Shards; ++i){
+        total += m_shards[i].value.load(std::memory_order_relaxed);
+    }
+
+    return total;
+}
+
+// ========================================================================= //
+
+Metrics::Gauge::Gauge(void) :
+m_value(0.0)
+{
+
+}
+
+// ========================================================================= //
+
+void Metrics::Gauge::set(const double value)
+{
+    m_value.store(value, std::memory_order_relaxed);
+}
+
+// ========================================================================= //
+
+void Metrics::Gauge::add(const double delta)
+{
+    addDouble(m_value, delta);
+}
+
+// ========================================================================= //
+
+const double Metrics::Gauge::get(void) const
+{
+    return m_value.load(std::memory_order_relaxed);
+}
+
+// ========================================================================= //
+
+Metrics::Histogram::Histogram(const std::vector<double>& bounds) :
+m_bounds(bounds)
+{
+    std::sort(m_bounds.begin(), m_bounds.end());
+
+    // One extra bucket for +Inf.
+    for (uint32_t i = 0; i < Shards; ++i){
+        Shard& shard = m_shards[i];
+        shard.buckets.reset(new std::atomic<uint64_t>[m_bounds.size() + 1]);
+        for (size_t j = 0; j <= m_bounds.size(); ++j){
+            shard.buckets[j].store(0);
+        }
+        shard.count.store(0);
+        shard.sum.store(0.0);
+    }
+}
+
+// ========================================================================= //
+
+void Metrics::Histogram::observe(const double value)
+{
+    const size_t bucket = std::lower_bound(m_bounds.begin(),
+                                           m_bounds.end(),
+                                           value) - m_bounds.begin();
+
+    Shard& shard = m_shards[Metrics::getThreadSlot()];
+    shard.buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    shard.count.fetch_add(1, std::memory_order_relaxed);
+    addDouble(shard.sum, value);
+}
+
+// ========================================================================= //
+
+const uint64_t Metrics::Histogram::getCumulativeCount(
+    const size_t bucket) const
+{
+    uint64_t total = 0;
+    for (uint32_t i = 0; i < Shards; ++i){
+        for (size_t j = 0; j <= bucket; ++j){
+            total += m_shards[i].buckets[j].load(std::memory_order_relaxed);
+        }
+    }
+
+    return total;
+}
+
+// ========================================================================= //
+
+const uint64_t Metrics::Histogram::getCount(void) const
+{
+    uint64_t total = 0;
+    for (uint32_t i = 0; i < Shards; ++i){
+        total += m_shards[i].count.load(std::memory_order_relaxed);
+    }
+
+    return total;
+}
+
+// ========================================================================= //
+
+const double Metrics::Histogram::getSum(void) const
+{
+    double total = 0.0;
+    for (uint32_t i = 0; i < Shards; ++i){
+        total += m_shards[i].sum.load(std::memory_order_relaxed);
+    }
+
+    return total;
+}
+
+// ========================================================================= //
+
+Metrics::Metrics(void) :
+m_families(),
+m_mutex()
+{
+
+}
+
+// ========================================================================= //
+
+Metrics::~Metrics(void)
+{
+
+}
+
+// ========================================================================= //
+
+const uint32_t Metrics::getThreadSlot(void)
+{
+    if (SThreadSlot == 0){
+        SThreadSlot = (SNextThreadSlot.fetch_add(1) % Shards) + 1;
+    }
+
+    return SThreadSlot - 1;
+}
+
+// ========================================================================= //
+
+Metrics::Family& Metrics::getFamily(const std::string& name,
+                                    const std::string& help,
+                                    const Type type)
+{
+    std::map<std::string, Family>::iterator itr = m_families.find(name);
+    if (itr == m_families.end()){
+        Family family;
+        family.type = type;
+        family.help = help;
+        itr = m_families.insert(std::make_pair(name, family)).first;
+    }
+
+    Assert(itr->second.type == type, "Metric registered with two types");
+
+    return itr->second;
+}
+
+// ========================================================================= //
+
+Metrics::Counter* Metrics::getCounter(const std::string& name,
+                                      const std::string& help,
+                                      const std::string& labels)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    std::shared_ptr<Counter>& counter =
+        this->getFamily(name, help, Type::Counter).counters[labels];
+    if (counter == nullptr){
+        counter.reset(new Counter());
+    }
+
+    return counter.get();
+}
+
+// ========================================================================= //
+
+Metrics::Gauge* Metrics::getGauge(const std::string& name,
+                                  const std::string& help,
+                                  const std::string& labels)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    std::shared_ptr<Gauge>& gauge =
+        this->getFamily(name, help, Type::Gauge).gauges[labels];
+    if (gauge == nullptr){
+        gauge.reset(new Gauge());
+    }
+
+    return gauge.get();
+}
+
+// ========================================================================= //
+
+Metrics::Histogram* Metrics::getHistogram(const std::string& name,
+                                          const std::string& help,
+                                          const std::vector<double>& bounds,
+                                          const std::string& labels)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    std::shared_ptr<Histogram>& histogram =
+        this->getFamily(name, help, Type::Histogram).histograms[labels];
+    if (histogram == nullptr){
+        if (bounds.empty()){
+            // Milliseconds, around a 60 Hz frame.
+            const double defaults[] = { 0.1, 0.25, 0.5, 1.0, 2.0, 4.0, 8.0,
+                                        16.0, 33.0, 66.0, 133.0 };
+            histogram.reset(new Histogram(std::vector<double>(
+                defaults, defaults + sizeof(defaults) / sizeof(double))));
+        }
+        else{
+            histogram.reset(new Histogram(bounds));
+        }
+    }
+
+    return histogram.get();
+}
+
+// ========================================================================= //
+
+std::string Metrics::scrape(void)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    std::ostringstream out;
+    for (auto& itr : m_families){
+        const std::string& name = itr.first;
+        const Family& family = itr.second;
+
+        out << "# HELP " << name << " " << family.help << "\n";
+
+        switch (family.type){
+        case Type::Counter:
+            out << "# TYPE " << name << " counter\n";
+            for (auto& counter : family.counters){
+                out << formatName(name, counter.first) << " " <<
+                    counter.second->get() << "\n";
+            }
+            break;
+
+        case Type::Gauge:
+            out << "# TYPE " << name << " gauge\n";
+            for (auto& gauge : family.gauges){
+                out << formatName(name, gauge.first) << " " <<
+                    formatValue(gauge.second->get()) << "\n";
+            }
+            break;
+
+        case Type::Histogram:
+            out << "# TYPE " << name << " histogram\n";
+            for (auto& histogram : family.histograms){
+                const std::string& labels = histogram.first;
+                const Histogram& h = *histogram.second;
+                const std::string prefix = (labels.empty()) ?
+                    "" : labels + ",";
+
+                const std::vector<double>& bounds = h.getBounds();
+                for (size_t i = 0; i <= bounds.size(); ++i){
+                    const double bound = (i < bounds.size()) ? bounds[i] :
+                        std::numeric_limits<double>::infinity();
+                    out << name << "_bucket{" << prefix << "le=\"" <<
+                        formatValue(bound) << "\"} " <<
+                        h.getCumulativeCount(i) << "\n";
+                }
+                out << formatName(name + "_sum", labels) << " " <<
+                    formatValue(h.getSum()) << "\n";
+                out << formatName(name + "_count", labels) << " " <<
+                    h.getCount() << "\n";
+            }
+            break;
+        }
+    }
+
+    return out.str();
+}
+
+// ========================================================================= //
+
+}
+
+// ========================================================================= //
\ No newline at end of file
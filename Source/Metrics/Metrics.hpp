@@ -0,0 +1,196 @@
+// ========================================================================= //
+// Talos - A 3D game engine with network multiplayer.
+// Copyright(C) 2015 Jordan Sparks <unixunited@live.com>
+//
+// This program is free software; you can redistribute it and / or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 3
+// of the License, or(at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+// ========================================================================= //
+// File: Metrics.hpp
+// Author: Jordan Sparks <unixunited@live.com>
+// ========================================================================= //
+// Defines Metrics class.
+// ========================================================================= //
+
+#ifndef __METRICS_HPP__
+#define __METRICS_HPP__
+
+// ========================================================================= //
+
+#include "stdafx.hpp"
+
+#include <atomic>
+#include <mutex>
+
+// ========================================================================= //
+
+namespace Talos
+{;
+
+// ========================================================================= //
+// Registry of runtime counters, gauges and histograms, written out in the
+// Prometheus text exposition format. Counters and histograms accumulate in
+// per-thread shards of atomics, so updating them never takes a lock;
+// registration and scraping do. Metrics live as long as the registry, so
+// callers look them up once and keep the pointer.
+class Metrics : public Ogre::Singleton<Metrics>
+{
+public:
+    // Number of shards updates are spread over by thread.
+    static const uint32_t Shards = 8;
+
+    // A monotonically increasing count.
+    class Counter
+    {
+    public:
+        explicit Counter(void);
+
+        // Adds n to the count.
+        void add(const uint64_t n = 1);
+
+        // Returns the total over all shards.
+        const uint64_t get(void) const;
+
+    private:
+        // Padded to keep shards on separate cache lines.
+        struct Shard{
+            std::atomic<uint64_t> value;
+            char pad[56];
+        };
+
+        Shard m_shards[Shards];
+    };
+
+    // A value that goes up and down.
+    class Gauge
+    {
+    public:
+        explicit Gauge(void);
+
+        // Sets the value.
+        void set(const double value);
+
+        // Adds delta to the value.
+        void add(const double delta);
+
+        // Returns the value.
+        const double get(void) const;
+
+    private:
+        std::atomic<double> m_value;
+    };
+
+    // Counts observations into buckets with the given upper bounds.
+    class Histogram
+    {
+    public:
+        explicit Histogram(const std::vector<double>& bounds);
+
+        // Records one observation.
+        void observe(const double value);
+
+        // Getters:
+
+        // Returns bucket upper bounds, excluding +Inf.
+        const std::vector<double>& getBounds(void) const;
+
+        // Returns observations at or below bound i (+Inf for the last).
+        const uint64_t getCumulativeCount(const size_t bucket) const;
+
+        // Returns number of observations.
+        const uint64_t getCount(void) const;
+
+        // Returns sum of observations.
+        const double getSum(void) const;
+
+    private:
+        struct Shard{
+            std::unique_ptr<std::atomic<uint64_t>[]> buckets;
+            std::atomic<uint64_t> count;
+            std::atomic<double> sum;
+        };
+
+        std::vector<double> m_bounds;
+        Shard m_shards[Shards];
+    };
+
+    // Empty constructor.
+    explicit Metrics(void);
+
+    // Empty destructor.
+    virtual ~Metrics(void);
+
+    // Returns the counter with name and labels (e.g. pool="Actor"),
+    // creating it on first use.
+    Counter* getCounter(const std::string& name,
+                        const std::string& help,
+                        const std::string& labels = "");
+
+    // Returns the gauge with name and labels, creating it on first use.
+    Gauge* getGauge(const std::string& name,
+                    const std::string& help,
+                    const std::string& labels = "");
+
+    // Returns the histogram with name and labels, creating it on first use
+    // with bounds, or millisecond bounds suited to frame timings if empty.
+    Histogram* getHistogram(const std::string& name,
+                            const std::string& help,
+                            const std::vector<double>& bounds =
+                                std::vector<double>(),
+                            const std::string& labels = "");
+
+    // Returns every metric in the Prometheus text exposition format.
+    std::string scrape(void);
+
+    // Returns the calling thread's shard index.
+    static const uint32_t getThreadSlot(void);
+
+private:
+    enum class Type{
+        Counter,
+        Gauge,
+        Histogram
+    };
+
+    // All metrics sharing a name.
+    struct Family{
+        Type type;
+        std::string help;
+        std::map<std::string, std::shared_ptr<Counter>> counters;
+        std::map<std::string, std::shared_ptr<Gauge>> gauges;
+        std::map<std::string, std::shared_ptr<Histogram>> histograms;
+    };
+
+    // Returns the family for name, creating it with type if needed.
+    Family& getFamily(const std::string& name,
+                      const std::string& help,
+                      const Type type);
+
+    std::map<std::string, Family> m_families;
+    std::mutex m_mutex;
+};
+
+// ========================================================================= //
+
+inline const std::vector<double>& Metrics::Histogram::getBounds(void) const{
+    return m_bounds;
+}
+
+// ========================================================================= //
+
+}
+
+// ========================================================================= //
+
+#endif
+
+// ========================================================================= //
\ No newline at end of file
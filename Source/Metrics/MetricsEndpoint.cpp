@@ -0,0 +1,263 @@
+// ========================================================================= //
+// Talos - A 3D game engine with network multiplayer.
+// Copyright(C) 2015 Jordan Sparks <unixunited@live.com>
+//
+// This program is free software; you can redistribute it and / or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 3
+// of the License, or(at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+// ========================================================================= //
+// File: MetricsEndpoint.cpp
+// Author: Jordan Sparks <unixunited@live.com>
+// ========================================================================= //
+// Implements MetricsEndpoint class.
+// ========================================================================= //
+
+#include "Metrics.hpp"
+#include "MetricsEndpoint.hpp"
+
+#ifdef WIN32
+#include <winsock2.h>
+typedef int socklen_t;
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#define INVALID_SOCKET (-1)
+#define SD_BOTH SHUT_RDWR
+#define closesocket close
+typedef int SOCKET;
+#endif
+
+// ========================================================================= //
+
+namespace Talos
+{;
+
+// ========================================================================= //
+
+static const uintptr_t SNoSocket = static_cast<uintptr_t>(INVALID_SOCKET);
+
+// A scraper that stalls longer than this is dropped.
+static const int SClientTimeoutMs = 2000;
+
+#ifdef MSG_NOSIGNAL
+static const int SSendFlags = MSG_NOSIGNAL;
+#else
+static const int SSendFlags = 0;
+#endif
+
+// ========================================================================= //
+
+MetricsEndpoint::MetricsEndpoint(void) :
+m_socket(SNoSocket),
+m_client(SNoSocket),
+m_thread(),
+m_running(false)
+{
+
+}
+
+// ========================================================================= //
+
+MetricsEndpoint::~MetricsEndpoint(void)
+{
+    this->stop();
+}
+
+// ========================================================================= //
+
+bool MetricsEndpoint::start(const uint16_t port)
+{
+    this->stop();
+
+#ifdef WIN32
+    // Reference counted, so this is safe alongside RakNet.
+    WSADATA data;
+    if (WSAStartup(MAKEWORD(2, 2), &data) != 0){
+        return false;
+    }
+#endif
+
+    const SOCKET s = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (s == INVALID_SOCKET){
+        Talos::Log::getSingleton().log("Metrics endpoint: socket() failed");
+        return false;
+    }
+
+    sockaddr_in addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    if (bind(s, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+        listen(s, 4) != 0){
+        Talos::Log::getSingleton().log("Metrics endpoint: unable to listen "
+                                       "on port " + toString(port));
+        closesocket(s);
+        return false;
+    }
+
+    m_socket = static_cast<uintptr_t>(s);
+    m_running.store(true);
+    m_thread = std::thread(&MetricsEndpoint::run, this);
+
+    Talos::Log::getSingleton().log("Serving metrics on "
+                                   "http://127.0.0.1:" + toString(port) +
+                                   "/metrics");
+
+    return true;
+}
+
+// ========================================================================= //
+
+void MetricsEndpoint::stop(void)
+{
+    if (m_running.load() == false){
+        return;
+    }
+
+    // Shutting the sockets down wakes a blocked select(), accept() or recv(),
+    // so a stalled scraper cannot hold up the join.
+    m_running.store(false);
+    shutdown(static_cast<SOCKET>(m_socket), SD_BOTH);
+    {
+        std::lock_guard<std::mutex> lock(m_clientMutex);
+        if (m_client != SNoSocket){
+            shutdown(static_cast<SOCKET>(m_client), SD_BOTH);
+        }
+    }
+    m_thread.join();
+
+    closesocket(static_cast<SOCKET>(m_socket));
+    m_socket = SNoSocket;
+
+#ifdef WIN32
+    WSACleanup();
+#endif
+}
+
+// ========================================================================= //
+
+void MetricsEndpoint::run(void)
+{
+    const SOCKET s = static_cast<SOCKET>(m_socket);
+
+    while (m_running.load()){
+        fd_set readable;
+        FD_ZERO(&readable);
+        FD_SET(s, &readable);
+        timeval timeout;
+        timeout.tv_sec = 0;
+        timeout.tv_usec = 100000;
+
+        if (select(static_cast<int>(s) + 1, &readable, nullptr, nullptr,
+                   &timeout) <= 0){
+            continue;
+        }
+
+        const SOCKET client = accept(s, nullptr, nullptr);
+        if (client == INVALID_SOCKET){
+            continue;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_clientMutex);
+            if (m_running.load() == false){
+                closesocket(client);
+                break;
+            }
+            m_client = static_cast<uintptr_t>(client);
+        }
+
+        this->serve(static_cast<uintptr_t>(client));
+
+        {
+            std::lock_guard<std::mutex> lock(m_clientMutex);
+            m_client = SNoSocket;
+        }
+        closesocket(client);
+    }
+}
+
+// ========================================================================= //
+
+void MetricsEndpoint::serve(const uintptr_t client)
+{
+    const SOCKET s = static_cast<SOCKET>(client);
+
+    // Bound both directions so an idle or half-open client cannot block the
+    // thread indefinitely.
+#ifdef WIN32
+    const DWORD timeout = SClientTimeoutMs;
+#else
+    timeval timeout;
+    timeout.tv_sec = SClientTimeoutMs / 1000;
+    timeout.tv_usec = (SClientTimeoutMs % 1000) * 1000;
+#endif
+    setsockopt(s, SOL_SOCKET, SO_RCVTIMEO,
+               reinterpret_cast<const char*>(&timeout), sizeof(timeout));
+    setsockopt(s, SOL_SOCKET, SO_SNDTIMEO,
+               reinterpret_cast<const char*>(&timeout), sizeof(timeout));
+#ifdef SO_NOSIGPIPE
+    // No MSG_NOSIGNAL on BSD-derived systems.
+    const int noSigPipe = 1;
+    setsockopt(s, SOL_SOCKET, SO_NOSIGPIPE, &noSigPipe, sizeof(noSigPipe));
+#endif
+
+    // Only the request line matters; headers are read and ignored.
+    std::string request;
+    char buffer[1024];
+    while (request.find("\r\n\r\n") == std::string::npos &&
+           request.size() < 8192){
+        const int received = recv(s, buffer, sizeof(buffer), 0);
+        if (received <= 0){
+            return;
+        }
+        request.append(buffer, received);
+    }
+
+    std::string status = "200 OK";
+    std::string body;
+    if (request.compare(0, 13, "GET /metrics ") == 0 ||
+        request.compare(0, 6, "GET / ") == 0){
+        body = Metrics::getSingleton().scrape();
+    }
+    else{
+        status = "404 Not Found";
+        body = "Not found\n";
+    }
+
+    const std::string response = "HTTP/1.0 " + status + "\r\n"
+        "Content-Type: text/plain; version=0.0.4\r\n"
+        "Content-Length: " + toString(body.size()) + "\r\n"
+        "Connection: close\r\n\r\n" + body;
+
+    size_t sent = 0;
+    while (sent < response.size()){
+        const int n = send(s, response.data() + sent,
+                           static_cast<int>(response.size() - sent),
+                           SSendFlags);
+        if (n <= 0){
+            return;
+        }
+        sent += n;
+    }
+}
+
+// ========================================================================= //
+
+}
+
+// ========================================================================= //
\ No newline at end of file
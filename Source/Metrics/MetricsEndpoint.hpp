@@ -0,0 +1,92 @@
+// ========================================================================= //
+// Talos - A 3D game engine with network multiplayer.
+// Copyright(C) 2015 Jordan Sparks <unixunited@live.com>
+//
+// This program is free software; you can redistribute it and / or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 3
+// of the License, or(at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+// ========================================================================= //
+// File: MetricsEndpoint.hpp
+// Author: Jordan Sparks <unixunited@live.com>
+// ========================================================================= //
+// Defines MetricsEndpoint class.
+// ========================================================================= //
+
+#ifndef __METRICSENDPOINT_HPP__
+#define __METRICSENDPOINT_HPP__
+
+// ========================================================================= //
+
+#include "stdafx.hpp"
+
+#include <atomic>
+#include <mutex>
+
+// ========================================================================= //
+
+namespace Talos
+{;
+
+// ========================================================================= //
+// Serves Metrics::scrape() over HTTP on the loopback interface, e.g.
+// "curl http://127.0.0.1:9100/metrics", from its own thread.
+class MetricsEndpoint final
+{
+public:
+    // Default initializes member data.
+    explicit MetricsEndpoint(void);
+
+    // Calls stop().
+    ~MetricsEndpoint(void);
+
+    // Listens on 127.0.0.1:port. Returns false if the port cannot be bound.
+    bool start(const uint16_t port);
+
+    // Shuts down the listening and client sockets, joins the serving thread,
+    // then closes the listening socket.
+    void stop(void);
+
+    // Getters:
+
+    // Returns true if serving.
+    const bool isRunning(void) const;
+
+private:
+    // Accepts connections until stopped.
+    void run(void);
+
+    // Reads one request and writes the response.
+    void serve(const uintptr_t client);
+
+    uintptr_t m_socket;
+    // The connection being served, so stop() can interrupt it.
+    uintptr_t m_client;
+    std::mutex m_clientMutex;
+    std::thread m_thread;
+    std::atomic<bool> m_running;
+};
+
+// ========================================================================= //
+
+inline const bool MetricsEndpoint::isRunning(void) const{
+    return m_running.load();
+}
+
+// ========================================================================= //
+
+}
+
+// ========================================================================= //
+
+#endif
+
+// ========================================================================= //
\ No newline at end of file
@@ -376,11 +376,11 @@ uint32_t Client::chat(const std::string& msg)
 
 // ========================================================================= //
 
-uint32_t Client::sendCommand(CommandPtr command)
+uint32_t Client::sendCommand(const CommandType type)
 {
     RakNet::BitStream bs;
     bs.Write(static_cast<RakNet::MessageID>(NetMessage::ClientCommand));
-    bs.Write(command->type);
+    bs.Write(type);
     bs.Write(++m_lastInputSequenceNumber);
 
     return this->send(bs, IMMEDIATE_PRIORITY, RELIABLE_ORDERED);
@@ -71,7 +71,7 @@ public:
     // Sends chat message to server.
     virtual uint32_t chat(const std::string& msg) override;
 
-    virtual uint32_t sendCommand(CommandPtr command) override;
+    virtual uint32_t sendCommand(const CommandType type) override;
 
     virtual const uint32_t getLastInputSequenceNumber(void) const override;
 
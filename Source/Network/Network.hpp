@@ -26,6 +26,7 @@
 
 // ========================================================================= //
 
+#include "Command/CommandTypes.hpp"
 #include "NetMessage.hpp"
 #include "stdafx.hpp"
 #include "Update.hpp"
@@ -115,7 +116,7 @@ public:
 
     virtual void endGame(void) { }
 
-    virtual uint32_t sendCommand(CommandPtr command) {
+    virtual uint32_t sendCommand(const CommandType type) {
         return 0;
     }
 
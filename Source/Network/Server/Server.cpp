@@ -26,6 +26,7 @@
 #include "Component/ComponentMessage.hpp"
 #include "Config/Config.hpp"
 #include "Entity/Entity.hpp"
+#include "Metrics/MetricsEndpoint.hpp"
 #include "Network/NetData.hpp"
 #include "Network/Update.hpp"
 #include "Server.hpp"
@@ -38,7 +39,15 @@ m_packet(nullptr),
 m_tickRate(8),
 m_tick(),
 m_clients(),
-m_commandRepo(new CommandRepository())
+m_commandRepo(new CommandRepository()),
+m_metricsEndpoint(new Talos::MetricsEndpoint()),
+m_packetsReceived(nullptr),
+m_bytesReceived(nullptr),
+m_messagesSent(nullptr),
+m_bytesSent(nullptr),
+m_clientCount(nullptr),
+m_updateTime(nullptr),
+m_metricsTimer()
 {
     this->setMode(Network::Mode::Server);
 }
@@ -59,12 +68,17 @@ void Server::init(const int port, const std::string& username)
     bool simulate = false;
     float packetLoss = 0.f;
     int delay = 0;
+    bool metrics = false;
+    int metricsPort = 0;
 
     // Load server settings from config file.
     Talos::Config c("Data/Network/net.cfg");
     if (c.isLoaded()){
         maxClients = c.parseInt("core", "maxClients");
 
+        metrics = c.parseBool("metrics", "active");
+        metricsPort = c.parseInt("metrics", "port");
+
         simulate = c.parseBool("simulator", "active");
         if (simulate){
             packetLoss = c.parseReal("simulator", "packetLoss");
@@ -86,6 +100,26 @@ void Server::init(const int port, const std::string& username)
         m_peer->ApplyNetworkSimulator(packetLoss, delay, 0);
     }
 
+    // Register metrics and serve them on the loopback interface.
+    Talos::Metrics& registry = Talos::Metrics::getSingleton();
+    m_packetsReceived = registry.getCounter("talos_net_packets_received_total",
+                                            "Packets received by the server.");
+    m_bytesReceived = registry.getCounter("talos_net_bytes_received_total",
+                                          "Bytes received by the server.");
+    m_messagesSent = registry.getCounter("talos_net_messages_sent_total",
+                                         "Messages sent by the server, "
+                                         "broadcasts counted once.");
+    m_bytesSent = registry.getCounter("talos_net_bytes_sent_total",
+                                      "Bytes sent by the server, "
+                                      "broadcasts counted once.");
+    m_clientCount = registry.getGauge("talos_net_clients",
+                                      "Connected clients.");
+    m_updateTime = registry.getHistogram("talos_net_update_ms",
+                                         "Time spent in Server::update.");
+    if (metrics && metricsPort > 0){
+        m_metricsEndpoint->start(static_cast<uint16_t>(metricsPort));
+    }
+
     // Add local player instance.
     this->addPlayer(0, username);
     this->setLocalPlayer(&this->getPlayer(0));
@@ -98,6 +132,8 @@ void Server::init(const int port, const std::string& username)
 
 void Server::destroy(void)
 {
+    m_metricsEndpoint->stop();
+
     RakNet::RakPeerInterface::DestroyInstance(m_peer);
 
     this->clearPlayerList();
@@ -110,10 +146,15 @@ void Server::destroy(void)
 
 void Server::update(void)
 {
+    m_metricsTimer.reset();
+
     // Receive incoming packets.
     for (m_packet = m_peer->Receive();
          m_packet;
          m_peer->DeallocatePacket(m_packet), m_packet = m_peer->Receive()){
+        m_packetsReceived->add();
+        m_bytesReceived->add(m_packet->length);
+
         switch (m_packet->data[0]){
         default:
             break;
@@ -248,7 +289,10 @@ void Server::update(void)
         }
     }
     
+    m_clientCount->set(static_cast<double>(m_clients.size()));
+
     if (!this->gameActive()){
+        m_updateTime->observe(m_metricsTimer.getMicroseconds() / 1000.0);
         return;
     }
 
@@ -266,6 +310,8 @@ void Server::update(void)
 
         m_tick.reset();
     }
+
+    m_updateTime->observe(m_metricsTimer.getMicroseconds() / 1000.0);
 }
 
 // ========================================================================= //
@@ -311,6 +357,9 @@ uint32_t Server::send(const RakNet::AddressOrGUID identifier,
                       const PacketPriority priority,
                       const PacketReliability reliability)
 {
+    m_messagesSent->add();
+    m_bytesSent->add(bs.GetNumberOfBytesUsed());
+
     return m_peer->Send(&bs,
                         priority,
                         reliability,
@@ -326,6 +375,9 @@ uint32_t Server::broadcast(const RakNet::BitStream& bs,
                            const PacketReliability reliability,
                            const RakNet::SystemAddress& exclude)
 {
+    m_messagesSent->add();
+    m_bytesSent->add(bs.GetNumberOfBytesUsed());
+
     m_peer->Send(&bs,
                  priority,
                  reliability,
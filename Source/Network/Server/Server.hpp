@@ -26,6 +26,7 @@
 
 // ========================================================================= //
 
+#include "Metrics/Metrics.hpp"
 #include "Network/Network.hpp"
 
 // ========================================================================= //
@@ -42,6 +43,10 @@ namespace std{
     };
 }
 
+// ========================================================================= //
+
+namespace Talos{ class MetricsEndpoint; }
+
 // ========================================================================= //
 // Operates network functionality for running a server with multiple clients.
 class Server final : public Network
@@ -123,6 +128,16 @@ private:
 
     // Command repo for processing client inputs.
     std::shared_ptr<CommandRepository> m_commandRepo;
+
+    // Runtime metrics, served locally if enabled in net.cfg.
+    std::shared_ptr<Talos::MetricsEndpoint> m_metricsEndpoint;
+    Talos::Metrics::Counter* m_packetsReceived;
+    Talos::Metrics::Counter* m_bytesReceived;
+    Talos::Metrics::Counter* m_messagesSent;
+    Talos::Metrics::Counter* m_bytesSent;
+    Talos::Metrics::Gauge* m_clientCount;
+    Talos::Metrics::Histogram* m_updateTime;
+    Ogre::Timer m_metricsTimer;
 };
 
 // ========================================================================= //
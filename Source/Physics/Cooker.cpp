@@ -28,7 +28,9 @@
 Cooker::Cooker(PxPhysics* physx, PxCooking* cookingInterface) :
 m_physx(physx),
 m_cookingInterface(cookingInterface),
-m_defaultMaterial(nullptr)
+m_defaultMaterial(nullptr),
+m_triangleMeshes(),
+m_convexMeshes()
 {
 
 }
@@ -37,7 +39,7 @@ m_defaultMaterial(nullptr)
 
 Cooker::~Cooker(void)
 {
-
+    this->clearCache();
 }
 
 // ========================================================================= //
@@ -515,11 +517,33 @@ PxTriangleMesh* Cooker::createTriangleMesh(Ogre::MeshPtr mesh,
                                            Params& params,
                                            AddedMaterials* addedMaterials)
 {
+    // Per-triangle materials make the result specific to this call.
+    const bool cacheable = (addedMaterials == nullptr &&
+                            params.materialBindings.empty());
+    const std::string key = this->getCacheKey(mesh, params);
+    if (cacheable){
+        std::map<std::string, CachedTriangleMesh>::iterator itr =
+            m_triangleMeshes.find(key);
+        if (itr != m_triangleMeshes.end()){
+            ++itr->second.users;
+            return itr->second.mesh;
+        }
+    }
+
     PxDefaultMemoryOutputStream stream;
     this->cookTriangleMesh(mesh, stream, params, addedMaterials);
     if (stream.getData() == nullptr) return nullptr;
 
-    return m_physx->createTriangleMesh(PxDefaultMemoryInputData(stream.getData(), stream.getSize()));
+    PxTriangleMesh* triangleMesh = m_physx->createTriangleMesh(PxDefaultMemoryInputData(stream.getData(), stream.getSize()));
+    if (cacheable && triangleMesh){
+        CachedTriangleMesh cached;
+        cached.mesh = triangleMesh;
+        cached.size = stream.getSize();
+        cached.users = 1;
+        m_triangleMeshes[key] = cached;
+    }
+
+    return triangleMesh;
 }
 
 // ========================================================================= //
@@ -527,11 +551,85 @@ PxTriangleMesh* Cooker::createTriangleMesh(Ogre::MeshPtr mesh,
 PxConvexMesh* Cooker::createConvexMesh(Ogre::MeshPtr mesh,
                                        Params& params)
 {
+    const std::string key = this->getCacheKey(mesh, params);
+    std::map<std::string, PxConvexMesh*>::iterator itr =
+        m_convexMeshes.find(key);
+    if (itr != m_convexMeshes.end()){
+        return itr->second;
+    }
+
     PxDefaultMemoryOutputStream stream;
     this->cookConvexMesh(mesh, stream, params);
     if (stream.getData() == nullptr) return nullptr;
 
-    return m_physx->createConvexMesh(PxDefaultMemoryInputData(stream.getData(), stream.getSize()));
+    PxConvexMesh* convexMesh = m_physx->createConvexMesh(PxDefaultMemoryInputData(stream.getData(), stream.getSize()));
+    if (convexMesh){
+        m_convexMeshes[key] = convexMesh;
+    }
+
+    return convexMesh;
+}
+
+// ========================================================================= //
+
+void Cooker::releaseTriangleMesh(PxTriangleMesh* triangleMesh)
+{
+    for (std::map<std::string, CachedTriangleMesh>::iterator itr =
+             m_triangleMeshes.begin();
+         itr != m_triangleMeshes.end();
+         ++itr){
+        if (itr->second.mesh == triangleMesh){
+            if (--itr->second.users == 0){
+                triangleMesh->release();
+                m_triangleMeshes.erase(itr);
+            }
+            return;
+        }
+    }
+
+    triangleMesh->release();
+}
+
+// ========================================================================= //
+
+void Cooker::clearCache(void)
+{
+    for (auto& i : m_triangleMeshes){
+        i.second.mesh->release();
+    }
+    m_triangleMeshes.clear();
+
+    for (auto& i : m_convexMeshes){
+        i.second->release();
+    }
+    m_convexMeshes.clear();
+}
+
+// ========================================================================= //
+
+std::string Cooker::getCacheKey(Ogre::MeshPtr mesh,
+                                const Params& params) const
+{
+    return mesh->getName() + "|" +
+        Ogre::StringConverter::toString(params.scale) +
+        (params.addBackfaces ? "|b" : "");
+}
+
+// ========================================================================= //
+
+// Getters:
+
+// ========================================================================= //
+
+const size_t Cooker::getTriangleMeshSize(PxTriangleMesh* triangleMesh) const
+{
+    for (auto& i : m_triangleMeshes){
+        if (i.second.mesh == triangleMesh){
+            return i.second.size;
+        }
+    }
+
+    return 0;
 }
 
 // ========================================================================= //
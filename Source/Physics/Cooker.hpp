@@ -93,21 +93,52 @@ public:
                         PxOutputStream& outputStream,
                         Params& params = Params());
 
+    // Cooks the mesh once per mesh name, scale and backface setting; later
+    // calls share the cooked mesh. Meshes with material bindings are cooked
+    // every time. Callers that stream meshes out pair each call with
+    // releaseTriangleMesh().
     PxTriangleMesh* createTriangleMesh(Ogre::MeshPtr mesh,
                                        Params& params = Params(),
                                        AddedMaterials* addedMaterials = nullptr);
 
+    // Cooks the mesh once per mesh name and scale.
     PxConvexMesh* createConvexMesh(Ogre::MeshPtr mesh,
                                    Params& params = Params());
 
+    // Drops one use of a mesh returned by createTriangleMesh(). A cached
+    // mesh is released once no caller uses it; meshes cooked outside the
+    // cache are released at once. Shapes using them keep them alive.
+    void releaseTriangleMesh(PxTriangleMesh* triangleMesh);
+
+    // Releases cached cooked meshes. Shapes using them keep them alive.
+    void clearCache(void);
+
+    // Getters:
+
+    // Returns cooked size in bytes of a cached triangle mesh, 0 if it is not
+    // cached.
+    const size_t getTriangleMeshSize(PxTriangleMesh* triangleMesh) const;
+
     // Setters:
 
     void setDefaultMaterial(PxMaterial* material);
 
 private:
+    // Returns cache key for a cooked mesh.
+    std::string getCacheKey(Ogre::MeshPtr mesh, const Params& params) const;
+
+    struct CachedTriangleMesh{
+        PxTriangleMesh* mesh;
+        size_t size;
+        // createTriangleMesh() calls not yet released.
+        uint32_t users;
+    };
+
     PxPhysics* m_physx;
     PxCooking* m_cookingInterface;
     PxMaterial* m_defaultMaterial;
+    std::map<std::string, CachedTriangleMesh> m_triangleMeshes;
+    std::map<std::string, PxConvexMesh*> m_convexMeshes;
 };
 
 // ========================================================================= //
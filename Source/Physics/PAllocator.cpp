@@ -0,0 +1,523 @@
+// ========================================================================= //
+// Talos - A 3D game engine with network multiplayer.
+// Copyright(C) 2015 Jordan Sparks <unixunited@live.com>
+//
+// This program is free software; you can redistribute it and / or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 3
+// of the License, or(at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+// ========================================================================= //
+// File: PAllocator.cpp
+// Author: Jordan Sparks <unixunited@live.com>
+// ========================================================================= //
+// Implements PAllocator class.
+// ========================================================================= //
+
+#include "PAllocator.hpp"
+
+#include <cstdlib>
+#include <cstring>
+
+// ========================================================================= //
+
+// Size of the chunks pools carve blocks from. Chunks are aligned to their
+// size so a block's chunk, and through it its owning thread, is found by 
+// masking the block's address.
+static const size_t SChunkSize = 64 * 1024;
+
+// Bytes at the start of each chunk holding its owner, keeping blocks 16-byte
+// aligned.
+static const size_t SChunkHeaderSize = 16;
+
+// ========================================================================= //
+
+#ifdef _MSC_VER
+#define TALOS_THREAD_LOCAL __declspec(thread)
+#else
+#define TALOS_THREAD_LOCAL __thread
+#endif
+
+// The calling thread's cache, valid while SThreadGeneration matches the
+// allocator's generation.
+static TALOS_THREAD_LOCAL void* SThreadCache = nullptr;
+static TALOS_THREAD_LOCAL uint32_t SThreadGeneration = 0;
+static std::atomic<uint32_t> SNextGeneration(0);
+
+// ========================================================================= //
+
+// Source file or type name fragments identifying each category, checked in
+// order; anything unmatched is attributed to the scene.
+static const struct{
+    const char* fragment;
+    PAllocator::Category category;
+} SClassifiers[] = {
+    { "Cooking", PAllocator::Cooking },
+    { "CharacterKinematic", PAllocator::Controllers },
+    { "Extensions", PAllocator::Extensions },
+    { "RenderBuffer", PAllocator::DebugRender },
+    { "Visualiz", PAllocator::DebugRender },
+    { "Pvd", PAllocator::Debugger },
+    { "pvd", PAllocator::Debugger },
+    { "Foundation", PAllocator::Other }
+};
+
+static const char* SCategoryNames[] = {
+    "Scene",
+    "Cooking",
+    "Controllers",
+    "Extensions",
+    "DebugRender",
+    "Debugger",
+    "Other"
+};
+
+// ========================================================================= //
+
+static void* SAlignedAlloc(const size_t size, const size_t align)
+{
+#ifdef _MSC_VER
+    return _aligned_malloc(size, align);
+#else
+    void* p = nullptr;
+    return (posix_memalign(&p, align, size) == 0) ? p : nullptr;
+#endif
+}
+
+// ========================================================================= //
+
+static void SAlignedFree(void* p)
+{
+#ifdef _MSC_VER
+    _aligned_free(p);
+#else
+    free(p);
+#endif
+}
+
+// ========================================================================= //
+
+// Resets every counter of c to zero.
+template<typename T>
+static void SClear(T& c)
+{
+    c.liveBytes.store(0);
+    c.peakBytes.store(0);
+    c.liveAllocations.store(0);
+    c.allocations.store(0);
+    c.largeAllocations.store(0);
+}
+
+// ========================================================================= //
+
+struct PAllocator::ThreadCache{
+    Pool pools[SizeClasses];
+    // Chunks carved by this thread.
+    std::vector<void*> chunks;
+    // Lookups already resolved by this thread.
+    std::unordered_map<const char*, uint32_t> types;
+    std::unordered_map<const char*, Category> files;
+};
+
+// ========================================================================= //
+
+PAllocator::PAllocator(void) :
+m_total(),
+m_generation(++SNextGeneration),
+m_typeNames(),
+m_typesByName(),
+m_caches(),
+m_largeThreshold(64 * 1024),
+m_mutex()
+{
+    static_assert(sizeof(Header) == 16, "PhysX needs 16-byte alignment");
+
+    Talos::Metrics& metrics = Talos::Metrics::getSingleton();
+    for (int i = 0; i < CategoryCount; ++i){
+        SClear(m_categories[i]);
+        m_gauges[i] = metrics.getGauge(
+            "talos_physx_bytes", "PhysX memory in use.",
+            "category=\"" + std::string(SCategoryNames[i]) + "\"");
+    }
+    SClear(m_total);
+    for (uint32_t i = 0; i < MaxTypes; ++i){
+        SClear(m_types[i]);
+    }
+
+    m_typeNames.reserve(MaxTypes);
+}
+
+// ========================================================================= //
+
+PAllocator::~PAllocator(void)
+{
+    for (std::vector<ThreadCache*>::iterator itr = m_caches.begin();
+         itr != m_caches.end();
+         ++itr){
+        for (std::vector<void*>::iterator chunk = (*itr)->chunks.begin();
+             chunk != (*itr)->chunks.end();
+             ++chunk){
+            SAlignedFree(*chunk);
+        }
+        delete *itr;
+    }
+}
+
+// ========================================================================= //
+
+void* PAllocator::allocate(size_t size, 
+                           const char* typeName, 
+                           const char* filename,
+                           int line)
+{
+    const size_t blockSize = size + sizeof(Header);
+    ThreadCache* cache = this->getCache();
+
+    Header* header = nullptr;
+    uint16_t sizeClass = NotPooled;
+    if (size <= MaxPooledSize){
+        sizeClass = static_cast<uint16_t>((blockSize - 1) / 16);
+        Pool& pool = cache->pools[sizeClass];
+
+        if (pool.local == nullptr){
+            // Take back blocks other threads have freed.
+            pool.local = pool.remote.exchange(nullptr, 
+                                              std::memory_order_acquire);
+        }
+        if (pool.local == nullptr){
+            // Carve a new chunk into a free list of blocks.
+            const size_t stride = (sizeClass + 1) * 16;
+            char* chunk = static_cast<char*>(SAlignedAlloc(SChunkSize, 
+                                                           SChunkSize));
+            if (chunk == nullptr){
+                return nullptr;
+            }
+            *reinterpret_cast<ThreadCache**>(chunk) = cache;
+            cache->chunks.push_back(chunk);
+            for (size_t offset = SChunkHeaderSize; 
+                 offset + stride <= SChunkSize; 
+                 offset += stride){
+                void* block = chunk + offset;
+                *static_cast<void**>(block) = pool.local;
+                pool.local = block;
+            }
+        }
+
+        header = static_cast<Header*>(pool.local);
+        pool.local = *static_cast<void**>(pool.local);
+    }
+    else{
+        header = static_cast<Header*>(SAlignedAlloc(blockSize, 16));
+        if (header == nullptr){
+            return nullptr;
+        }
+    }
+
+    const Category category = this->classify(cache, typeName, filename);
+    header->size = static_cast<uint32_t>(size);
+    header->category = static_cast<uint16_t>(category);
+    header->sizeClass = sizeClass;
+    header->type = this->getType(cache, typeName);
+
+    this->track(m_categories[category], size);
+    this->track(m_types[header->type], size);
+    this->track(m_total, size);
+    m_gauges[category]->add(static_cast<double>(size));
+
+    return header + 1;
+}
+
+// ========================================================================= //
+
+void PAllocator::deallocate(void* ptr)
+{
+    if (ptr == nullptr){
+        return;
+    }
+
+    Header* header = static_cast<Header*>(ptr) - 1;
+
+    this->untrack(m_categories[header->category], header->size);
+    this->untrack(m_types[header->type], header->size);
+    this->untrack(m_total, header->size);
+    m_gauges[header->category]->add(-static_cast<double>(header->size));
+
+    if (header->sizeClass != NotPooled){
+        char* chunk = reinterpret_cast<char*>(
+            reinterpret_cast<uintptr_t>(header) & ~(SChunkSize - 1));
+        ThreadCache* owner = *reinterpret_cast<ThreadCache**>(chunk);
+        Pool& pool = owner->pools[header->sizeClass];
+
+        if (SThreadGeneration == m_generation && SThreadCache == owner){
+            *reinterpret_cast<void**>(header) = pool.local;
+            pool.local = header;
+        }
+        else{
+            // Push onto the owner's remote list. Only the owner removes
+            // from it, and only all at once, so there is no ABA problem.
+            void* head = pool.remote.load(std::memory_order_relaxed);
+            do{
+                *reinterpret_cast<void**>(header) = head;
+            } while (pool.remote.compare_exchange_weak(
+                head, header, 
+                std::memory_order_release, 
+                std::memory_order_relaxed) == false);
+        }
+    }
+    else{
+        SAlignedFree(header);
+    }
+}
+
+// ========================================================================= //
+
+PAllocator::ThreadCache* PAllocator::getCache(void)
+{
+    if (SThreadGeneration == m_generation){
+        return static_cast<ThreadCache*>(SThreadCache);
+    }
+
+    // First allocation on this thread. Threads that exit keep their cache
+    // until the allocator is destroyed; blocks freed into it afterwards
+    // are not reused.
+    ThreadCache* cache = new ThreadCache();
+    for (size_t i = 0; i < SizeClasses; ++i){
+        cache->pools[i].local = nullptr;
+        cache->pools[i].remote.store(nullptr);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_caches.push_back(cache);
+    }
+
+    SThreadCache = cache;
+    SThreadGeneration = m_generation;
+    return cache;
+}
+
+// ========================================================================= //
+
+const PAllocator::Category PAllocator::classify(ThreadCache* cache,
+                                                const char* typeName, 
+                                                const char* filename)
+{
+    static const size_t count = sizeof(SClassifiers) / sizeof(SClassifiers[0]);
+
+    // Match on the source file first, caching the result by file. 
+    // CategoryCount marks files that matched nothing.
+    Category category = CategoryCount;
+    if (filename != nullptr){
+        std::unordered_map<const char*, Category>::iterator itr = 
+            cache->files.find(filename);
+        if (itr != cache->files.end()){
+            category = itr->second;
+        }
+        else{
+            for (size_t i = 0; i < count; ++i){
+                if (std::strstr(filename, SClassifiers[i].fragment)){
+                    category = SClassifiers[i].category;
+                    break;
+                }
+            }
+            cache->files[filename] = category;
+        }
+    }
+    if (category != CategoryCount){
+        return category;
+    }
+
+    // Fall back to the type name.
+    if (typeName != nullptr){
+        for (size_t i = 0; i < count; ++i){
+            if (std::strstr(typeName, SClassifiers[i].fragment)){
+                return SClassifiers[i].category;
+            }
+        }
+    }
+
+    return Scene;
+}
+
+// ========================================================================= //
+
+const uint32_t PAllocator::getType(ThreadCache* cache, const char* typeName)
+{
+    std::unordered_map<const char*, uint32_t>::iterator itr = 
+        cache->types.find(typeName);
+    if (itr != cache->types.end()){
+        return itr->second;
+    }
+
+    const std::string name = (typeName != nullptr) ? typeName : "<unnamed>";
+    uint32_t index = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        std::map<std::string, uint32_t>::iterator named = 
+            m_typesByName.find(name);
+        if (named != m_typesByName.end()){
+            index = named->second;
+        }
+        else if (m_typeNames.size() < MaxTypes){
+            index = static_cast<uint32_t>(m_typeNames.size());
+            m_typeNames.push_back((m_typeNames.size() + 1 < MaxTypes) ? 
+                                  name : "<other>");
+            m_typesByName[m_typeNames.back()] = index;
+        }
+        else{
+            index = MaxTypes - 1;
+        }
+    }
+
+    cache->types[typeName] = index;
+    return index;
+}
+
+// ========================================================================= //
+
+void PAllocator::track(Counters& c, const size_t size)
+{
+    const size_t live = c.liveBytes.fetch_add(
+        size, std::memory_order_relaxed) + size;
+    size_t peak = c.peakBytes.load(std::memory_order_relaxed);
+    while (live > peak && c.peakBytes.compare_exchange_weak(
+        peak, live, std::memory_order_relaxed) == false);
+
+    c.liveAllocations.fetch_add(1, std::memory_order_relaxed);
+    c.allocations.fetch_add(1, std::memory_order_relaxed);
+    if (size >= m_largeThreshold.load(std::memory_order_relaxed)){
+        c.largeAllocations.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+// ========================================================================= //
+
+void PAllocator::untrack(Counters& c, const size_t size)
+{
+    c.liveBytes.fetch_sub(size, std::memory_order_relaxed);
+    c.liveAllocations.fetch_sub(1, std::memory_order_relaxed);
+}
+
+// ========================================================================= //
+
+const PAllocator::Stats PAllocator::load(const Counters& c)
+{
+    Stats s;
+    s.liveBytes = c.liveBytes.load(std::memory_order_relaxed);
+    s.peakBytes = c.peakBytes.load(std::memory_order_relaxed);
+    s.liveAllocations = c.liveAllocations.load(std::memory_order_relaxed);
+    s.allocations = c.allocations.load(std::memory_order_relaxed);
+    s.largeAllocations = c.largeAllocations.load(std::memory_order_relaxed);
+    return s;
+}
+
+// ========================================================================= //
+
+void PAllocator::logReport(void) const
+{
+    const Stats total = load(m_total);
+    Talos::Log::getSingleton().log("PhysX memory: " + 
+                                   toString(total.liveBytes) + 
+                                   " bytes live, " +
+                                   toString(total.peakBytes) + " peak, " +
+                                   toString(total.allocations) + 
+                                   " allocations");
+
+    for (int i = 0; i < CategoryCount; ++i){
+        const Stats s = load(m_categories[i]);
+        if (s.allocations == 0){
+            continue;
+        }
+
+        Talos::Log::getSingleton().log("  " + 
+                                       std::string(SCategoryNames[i]) + ": " +
+                                       toString(s.liveBytes) + " live, " +
+                                       toString(s.peakBytes) + " peak, " +
+                                       toString(s.allocations) + 
+                                       " allocations (" +
+                                       toString(s.largeAllocations) + 
+                                       " large)");
+    }
+
+    // The types holding the most memory at their peak.
+    std::vector<std::pair<std::string, Stats>> types;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        for (size_t i = 0; i < m_typeNames.size(); ++i){
+            types.push_back(std::make_pair(m_typeNames[i], 
+                                           load(m_types[i])));
+        }
+    }
+    const size_t count = std::min<size_t>(types.size(), 10);
+    std::partial_sort(types.begin(), types.begin() + count, types.end(),
+                      [](const std::pair<std::string, Stats>& a,
+                         const std::pair<std::string, Stats>& b){
+        return a.second.peakBytes > b.second.peakBytes;
+    });
+    for (size_t i = 0; i < count; ++i){
+        const Stats& s = types[i].second;
+        Talos::Log::getSingleton().log("  " + types[i].first + ": " +
+                                       toString(s.liveBytes) + " live, " +
+                                       toString(s.peakBytes) + " peak, " +
+                                       toString(s.allocations) + 
+                                       " allocations");
+    }
+}
+
+// ========================================================================= //
+
+// Getters:
+
+// ========================================================================= //
+
+const PAllocator::Stats PAllocator::getStats(const Category category) const
+{
+    return load(m_categories[category]);
+}
+
+// ========================================================================= //
+
+const std::map<std::string, PAllocator::Stats> 
+PAllocator::getTypeStats(void) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    std::map<std::string, Stats> types;
+    for (size_t i = 0; i < m_typeNames.size(); ++i){
+        types[m_typeNames[i]] = load(m_types[i]);
+    }
+
+    return types;
+}
+
+// ========================================================================= //
+
+const size_t PAllocator::getLiveBytes(void) const
+{
+    return m_total.liveBytes.load(std::memory_order_relaxed);
+}
+
+// ========================================================================= //
+
+const size_t PAllocator::getPeakBytes(void) const
+{
+    return m_total.peakBytes.load(std::memory_order_relaxed);
+}
+
+// ========================================================================= //
+
+const char* PAllocator::getCategoryName(const Category category)
+{
+    return SCategoryNames[category];
+}
+
+// ========================================================================= //
\ No newline at end of file
@@ -0,0 +1,208 @@
+// ========================================================================= //
+// Talos - A 3D game engine with network multiplayer.
+// Copyright(C) 2015 Jordan Sparks <unixunited@live.com>
+//
+// This program is free software; you can redistribute it and / or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 3
+// of the License, or(at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+// ========================================================================= //
+// File: PAllocator.hpp
+// Author: Jordan Sparks <unixunited@live.com>
+// ========================================================================= //
+// Defines PAllocator class.
+// ========================================================================= //
+
+#ifndef __PALLOCATOR_HPP__
+#define __PALLOCATOR_HPP__
+
+// ========================================================================= //
+
+#include "stdafx.hpp"
+#include "Metrics/Metrics.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
+// ========================================================================= //
+
+using namespace physx;
+
+// ========================================================================= //
+// PhysX allocator that keeps live and peak byte counts per subsystem 
+// (categorised by the allocating PhysX source file) and per PhysX type name.
+// Small allocations, which PhysX makes in large numbers, come from 
+// size-class pools to limit heap fragmentation; the rest come from the 
+// 16-byte aligned heap PhysX requires. Each thread allocates from its own
+// pools, and blocks freed by another thread are handed back to the owner 
+// through a lock-free list, so PhysX's worker threads never contend on a 
+// lock. Statistics are atomic counters. Live bytes per category are 
+// published as gauges and the full breakdown can be logged with logReport().
+class PAllocator final : public PxAllocatorCallback
+{
+public:
+    // Subsystems allocations are attributed to.
+    enum Category{
+        Scene = 0,
+        Cooking,
+        Controllers,
+        Extensions,
+        DebugRender,
+        Debugger,
+        Other,
+
+        CategoryCount
+    };
+
+    // Statistics for a category or type name.
+    struct Stats{
+        size_t liveBytes;
+        size_t peakBytes;
+        uint32_t liveAllocations;
+        uint64_t allocations;
+        // Allocations at or above the large threshold.
+        uint64_t largeAllocations;
+    };
+
+    // Largest allocation (excluding bookkeeping) served by the pools.
+    static const size_t MaxPooledSize = 240;
+
+    // Most distinct type names tracked; later ones share the last entry.
+    static const uint32_t MaxTypes = 512;
+
+    // Creates gauges for each category.
+    explicit PAllocator(void);
+
+    // Frees every thread's pool chunks.
+    virtual ~PAllocator(void);
+
+    // PxAllocatorCallback implementation, called from any PhysX thread.
+    virtual void* allocate(size_t size, 
+                           const char* typeName, 
+                           const char* filename,
+                           int line) override;
+
+    virtual void deallocate(void* ptr) override;
+
+    // Writes per-category and largest per-type statistics to the log.
+    void logReport(void) const;
+
+    // Getters:
+
+    // Returns a snapshot of a category's statistics.
+    const Stats getStats(const Category category) const;
+
+    // Returns a snapshot of statistics per PhysX type name.
+    const std::map<std::string, Stats> getTypeStats(void) const;
+
+    // Returns total live bytes.
+    const size_t getLiveBytes(void) const;
+
+    // Returns the most bytes live at once.
+    const size_t getPeakBytes(void) const;
+
+    // Returns name of a category.
+    static const char* getCategoryName(const Category category);
+
+    // Setters:
+
+    // Sets the size from which allocations are counted as large.
+    void setLargeThreshold(const size_t size);
+
+private:
+    // Precedes every allocation, keeping the returned pointer 16-byte aligned.
+    struct Header{
+        uint32_t size;
+        uint16_t category;
+        // Pool size class, or NotPooled.
+        uint16_t sizeClass;
+        uint32_t type;
+        uint32_t pad;
+    };
+
+    static const uint16_t NotPooled = 0xFFFF;
+
+    // Atomic form of Stats.
+    struct Counters{
+        std::atomic<size_t> liveBytes;
+        std::atomic<size_t> peakBytes;
+        std::atomic<uint32_t> liveAllocations;
+        std::atomic<uint64_t> allocations;
+        std::atomic<uint64_t> largeAllocations;
+    };
+
+    // Free lists of one size class. local is only touched by the owning
+    // thread; other threads push onto remote, which the owner takes whole
+    // when local runs dry.
+    struct Pool{
+        void* local;
+        std::atomic<void*> remote;
+    };
+
+    // One thread's pools and lookup caches.
+    struct ThreadCache;
+
+    // Returns the calling thread's cache, creating it on first use.
+    ThreadCache* getCache(void);
+
+    // Returns the category of an allocation from its source file and type.
+    const Category classify(ThreadCache* cache,
+                            const char* typeName, 
+                            const char* filename);
+
+    // Returns the index of the type's statistics, adding it if needed.
+    const uint32_t getType(ThreadCache* cache, const char* typeName);
+
+    // Records an allocation of size bytes in c.
+    void track(Counters& c, const size_t size);
+
+    // Records a deallocation of size bytes in c.
+    void untrack(Counters& c, const size_t size);
+
+    // Returns a snapshot of c.
+    static const Stats load(const Counters& c);
+
+    // Pools for block sizes of 16 * (i + 1), header included.
+    static const size_t SizeClasses = (MaxPooledSize + sizeof(Header)) / 16;
+
+    Counters m_categories[CategoryCount];
+    Talos::Metrics::Gauge* m_gauges[CategoryCount];
+    Counters m_total;
+    Counters m_types[MaxTypes];
+
+    // Distinguishes allocators whose thread caches are stored per thread.
+    const uint32_t m_generation;
+
+    // Guarded by m_mutex. Type names are string literals, so threads cache
+    // lookups by pointer; equal names from different translation units 
+    // share statistics.
+    std::vector<std::string> m_typeNames;
+    std::map<std::string, uint32_t> m_typesByName;
+    std::vector<ThreadCache*> m_caches;
+
+    std::atomic<size_t> m_largeThreshold;
+    mutable std::mutex m_mutex;
+};
+
+// ========================================================================= //
+
+// Setters:
+
+inline void PAllocator::setLargeThreshold(const size_t size){
+    m_largeThreshold = size;
+}
+
+// ========================================================================= //
+
+#endif
+
+// ========================================================================= //
\ No newline at end of file
@@ -36,7 +36,12 @@ m_cpuDispatcher(nullptr),
 m_controllerManager(nullptr),
 m_debugDrawer(nullptr),
 m_useDebugDrawer(false),
-m_cooker(new Cooker(physics->m_physx, physics->m_cookingInterface))
+m_cooker(new Cooker(physics->m_physx, physics->m_cookingInterface)),
+m_timer(),
+m_simulateTime(Talos::Metrics::getSingleton().getHistogram(
+    "talos_physics_simulate_ms", "Time spent simulating one physics step.")),
+m_actorCount(Talos::Metrics::getSingleton().getGauge(
+    "talos_physics_actors", "Rigid actors in the physics scene."))
 {
     
 }
@@ -106,8 +111,13 @@ void PScene::simulate(PxReal speed)
         speed;*/
     const PxReal step = 1.f / Talos::MS_PER_UPDATE;
 
+    m_timer.reset();
     m_scene->simulate(step);
     m_scene->fetchResults(true);
+    m_simulateTime->observe(m_timer.getMicroseconds() / 1000.0);
+    m_actorCount->set(m_scene->getNbActors(
+        PxActorTypeSelectionFlag::eRIGID_STATIC |
+        PxActorTypeSelectionFlag::eRIGID_DYNAMIC));
 
     if (m_useDebugDrawer){
         m_debugDrawer->update();
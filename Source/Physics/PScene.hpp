@@ -26,6 +26,7 @@
 
 // ========================================================================= //
 
+#include "Metrics/Metrics.hpp"
 #include "Physics.hpp"
 
 // ========================================================================= //
@@ -99,6 +100,11 @@ private:
     std::shared_ptr<PDebugDrawer> m_debugDrawer;
     bool m_useDebugDrawer;
     std::shared_ptr<Cooker> m_cooker;
+
+    // Runtime metrics.
+    Ogre::Timer m_timer;
+    Talos::Metrics::Histogram* m_simulateTime;
+    Talos::Metrics::Gauge* m_actorCount;
 };
 
 // ========================================================================= //
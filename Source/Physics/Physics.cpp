@@ -28,7 +28,7 @@
 Physics::Physics(void) :
 m_foundation(nullptr),
 m_physx(nullptr),
-m_defaultAllocator(),
+m_allocator(),
 m_defaultErrorCallback(),
 m_debuggerConnection(nullptr),
 m_cookingInterface(nullptr)
@@ -48,8 +48,10 @@ Physics::~Physics(void)
 const bool Physics::init(void)
 {
     m_foundation = PxCreateFoundation(PX_PHYSICS_VERSION,
-                                      m_defaultAllocator,
+                                      m_allocator,
                                       m_defaultErrorCallback);
+    // Needed for PAllocator to attribute allocations to types.
+    m_foundation->setReportAllocationNames(true);
 
     bool recordMemoryAllocations = true;
     m_physx = PxCreatePhysics(PX_PHYSICS_VERSION,
@@ -94,6 +96,9 @@ void Physics::destroy(void)
 
     m_physx->release();
     m_foundation->release();
+
+    // Anything still live here has leaked.
+    m_allocator.logReport();
 }
 
 // ========================================================================= //
\ No newline at end of file
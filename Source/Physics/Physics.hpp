@@ -27,6 +27,7 @@
 // ========================================================================= //
 
 #include "stdafx.hpp"
+#include "PAllocator.hpp"
 
 // ========================================================================= //
 
@@ -47,6 +48,11 @@ public:
 
     void destroy(void);
 
+    // Getters:
+
+    // Returns the allocator tracking PhysX memory.
+    PAllocator& getAllocator(void);
+
     // Talos conversion functions:
 
     static const EntityID toEntityID(const PxRigidActor* actor){
@@ -98,7 +104,7 @@ public:
 private:
     PxFoundation* m_foundation;
     PxPhysics* m_physx;
-    PxDefaultAllocator m_defaultAllocator;
+    PAllocator m_allocator;
     PxDefaultErrorCallback m_defaultErrorCallback;
     PxVisualDebuggerConnection* m_debuggerConnection;
     PxCooking* m_cookingInterface;
@@ -106,6 +112,14 @@ private:
 
 // ========================================================================= //
 
+// Getters:
+
+inline PAllocator& Physics::getAllocator(void){
+    return m_allocator;
+}
+
+// ========================================================================= //
+
 #endif
 
 // ========================================================================= //
\ No newline at end of file
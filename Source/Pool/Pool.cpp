@@ -81,6 +81,14 @@ T* Pool<T>::create(void)
 
 // ========================================================================= //
 
+template<typename T>
+const uint32_t Pool<T>::getActiveCount(void) const
+{
+    return m_numActive;
+}
+
+// ========================================================================= //
+
 template<typename T>
 const uint32_t Pool<T>::getSize(void) const
 {
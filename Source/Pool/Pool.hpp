@@ -30,6 +30,12 @@ class AbstractPool
 {
 public:
     virtual ~AbstractPool(void) = 0 { }    
+
+    // Returns number of objects handed out.
+    virtual const uint32_t getActiveCount(void) const = 0;
+
+    // Returns size of pool.
+    virtual const uint32_t getSize(void) const = 0;
 };
 
 // ========================================================================= //
@@ -49,8 +55,11 @@ public:
 
     // Getters:
 
+    // Returns number of objects handed out.
+    virtual const uint32_t getActiveCount(void) const override;
+
     // Returns size of pool.
-    const uint32_t getSize(void) const;
+    virtual const uint32_t getSize(void) const override;
 
     // Returns internal pool.
     T* getPool(void) const;
@@ -39,7 +39,14 @@ public:
 
     virtual void destroy(void) = 0;
 
-    virtual void update(void) = 0;
+    // Advances the ocean by dt units of animation time.
+    virtual void update(const Ogre::Real dt) = 0;
+
+    // Stops rendering the ocean while keeping its resources loaded.
+    virtual void suspend(void) { }
+
+    // Restores rendering after suspend().
+    virtual void resume(void) { }
 
     // Setters:
 
@@ -24,6 +24,7 @@
 #include "Component/CameraComponent.hpp"
 #include "Entity/Entity.hpp"
 #include "OceanHighGraphics.hpp"
+#include "OceanNoise.hpp"
 #include "World/World.hpp"
 
 // ========================================================================= //
@@ -48,7 +49,8 @@ OceanHighGraphics::~OceanHighGraphics(void)
 
 void OceanHighGraphics::init(std::shared_ptr<World> world,
                              const std::string& cfg,
-                             const Graphics::Setting graphicsSetting)
+                             const Graphics::Setting graphicsSetting,
+                             std::shared_ptr<OceanWaves> waves)
 {
     // Assign main camera pointer.
     m_mainCamera = world->getMainCamera()->getCamera();
@@ -69,10 +71,11 @@ void OceanHighGraphics::init(std::shared_ptr<World> world,
                                   m_hydraxCamera,
                                   world->getViewport());
 
-    // Initialize Hydrax module.
+    // Initialize Hydrax module. The noise samples the shared OceanWaves so
+    // gameplay queries match what is rendered.
     Hydrax::Module::ProjectedGrid* module =
         new Hydrax::Module::ProjectedGrid(m_hydrax,
-        new Hydrax::Noise::Perlin(),
+        new OceanNoise(waves),
         Ogre::Plane(Ogre::Vector3(0.f, 1.f, 0.f), 
             Ogre::Vector3(0.f, 0.f, 0.f)),
         Hydrax::MaterialManager::NM_VERTEX,
@@ -96,14 +99,28 @@ void OceanHighGraphics::destroy(void)
 
 // ========================================================================= //
 
-void OceanHighGraphics::update(void)
+void OceanHighGraphics::update(const Ogre::Real dt)
 {
     // Update Hydrax camera.
     m_hydraxCamera->setPosition(m_mainCamera->getDerivedPosition());
     m_hydraxCamera->setOrientation(m_mainCamera->getDerivedOrientation());
 
     // Update Hydrax animation.
-    m_hydrax->update(1.f / 16.f);
+    m_hydrax->update(dt);
+}
+
+// ========================================================================= //
+
+void OceanHighGraphics::suspend(void)
+{
+    m_hydrax->setVisible(false);
+}
+
+// ========================================================================= //
+
+void OceanHighGraphics::resume(void)
+{
+    m_hydrax->setVisible(true);
 }
 
 // ========================================================================= //
\ No newline at end of file
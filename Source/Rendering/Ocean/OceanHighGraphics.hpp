@@ -27,12 +27,16 @@
 // ========================================================================= //
 
 #include <Hydrax/Hydrax.h>
-#include <Hydrax/Noise/Perlin/Perlin.h>
 #include <Hydrax/Modules/ProjectedGrid/ProjectedGrid.h>
 #include "Ocean.hpp"
 
 // ========================================================================= //
-// Renders high-detail ocean using Hydrax Ogre3D plugin (Perlin or FFT noise).
+
+class OceanWaves;
+
+// ========================================================================= //
+// Renders high-detail ocean using Hydrax Ogre3D plugin, displaced by the 
+// OceanWaves surface model.
 class OceanHighGraphics final : public Ocean
 {
 public:
@@ -42,16 +46,24 @@ public:
     // Emtpy destructor.
     virtual ~OceanHighGraphics(void) override;
 
-    // Create Hydrax
+    // Create Hydrax, using waves as its noise module.
     void init(std::shared_ptr<World> world, 
               const std::string& cfg, 
-              const Graphics::Setting setting);
+              const Graphics::Setting setting,
+              std::shared_ptr<OceanWaves> waves);
 
     // Removes Hydrax and clears the memory it allocated.
     virtual void destroy(void) override;
 
     // Updates Hydrax camera position/orientation and Hydrax animation.
-    virtual void update(void) override;
+    virtual void update(const Ogre::Real dt) override;
+
+    // Hides Hydrax, stopping its reflection/refraction passes, while keeping
+    // its geometry, materials and module loaded.
+    virtual void suspend(void) override;
+
+    // Shows Hydrax again.
+    virtual void resume(void) override;
 
     // Setters:
 
@@ -15,18 +15,30 @@
 // You should have received a copy of the GNU General Public License
 // along with this program. If not, see <http://www.gnu.org/licenses/>.
 // ========================================================================= //
-// File: OceanHighGraphics.cpp
+// File: OceanLowGraphics.cpp
 // Author: Jordan Sparks <unixunited@live.com>
 // ========================================================================= //
-// Implements OceanHighGraphics class.
+// Implements OceanLowGraphics class.
 // ========================================================================= //
 
+#include "Component/CameraComponent.hpp"
 #include "OceanLowGraphics.hpp"
 #include "World/World.hpp"
 
 // ========================================================================= //
 
-OceanLowGraphics::OceanLowGraphics(void)
+OceanLowGraphics::OceanLowGraphics(void) :
+m_node(nullptr),
+m_entity(nullptr),
+m_camera(nullptr),
+m_level(0.f),
+// 9 levels of 32x32 cells starting at 1.5 units cover +/- 6144 units with
+// ~8k vertices (the old plane was 9999 units with 10k vertices at 100 units
+// spacing).
+m_levels(9),
+m_cells(32),
+m_spacing(1.5f),
+m_world(nullptr)
 {
 
 }
@@ -44,25 +56,12 @@ void OceanLowGraphics::init(std::shared_ptr<World> world,
                             const std::string& material)
 {
     m_world = world;
+    m_camera = m_world->getMainCamera()->getCamera();
 
     const std::string meshName = "LowOcean";
 
     if (!Ogre::MeshManager::getSingleton().resourceExists(meshName)){
-        m_plane.normal = Ogre::Vector3::UNIT_Y;
-        m_plane.d = 0.f;
-        Ogre::MeshManager::getSingleton().createPlane(
-            meshName,
-            Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME,
-            m_plane,
-            9999.f, 
-            9999.f, 
-            100, 
-            100, 
-            true, 
-            1, 
-            1.f, 
-            1.f,
-            Ogre::Vector3::UNIT_Z);
+        this->createMesh(meshName);
     }
 
     m_node = m_world->getSceneManager()->getRootSceneNode()->
@@ -73,20 +72,186 @@ void OceanLowGraphics::init(std::shared_ptr<World> world,
     m_node->attachObject(m_entity);
 
     m_entity->setMaterialName(material);
+
+    this->update(0.f);
+}
+
+// ========================================================================= //
+
+void OceanLowGraphics::createMesh(const std::string& name)
+{
+    // Per vertex: position, then (ring spacing, morph start, morph end, 0) 
+    // read by the vertex shader to geomorph towards the next ring.
+    const size_t floatsPerVertex = 7;
+    std::vector<float> vertices;
+    std::vector<uint16_t> indices;
+    std::vector<int32_t> grid((m_cells + 1) * (m_cells + 1));
+
+    // The node is snapped to twice the finest spacing, so the camera is at 
+    // most one finest cell from it on each axis. The shader then moves each
+    // ring back by less than its own spacing onto its world grid.
+    const uint32_t hole = m_cells / 4;
+    Ogre::Real half = 0.f;
+
+    for (uint32_t level = 0; level < m_levels; ++level){
+        const Ogre::Real spacing = m_spacing * static_cast<Ogre::Real>(1 << level);
+        const Ogre::Real innerHalf = half;
+        half = spacing * (m_cells / 2);
+
+        // Fully morphed before the outer edge (which matches the next ring's
+        // inner edge); the outermost level has nothing to morph to.
+        Ogre::Real morphEnd = 2e9f, morphStart = 1e9f;
+        if (level + 1 < m_levels){
+            const Ogre::Real maxOffset = m_spacing + spacing;
+            morphEnd = half - maxOffset - 0.01f;
+            morphStart = morphEnd - (half - innerHalf) * 0.3f;
+        }
+
+        // Rings skip the vertices strictly inside the previous level.
+        for (uint32_t j = 0; j <= m_cells; ++j){
+            for (uint32_t i = 0; i <= m_cells; ++i){
+                const bool inside = (level > 0 && 
+                                     i > hole && i < m_cells - hole &&
+                                     j > hole && j < m_cells - hole);
+                if (inside){
+                    grid[j * (m_cells + 1) + i] = -1;
+                    continue;
+                }
+
+                grid[j * (m_cells + 1) + i] = static_cast<int32_t>(
+                    vertices.size() / floatsPerVertex);
+
+                vertices.push_back(-half + i * spacing);
+                vertices.push_back(0.f);
+                vertices.push_back(-half + j * spacing);
+                vertices.push_back(spacing);
+                vertices.push_back(morphStart);
+                vertices.push_back(morphEnd);
+                vertices.push_back(0.f);
+            }
+        }
+
+        for (uint32_t j = 0; j < m_cells; ++j){
+            for (uint32_t i = 0; i < m_cells; ++i){
+                const bool inside = (level > 0 &&
+                                     i >= hole && i < m_cells - hole &&
+                                     j >= hole && j < m_cells - hole);
+                if (inside){
+                    continue;
+                }
+
+                const uint16_t v00 = static_cast<uint16_t>(
+                    grid[j * (m_cells + 1) + i]);
+                const uint16_t v10 = static_cast<uint16_t>(
+                    grid[j * (m_cells + 1) + i + 1]);
+                const uint16_t v01 = static_cast<uint16_t>(
+                    grid[(j + 1) * (m_cells + 1) + i]);
+                const uint16_t v11 = static_cast<uint16_t>(
+                    grid[(j + 1) * (m_cells + 1) + i + 1]);
+
+                // Counter-clockwise seen from above.
+                indices.push_back(v00);
+                indices.push_back(v01);
+                indices.push_back(v10);
+                indices.push_back(v10);
+                indices.push_back(v01);
+                indices.push_back(v11);
+            }
+        }
+    }
+
+    const size_t vertexCount = vertices.size() / floatsPerVertex;
+    Assert(vertexCount <= 0xFFFF, "Ocean clipmap exceeds 16-bit indices");
+
+    Ogre::MeshPtr mesh = Ogre::MeshManager::getSingleton().createManual(
+        name, Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+    Ogre::SubMesh* sub = mesh->createSubMesh();
+    sub->useSharedVertices = false;
+    sub->operationType = Ogre::RenderOperation::OT_TRIANGLE_LIST;
+
+    sub->vertexData = new Ogre::VertexData();
+    sub->vertexData->vertexStart = 0;
+    sub->vertexData->vertexCount = vertexCount;
+
+    Ogre::VertexDeclaration* decl = sub->vertexData->vertexDeclaration;
+    size_t offset = 0;
+    decl->addElement(0, offset, Ogre::VET_FLOAT3, Ogre::VES_POSITION);
+    offset += Ogre::VertexElement::getTypeSize(Ogre::VET_FLOAT3);
+    decl->addElement(0, offset, Ogre::VET_FLOAT4, 
+                     Ogre::VES_TEXTURE_COORDINATES, 0);
+    offset += Ogre::VertexElement::getTypeSize(Ogre::VET_FLOAT4);
+
+    Ogre::HardwareVertexBufferSharedPtr vbuf = 
+        Ogre::HardwareBufferManager::getSingleton().createVertexBuffer(
+        offset, vertexCount, Ogre::HardwareBuffer::HBU_STATIC_WRITE_ONLY);
+    vbuf->writeData(0, vbuf->getSizeInBytes(), &vertices[0], true);
+    sub->vertexData->vertexBufferBinding->setBinding(0, vbuf);
+
+    Ogre::HardwareIndexBufferSharedPtr ibuf =
+        Ogre::HardwareBufferManager::getSingleton().createIndexBuffer(
+        Ogre::HardwareIndexBuffer::IT_16BIT, 
+        indices.size(),
+        Ogre::HardwareBuffer::HBU_STATIC_WRITE_ONLY);
+    ibuf->writeData(0, ibuf->getSizeInBytes(), &indices[0], true);
+    sub->indexData->indexBuffer = ibuf;
+    sub->indexData->indexStart = 0;
+    sub->indexData->indexCount = indices.size();
+
+    // Leave room for the shader's wave displacement and the outer ring's
+    // shift onto its grid.
+    const Ogre::Real shift = m_spacing * static_cast<Ogre::Real>(
+        1 << (m_levels - 1));
+    mesh->_setBounds(Ogre::AxisAlignedBox(-half - shift, -10.f, -half - shift,
+                                          half, 10.f, half));
+    mesh->_setBoundingSphereRadius((half + shift) * Ogre::Math::Sqrt(2.f));
+    mesh->load();
+
+    Talos::Log::getSingleton().log("Ocean clipmap: " + 
+                                   toString(vertexCount) + " vertices, " +
+                                   toString(indices.size() / 3) + 
+                                   " triangles");
 }
 
 // ========================================================================= //
 
 void OceanLowGraphics::destroy(void)
 {
+    m_node->detachObject(m_entity);
+    m_world->getSceneManager()->destroyEntity(m_entity);
     m_world->getSceneManager()->destroySceneNode(m_node);
 }
 
 // ========================================================================= //
 
-void OceanLowGraphics::update(void)
+void OceanLowGraphics::update(const Ogre::Real dt)
+{
+    // Move in whole steps of the first ring's spacing so the inner grid
+    // never slides over the water. Coarser rings are aligned to their own
+    // spacing by the vertex shader.
+    const Ogre::Real step = m_spacing * 2.f;
+    const Ogre::Vector3 camera = m_camera->getDerivedPosition();
+
+    m_node->setPosition(Ogre::Math::Floor(camera.x / step + 0.5f) * step,
+                        m_level,
+                        Ogre::Math::Floor(camera.z / step + 0.5f) * step);
+}
+
+// ========================================================================= //
+
+void OceanLowGraphics::suspend(void)
 {
+    if (m_node->isInSceneGraph()){
+        m_world->getSceneManager()->getRootSceneNode()->removeChild(m_node);
+    }
+}
 
+// ========================================================================= //
+
+void OceanLowGraphics::resume(void)
+{
+    if (!m_node->isInSceneGraph()){
+        m_world->getSceneManager()->getRootSceneNode()->addChild(m_node);
+    }
 }
 
 // ========================================================================= //
@@ -95,7 +260,9 @@ void OceanLowGraphics::setPosition(const Ogre::Real x,
                                    const Ogre::Real y,
                                    const Ogre::Real z)
 {
-    m_node->setPosition(x, y, z);
+    m_level = y;
+
+    this->update(0.f);
 }
 
 // ========================================================================= //
\ No newline at end of file
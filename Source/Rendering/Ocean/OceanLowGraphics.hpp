@@ -30,7 +30,12 @@
 #include "stdafx.hpp"
 
 // ========================================================================= //
-// Renders Ocean texture to a plane with some shading.
+// Renders Ocean texture with some shading to a clipmap mesh centred on the
+// camera: a fine grid surrounded by rings that double their spacing, each
+// with the same vertex count. The mesh is built once and its scene node 
+// follows the camera in steps of twice the finest spacing. The vertex shader
+// aligns each ring to its own spacing in world space and geomorphs its outer
+// edge onto the next ring's grid.
 class OceanLowGraphics : public Ocean
 {
 public:
@@ -38,24 +43,42 @@ public:
 
     virtual ~OceanLowGraphics(void) override;
 
+    // Creates the clipmap mesh (once per process) and an entity using it.
     void init(std::shared_ptr<World> world, 
               const std::string& material);
 
     virtual void destroy(void) override;
 
-    virtual void update(void) override;
+    // Moves the mesh with the main camera, snapped to the finest grid.
+    virtual void update(const Ogre::Real dt) override;
+
+    // Detaches the mesh's scene node from the scene graph.
+    virtual void suspend(void) override;
+
+    // Re-attaches the mesh's scene node to the scene graph.
+    virtual void resume(void) override;
 
     // Setters:
 
-    // Sets origin of plane.
+    // Sets water level (y). The mesh follows the camera in x and z.
     virtual void setPosition(const Ogre::Real,
                              const Ogre::Real,
                              const Ogre::Real) override;
 
 private:
+    // Builds the clipmap mesh into the MeshManager.
+    void createMesh(const std::string& name);
+
     Ogre::SceneNode* m_node;
     Ogre::Entity* m_entity;
-    Ogre::Plane m_plane;
+    Ogre::Camera* m_camera;
+    Ogre::Real m_level;
+
+    // Clipmap layout: number of levels (inner grid + rings), cells per side
+    // of each level, and spacing of the inner grid.
+    uint32_t m_levels;
+    uint32_t m_cells;
+    Ogre::Real m_spacing;
 
     std::shared_ptr<World> m_world;
 };
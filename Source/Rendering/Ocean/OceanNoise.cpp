@@ -0,0 +1,57 @@
+// ========================================================================= //
+// Talos - A 3D game engine with network multiplayer.
+// Copyright(C) 2015 Jordan Sparks <unixunited@live.com>
+//
+// This program is free software; you can redistribute it and / or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 3
+// of the License, or(at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+// ========================================================================= //
+// File: OceanNoise.cpp
+// Author: Jordan Sparks <unixunited@live.com>
+// ========================================================================= //
+// Implements OceanNoise class.
+// ========================================================================= //
+
+#include "OceanNoise.hpp"
+#include "World/OceanWaves.hpp"
+
+// ========================================================================= //
+
+OceanNoise::OceanNoise(std::shared_ptr<OceanWaves> waves) :
+Hydrax::Noise::Noise("OceanWaves", false),
+m_waves(waves)
+{
+
+}
+
+// ========================================================================= //
+
+OceanNoise::~OceanNoise(void)
+{
+
+}
+
+// ========================================================================= //
+
+void OceanNoise::update(const Ogre::Real& timeSinceLastFrame)
+{
+
+}
+
+// ========================================================================= //
+
+float OceanNoise::getValue(const float& x, const float& y)
+{
+    return m_waves->getNoise(x, y);
+}
+
+// ========================================================================= //
\ No newline at end of file
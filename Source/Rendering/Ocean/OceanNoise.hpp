@@ -0,0 +1,63 @@
+// ========================================================================= //
+// Talos - A 3D game engine with network multiplayer.
+// Copyright(C) 2015 Jordan Sparks <unixunited@live.com>
+//
+// This program is free software; you can redistribute it and / or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 3
+// of the License, or(at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+// ========================================================================= //
+// File: OceanNoise.hpp
+// Author: Jordan Sparks <unixunited@live.com>
+// ========================================================================= //
+// Defines OceanNoise class.
+// ========================================================================= //
+
+#ifndef __OCEANNOISE_HPP__
+#define __OCEANNOISE_HPP__
+
+// ========================================================================= //
+
+#include <Hydrax/Noise/Noise.h>
+#include "stdafx.hpp"
+
+// ========================================================================= //
+
+class OceanWaves;
+
+// ========================================================================= //
+// Hydrax noise module backed by OceanWaves, so the rendered surface and CPU
+// queries (buoyancy etc.) are the same function of the same time. Hydrax 
+// owns and deletes the module.
+class OceanNoise final : public Hydrax::Noise::Noise
+{
+public:
+    explicit OceanNoise(std::shared_ptr<OceanWaves> waves);
+
+    // Empty destructor.
+    virtual ~OceanNoise(void) override;
+
+    // Does nothing: OceanWaves is advanced by Environment at a fixed step, 
+    // independently of how often Hydrax updates.
+    virtual void update(const Ogre::Real& timeSinceLastFrame) override;
+
+    // Returns unscaled wave value at x, y (world x, z).
+    virtual float getValue(const float& x, const float& y) override;
+
+private:
+    std::shared_ptr<OceanWaves> m_waves;
+};
+
+// ========================================================================= //
+
+#endif
+
+// ========================================================================= //
\ No newline at end of file
@@ -0,0 +1,282 @@
+// ========================================================================= //
+// Talos - A 3D game engine with network multiplayer.
+// Copyright(C) 2015 Jordan Sparks <unixunited@live.com>
+//
+// This program is free software; you can redistribute it and / or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 3
+// of the License, or(at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+// ========================================================================= //
+// File: ShadowManager.cpp
+// Author: Jordan Sparks <unixunited@live.com>
+// ========================================================================= //
+// Implements ShadowManager class.
+// ========================================================================= //
+
+#include "ShadowManager.hpp"
+
+#include <algorithm>
+#include <limits>
+
+// ========================================================================= //
+
+ShadowManager::ShadowManager(Ogre::SceneManager* sceneMgr) :
+m_sceneMgr(sceneMgr),
+m_camera(nullptr),
+m_lights(),
+m_scores(),
+m_ranked(),
+m_shadowTextures(0),
+m_shadowedLights(0),
+m_candidates(0),
+m_initialized(false)
+{
+
+}
+
+// ========================================================================= //
+
+ShadowManager::~ShadowManager(void)
+{
+
+}
+
+// ========================================================================= //
+
+void ShadowManager::init(const std::vector<Tier>& tiers,
+                         const Ogre::PixelFormat format,
+                         const uint16_t fsaa)
+{
+    std::vector<Tier> sorted(tiers);
+    std::sort(sorted.begin(), sorted.end(), [](const Tier& a, const Tier& b){
+        return a.size > b.size;
+    });
+
+    m_shadowTextures = 0;
+    for (auto& tier : sorted){
+        m_shadowTextures += tier.count;
+    }
+
+    // Ogre hands shadow textures out in light list order, so the largest
+    // tier goes first.
+    m_sceneMgr->setShadowTextureCount(m_shadowTextures);
+    size_t index = 0;
+    for (auto& tier : sorted){
+        for (uint32_t i = 0; i < tier.count; ++i){
+            m_sceneMgr->setShadowTextureConfig(index++,
+                                               tier.size,
+                                               tier.size,
+                                               format,
+                                               fsaa);
+        }
+    }
+
+    // Fit each shadow camera to the receivers in view, culling casters
+    // that cannot shadow anything visible.
+    m_sceneMgr->setShadowCameraSetup(
+        Ogre::ShadowCameraSetupPtr(new Ogre::FocusedShadowCameraSetup()));
+
+    m_sceneMgr->addListener(this);
+    m_initialized = true;
+}
+
+// ========================================================================= //
+
+void ShadowManager::destroy(void)
+{
+    if (m_initialized){
+        m_sceneMgr->removeListener(this);
+        m_initialized = false;
+    }
+
+    m_lights.clear();
+    m_scores.clear();
+    m_ranked.clear();
+}
+
+// ========================================================================= //
+
+void ShadowManager::addLight(Ogre::Light* light, const bool castShadows)
+{
+    m_lights[light] = castShadows;
+
+    // Applies until the first managed frame, or for good if shadows are off.
+    light->setCastShadows(castShadows);
+}
+
+// ========================================================================= //
+
+void ShadowManager::removeLight(Ogre::Light* light)
+{
+    m_lights.erase(light);
+    m_scores.erase(light);
+}
+
+// ========================================================================= //
+
+const Ogre::Real ShadowManager::getScore(const Ogre::Light* light,
+                                         const Ogre::Camera* camera) const
+{
+    if (light->isVisible() == false){
+        return 0.f;
+    }
+
+    const Ogre::ColourValue& colour = light->getDiffuseColour();
+    const Ogre::Real brightness = (colour.r + colour.g + colour.b) / 3.f *
+        light->getPowerScale();
+    if (brightness <= 0.f){
+        return 0.f;
+    }
+
+    // Directional lights cover the whole view.
+    if (light->getType() == Ogre::Light::LT_DIRECTIONAL){
+        return brightness;
+    }
+
+    const Ogre::Real range = light->getAttenuationRange();
+    const Ogre::Vector3 position = light->getDerivedPosition();
+    if (camera->isVisible(Ogre::Sphere(position, range)) == false){
+        return 0.f;
+    }
+
+    // Approximate the share of the view the light's volume projects to:
+    // all of it from inside, falling off with distance squared outside.
+    const Ogre::Real distance = std::max(
+        position.squaredDistance(camera->getDerivedPosition()), 1e-4f);
+    Ogre::Real coverage = std::min(1.f, (range * range) / distance);
+
+    // A spotlight only lights its cone.
+    if (light->getType() == Ogre::Light::LT_SPOTLIGHT){
+        coverage *= 1.f - Ogre::Math::Cos(
+            light->getSpotlightOuterAngle() * 0.5f);
+    }
+
+    return brightness * coverage;
+}
+
+// ========================================================================= //
+
+void ShadowManager::postUpdateSceneGraph(Ogre::SceneManager* source,
+                                         Ogre::Camera* camera)
+{
+    // Shadow and reflection cameras render the same scene; rank once, for
+    // the main camera.
+    if (m_initialized == false || camera != m_camera){
+        return;
+    }
+
+    // Shadow maps already taken by lights outside the manager.
+    uint32_t used = 0;
+    Ogre::SceneManager::MovableObjectIterator itr =
+        source->getMovableObjectIterator(
+            Ogre::LightFactory::FACTORY_TYPE_NAME);
+    while (itr.hasMoreElements()){
+        Ogre::Light* light = static_cast<Ogre::Light*>(itr.getNext());
+        if (m_lights.count(light) == 0 &&
+            light->getCastShadows() &&
+            light->isVisible()){
+            used += static_cast<uint32_t>(
+                source->getShadowTextureCountPerLightType(light->getType()));
+        }
+    }
+
+    m_ranked.clear();
+    m_scores.clear();
+    for (auto& light : m_lights){
+        const Ogre::Real score = (light.second) ?
+            this->getScore(light.first, camera) : 0.f;
+        if (score > 0.f){
+            m_ranked.push_back(std::make_pair(score, light.first));
+            m_scores[light.first] = score;
+        }
+        else{
+            light.first->setCastShadows(false);
+        }
+    }
+    m_candidates = static_cast<uint32_t>(m_ranked.size());
+
+    std::sort(m_ranked.begin(), m_ranked.end(),
+              [](const std::pair<Ogre::Real, Ogre::Light*>& a,
+                 const std::pair<Ogre::Real, Ogre::Light*>& b){
+        return a.first > b.first;
+    });
+
+    // Best lights first until the maps run out; the rest go unshadowed.
+    m_shadowedLights = 0;
+    for (auto& ranked : m_ranked){
+        Ogre::Light* light = ranked.second;
+        const uint32_t needed = static_cast<uint32_t>(
+            source->getShadowTextureCountPerLightType(light->getType()));
+
+        if (used + needed > m_shadowTextures){
+            light->setCastShadows(false);
+            continue;
+        }
+
+        used += needed;
+        ++m_shadowedLights;
+        light->setCastShadows(true);
+
+        // Nothing beyond a local light's range can be shadowed by it.
+        if (light->getType() != Ogre::Light::LT_DIRECTIONAL){
+            light->setShadowFarDistance(light->getAttenuationRange());
+        }
+    }
+}
+
+// ========================================================================= //
+
+bool ShadowManager::sortLightsAffectingFrustum(Ogre::LightList& lightList)
+{
+    if (m_initialized == false || m_camera == nullptr){
+        return false;
+    }
+
+    // Unmanaged lights keep priority, as they were counted first.
+    std::stable_sort(lightList.begin(), lightList.end(),
+                     [this](const Ogre::Light* a, const Ogre::Light* b){
+        std::map<const Ogre::Light*, Ogre::Real>::const_iterator itrA =
+            m_scores.find(a);
+        std::map<const Ogre::Light*, Ogre::Real>::const_iterator itrB =
+            m_scores.find(b);
+        const bool managedA = (m_lights.count(const_cast<Ogre::Light*>(a)) != 0);
+        const bool managedB = (m_lights.count(const_cast<Ogre::Light*>(b)) != 0);
+
+        const Ogre::Real scoreA = (managedA == false) ?
+            std::numeric_limits<Ogre::Real>::max() :
+            (itrA != m_scores.end()) ? itrA->second : 0.f;
+        const Ogre::Real scoreB = (managedB == false) ?
+            std::numeric_limits<Ogre::Real>::max() :
+            (itrB != m_scores.end()) ? itrB->second : 0.f;
+
+        return scoreA > scoreB;
+    });
+
+    return true;
+}
+
+// ========================================================================= //
+
+void ShadowManager::setCastShadows(Ogre::Light* light, const bool castShadows)
+{
+    std::map<Ogre::Light*, bool>::iterator itr = m_lights.find(light);
+    if (itr == m_lights.end()){
+        light->setCastShadows(castShadows);
+        return;
+    }
+
+    itr->second = castShadows;
+    if (m_initialized == false){
+        light->setCastShadows(castShadows);
+    }
+}
+
+// ========================================================================= //
\ No newline at end of file
@@ -0,0 +1,138 @@
+// ========================================================================= //
+// Talos - A 3D game engine with network multiplayer.
+// Copyright(C) 2015 Jordan Sparks <unixunited@live.com>
+//
+// This program is free software; you can redistribute it and / or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 3
+// of the License, or(at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+// ========================================================================= //
+// File: ShadowManager.hpp
+// Author: Jordan Sparks <unixunited@live.com>
+// ========================================================================= //
+// Defines ShadowManager class.
+// ========================================================================= //
+
+#ifndef __SHADOWMANAGER_HPP__
+#define __SHADOWMANAGER_HPP__
+
+// ========================================================================= //
+
+#include "stdafx.hpp"
+
+// ========================================================================= //
+// Keeps texture shadow cost bounded regardless of light count. Each frame
+// the lights added to it are ranked by their influence on the main camera's
+// view, and only the best ones that fit the pool of shadow maps cast
+// shadows; the rest are lit unshadowed. Shadow maps come in size tiers, the
+// largest going to the highest ranked lights, and each shadow camera is
+// focused on the visible receivers and clipped to the light's range, so
+// casters outside a light's receiver volume are not rendered.
+class ShadowManager final : public Ogre::SceneManager::Listener
+{
+public:
+    // A number of shadow maps of one size.
+    struct Tier{
+        uint16_t size;
+        uint32_t count;
+    };
+
+    // Stores the scene manager; nothing happens until init().
+    explicit ShadowManager(Ogre::SceneManager* sceneMgr);
+
+    // Empty destructor.
+    virtual ~ShadowManager(void) override;
+
+    // Creates the shadow maps, largest tier first, and starts managing
+    // lights each frame.
+    void init(const std::vector<Tier>& tiers,
+              const Ogre::PixelFormat format,
+              const uint16_t fsaa);
+
+    // Stops managing lights.
+    void destroy(void);
+
+    // Puts light under budget management. castShadows says whether it
+    // should cast shadows when the budget allows.
+    void addLight(Ogre::Light* light, const bool castShadows = true);
+
+    // Releases light from management, leaving its current shadow state.
+    void removeLight(Ogre::Light* light);
+
+    // Ogre::SceneManager::Listener:
+
+    // Ranks lights for the main camera and hands out the budget.
+    virtual void postUpdateSceneGraph(Ogre::SceneManager* source,
+                                      Ogre::Camera* camera) override;
+
+    // Orders lights by rank, so the largest maps go to the best lights.
+    virtual bool sortLightsAffectingFrustum(Ogre::LightList& lightList)
+        override;
+
+    // Getters:
+
+    // Returns number of managed lights given shadows last frame.
+    const uint32_t getShadowedLightCount(void) const;
+
+    // Returns number of managed lights that wanted shadows last frame.
+    const uint32_t getCandidateCount(void) const;
+
+    // Setters:
+
+    // Sets the camera lights are ranked for, usually the main camera.
+    void setCamera(Ogre::Camera* camera);
+
+    // Sets whether a managed light should cast shadows when the budget
+    // allows.
+    void setCastShadows(Ogre::Light* light, const bool castShadows);
+
+private:
+    // Returns the light's estimated share of the camera's view, weighted
+    // by brightness. 0 if it cannot affect the view.
+    const Ogre::Real getScore(const Ogre::Light* light,
+                              const Ogre::Camera* camera) const;
+
+    Ogre::SceneManager* m_sceneMgr;
+    Ogre::Camera* m_camera;
+    // Managed lights and whether they want shadows.
+    std::map<Ogre::Light*, bool> m_lights;
+    // Rank of each managed light last frame, higher is better.
+    std::map<const Ogre::Light*, Ogre::Real> m_scores;
+    std::vector<std::pair<Ogre::Real, Ogre::Light*>> m_ranked;
+    uint32_t m_shadowTextures;
+    uint32_t m_shadowedLights;
+    uint32_t m_candidates;
+    bool m_initialized;
+};
+
+// ========================================================================= //
+
+// Getters:
+
+inline const uint32_t ShadowManager::getShadowedLightCount(void) const{
+    return m_shadowedLights;
+}
+
+inline const uint32_t ShadowManager::getCandidateCount(void) const{
+    return m_candidates;
+}
+
+// Setters:
+
+inline void ShadowManager::setCamera(Ogre::Camera* camera){
+    m_camera = camera;
+}
+
+// ========================================================================= //
+
+#endif
+
+// ========================================================================= //
\ No newline at end of file
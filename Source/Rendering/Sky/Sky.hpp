@@ -41,7 +41,18 @@ public:
 
     virtual void destroy(void) = 0;
 
-    virtual void update(void) = 0;
+    // Advances sky colour, sun/moon and lighting by dt units of animation
+    // time.
+    virtual void update(const Ogre::Real dt) = 0;
+
+    // Advances volumetric clouds (if any) by dt units of animation time.
+    virtual void updateClouds(const Ogre::Real dt) { }
+
+    // Stops rendering the sky while keeping its resources loaded.
+    virtual void suspend(void) { }
+
+    // Restores rendering after suspend().
+    virtual void resume(void) { }
 
     // Getters:
 
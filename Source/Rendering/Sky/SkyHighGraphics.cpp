@@ -172,11 +172,11 @@ void SkyHighGraphics::destroy(void)
 
 // ========================================================================= //
 
-void SkyHighGraphics::update(void)
+void SkyHighGraphics::update(const Ogre::Real dt)
 {
-    // Update SkyX animation state.
-    m_skyX->notifyCameraRender(m_camera);
-    m_skyX->update(1.f / 16.f);
+    // Update SkyX animation state, volumetric clouds are updated separately.
+    m_skyX->notifyCameraRenderSky(m_camera);
+    m_skyX->updateSky(dt);
     
     // Process day/night cycle lighting.
     Ogre::Real time = this->getTime();
@@ -214,6 +214,28 @@ void SkyHighGraphics::update(void)
 
 // ========================================================================= //
 
+void SkyHighGraphics::updateClouds(const Ogre::Real dt)
+{
+    m_skyX->getVCloudsManager()->update(dt);
+    m_skyX->getVCloudsManager()->notifyCameraRender(m_camera);
+}
+
+// ========================================================================= //
+
+void SkyHighGraphics::suspend(void)
+{
+    m_skyX->setVisible(false);
+}
+
+// ========================================================================= //
+
+void SkyHighGraphics::resume(void)
+{
+    m_skyX->setVisible(true);
+}
+
+// ========================================================================= //
+
 const Ogre::Real SkyHighGraphics::calcSkydomeRadius(void) const
 {
     return m_skyX->getMeshManager()->getSkydomeRadius(m_camera) * 0.5f;
@@ -53,7 +53,17 @@ public:
     virtual void destroy(void) override;
 
     // Update SkyX animation state and day/night cycle lighting.
-    virtual void update(void) override;
+    virtual void update(const Ogre::Real dt) override;
+
+    // Update SkyX volumetric clouds and their geometry.
+    virtual void updateClouds(const Ogre::Real dt) override;
+
+    // Hides the sky dome, moon and volumetric clouds, keeping SkyX and its
+    // cloud simulation data alive.
+    virtual void suspend(void) override;
+
+    // Shows SkyX again.
+    virtual void resume(void) override;
 
     // Getters:
 
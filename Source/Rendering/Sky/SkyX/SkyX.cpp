@@ -126,6 +126,17 @@ namespace SkyX
 			return;
 		}
 
+		updateSky(timeSinceLastFrame);
+		mVCloudsManager->update(timeSinceLastFrame);
+	}
+
+	void SkyX::updateSky(const Ogre::Real& timeSinceLastFrame)
+	{
+		if (!mCreated)
+		{
+			return;
+		}
+
 		if (mTimeMultiplier != 0)
 		{
 			float timemultiplied = timeSinceLastFrame * mTimeMultiplier;
@@ -145,7 +156,6 @@ namespace SkyX
 
 		mMoonManager->updateMoonPhase(mController->getMoonPhase());
 		mCloudsManager->update();
-		mVCloudsManager->update(timeSinceLastFrame);
 	}
 
 	void SkyX::notifyCameraRender(Ogre::Camera* c)
@@ -155,6 +165,17 @@ namespace SkyX
 			return;
 		}
 
+		notifyCameraRenderSky(c);
+		mVCloudsManager->notifyCameraRender(c);
+	}
+
+	void SkyX::notifyCameraRenderSky(Ogre::Camera* c)
+	{
+		if (!mCreated)
+		{
+			return;
+		}
+
 		mCamera = c;
 		
 		if (mLastCameraPosition != c->getDerivedPosition())
@@ -172,8 +193,6 @@ namespace SkyX
 		}
 
 		mMoonManager->updateGeometry(c);
-
-		mVCloudsManager->notifyCameraRender(c);
 	}
 
 	void SkyX::setVisible(const bool& visible)
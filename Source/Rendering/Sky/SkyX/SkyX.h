@@ -136,6 +136,20 @@ namespace SkyX
 		 */
 		void notifyCameraRender(Ogre::Camera* c);
 
+		/** Update the sky (atmosphere, moon and cloud layers), leaving volumetric clouds untouched
+		    @param timeSinceLastFrame Time elapsed since the last sky update
+			@remarks Together with VCloudsManager::update(...) this allows volumetric clouds to be updated at their own rate.
+			         SkyX::update(...) is equivalent to calling both.
+		 */
+		void updateSky(const Ogre::Real& timeSinceLastFrame);
+
+		/** Notify camera render to the sky, leaving volumetric clouds untouched
+		    @param c Camera
+			@remarks Together with VCloudsManager::notifyCameraRender(...) this allows volumetric clouds to be updated at their own rate.
+			         SkyX::notifyCameraRender(...) is equivalent to calling both.
+		 */
+		void notifyCameraRenderSky(Ogre::Camera* c);
+
 		/** Is SkyX created?
 		    @return true if yes, false if not
 		 */
@@ -39,11 +39,15 @@ namespace SkyX { namespace VClouds
 		, mStep(0), mXStart(0), mXEnd(0)
 		, mMaxNumberOfClouds(250)
 		, mVolTexToUpdate(true)
+		, mBrickSize(8)
+		, mUseStagingBuffer(true)
+		, mLastUploadedBricks(0)
 		, mCreated(false)
 	{
 		for (int k = 0; k < 2; k++)
 		{
 			mVolTextures[k].setNull();
+			mUploadedValid[k] = false;
 		}
 	}
 
@@ -70,6 +74,14 @@ namespace SkyX { namespace VClouds
 
 		delete mFFRandom;
 
+		mBricks.clear();
+		mStaging.clear();
+		for (int k = 0; k < 2; k++)
+		{
+			mUploaded[k].clear();
+			mUploadedValid[k] = false;
+		}
+
 		mNx = mNy = mNz = 0;
 
 		mCreated = false;
@@ -164,6 +176,7 @@ namespace SkyX { namespace VClouds
 		mFFRandom = new FastFakeRandom(1024, 0, 1);
 
 		_initData(nx, ny, nz);
+		_createBricks(nx, ny, nz);
 
 		for (int k = 0; k < 2; k++)
 		{
@@ -200,6 +213,16 @@ namespace SkyX { namespace VClouds
 		mVolTexToUpdate = !mVolTexToUpdate;
 	}
 
+	void DataManager::setBrickSize(const int& BrickSize)
+	{
+		mBrickSize = (BrickSize < 1) ? 1 : BrickSize;
+
+		if (mCreated)
+		{
+			_createBricks(mNx, mNy, mNz);
+		}
+	}
+
 	void DataManager::_initData(const int& nx, const int& ny, const int& nz)
 	{
 		mCellsCurrent = _create3DCellArray(nx, ny, nz);
@@ -592,29 +615,140 @@ namespace SkyX { namespace VClouds
 				->setTextureName("_SkyX_VolCloudsData"+Ogre::StringConverter::toString(TexId), Ogre::TEX_TYPE_3D);
 	}
 
+	void DataManager::_createBricks(const int& nx, const int& ny, const int& nz)
+	{
+		mBricks.clear();
+
+		for (int z = 0; z < nz; z += mBrickSize)
+		{
+			for (int y = 0; y < ny; y += mBrickSize)
+			{
+				for (int x = 0; x < nx; x += mBrickSize)
+				{
+					mBricks.push_back(Ogre::Box(x, y, z, 
+						std::min(x + mBrickSize, nx), std::min(y + mBrickSize, ny), std::min(z + mBrickSize, nz)));
+				}
+			}
+		}
+
+		mStaging.resize(nx*ny*nz);
+
+		// Force a full upload, the uploaded copies are no longer trusted
+		for (int k = 0; k < 2; k++)
+		{
+			mUploaded[k].resize(nx*ny*nz);
+			mUploadedValid[k] = false;
+		}
+	}
+
+	const bool DataManager::_isBrickDirty(const Ogre::Box& b, const VolTextureId& TexId) const
+	{
+		const size_t rowSize = b.getWidth()*sizeof(Ogre::uint32);
+
+		for (size_t z = b.front; z < b.back; z++)
+		{
+			for (size_t y = b.top; y < b.bottom; y++)
+			{
+				const size_t offset = (z*mNy + y)*mNx + b.left;
+
+				if (memcmp(&mStaging[offset], &mUploaded[TexId][offset], rowSize) != 0)
+				{
+					return true;
+				}
+			}
+		}
+
+		return false;
+	}
+
+	void DataManager::_uploadBox(const Ogre::HardwarePixelBufferSharedPtr& buffer, const Ogre::Box& b, const bool& discard)
+	{
+		const Ogre::PixelBox src = Ogre::PixelBox(mNx, mNy, mNz, Ogre::PF_A8R8G8B8, &mStaging[0]).getSubVolume(b);
+
+		if (mUseStagingBuffer && !discard)
+		{
+			// Let the render system copy straight from our persistent buffer
+			buffer->blitFromMemory(src, b);
+			return;
+		}
+
+		buffer->lock(b, discard ? Ogre::HardwareBuffer::HBL_DISCARD : Ogre::HardwareBuffer::HBL_NORMAL);
+		Ogre::PixelUtil::bulkPixelConversion(src, buffer->getCurrentLock());
+		buffer->unlock();
+	}
+
 	void DataManager::_updateVolTextureData(Cell ***c, const VolTextureId& TexId, const int& nx, const int& ny, const int& nz)
 	{
 		Ogre::HardwarePixelBufferSharedPtr buffer = mVolTextures[TexId]->getBuffer(0,0);
-		
-		buffer->lock(Ogre::HardwareBuffer::HBL_DISCARD);
-		const Ogre::PixelBox &pb = buffer->getCurrentLock();
-
-		Ogre::uint32 *pbptr = static_cast<Ogre::uint32*>(pb.data);
-		size_t x, y, z;
-
-		for (z=pb.front; z<pb.back; z++) 
-        {
-            for (y=pb.top; y<pb.bottom; y++)
-            {
-                for (x=pb.left; x<pb.right; x++)
+
+		// Pack cells into the staging buffer, x-major like the texture layout
+		Ogre::uint32 *sptr = &mStaging[0];
+		int x, y, z;
+
+		for (z = 0; z < nz; z++) 
+		{
+			for (y = 0; y < ny; y++)
+			{
+				for (x = 0; x < nx; x++)
 				{
-					Ogre::PixelUtil::packColour(c[x][y][z].dens/* TODO!!!! */, c[x][y][z].light, 0, 0, pb.format, &pbptr[x]);
-                } 
-                pbptr += pb.rowPitch;
-            }
-            pbptr += pb.getSliceSkip();
-        }
+					Ogre::PixelUtil::packColour(c[x][y][z].dens/* TODO!!!! */, c[x][y][z].light, 0, 0, Ogre::PF_A8R8G8B8, sptr++);
+				}
+			}
+		}
 
-		buffer->unlock();
+		// Nothing trusted on the GPU side yet, upload everything at once
+		if (!mUploadedValid[TexId])
+		{
+			_uploadBox(buffer, Ogre::Box(0, 0, 0, nx, ny, nz), true);
+
+			mUploaded[TexId] = mStaging;
+			mUploadedValid[TexId] = true;
+			mLastUploadedBricks = static_cast<int>(mBricks.size());
+
+			return;
+		}
+
+		// Only upload bricks whose packed texels actually changed
+		std::vector<Ogre::Box> dirty;
+		std::vector<Ogre::Box>::const_iterator bIt;
+
+		for (bIt = mBricks.begin(); bIt != mBricks.end(); bIt++)
+		{
+			if (_isBrickDirty(*bIt, TexId))
+			{
+				dirty.push_back(*bIt);
+			}
+		}
+
+		mLastUploadedBricks = static_cast<int>(dirty.size());
+
+		if (dirty.empty())
+		{
+			return;
+		}
+
+		if (dirty.size() == mBricks.size())
+		{
+			// Whole volume changed: one discarding lock beats many sub-box transfers
+			_uploadBox(buffer, Ogre::Box(0, 0, 0, nx, ny, nz), true);
+			mUploaded[TexId] = mStaging;
+
+			return;
+		}
+
+		for (bIt = dirty.begin(); bIt != dirty.end(); bIt++)
+		{
+			_uploadBox(buffer, *bIt, false);
+
+			const size_t rowSize = bIt->getWidth()*sizeof(Ogre::uint32);
+			for (z = bIt->front; z < static_cast<int>(bIt->back); z++)
+			{
+				for (y = bIt->top; y < static_cast<int>(bIt->bottom); y++)
+				{
+					const size_t offset = (z*ny + y)*nx + bIt->left;
+					memcpy(&mUploaded[TexId][offset], &mStaging[offset], rowSize);
+				}
+			}
+		}
 	}
 }}
\ No newline at end of file
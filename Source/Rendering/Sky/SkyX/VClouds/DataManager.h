@@ -140,6 +140,52 @@ namespace SkyX { namespace VClouds{
 		 */
 		void forceToUpdateData();
 
+		/** Set brick size
+		    @param BrickSize Edge length, in cells, of the bricks used to track volumetric texture changes
+			@remarks Only bricks whose packed data changed are uploaded, a full upload is forced after this call
+		 */
+		void setBrickSize(const int& BrickSize);
+
+		/** Get brick size
+		    @return Brick edge length, in cells
+		 */
+		inline const int& getBrickSize() const
+		{
+			return mBrickSize;
+		}
+
+		/** Use the persistent staging buffer for uploads
+		    @param UseStagingBuffer true to blit dirty bricks from the staging buffer, false to lock and fill each dirty sub-box
+		 */
+		inline void setUseStagingBuffer(const bool& UseStagingBuffer)
+		{
+			mUseStagingBuffer = UseStagingBuffer;
+		}
+
+		/** Is the persistent staging buffer used for uploads?
+		    @return true if dirty bricks are blitted from the staging buffer
+		 */
+		inline const bool& isUsingStagingBuffer() const
+		{
+			return mUseStagingBuffer;
+		}
+
+		/** Get the number of bricks uploaded in the last volumetric texture update
+		    @return Number of dirty bricks uploaded
+		 */
+		inline const int& getLastUploadedBricks() const
+		{
+			return mLastUploadedBricks;
+		}
+
+		/** Get the number of bricks the volumetric textures are divided into
+		    @return Number of bricks
+		 */
+		inline const int getNumberOfBricks() const
+		{
+			return static_cast<int>(mBricks.size());
+		}
+
 	private:
 
 		/** Initialize data
@@ -193,6 +239,27 @@ namespace SkyX { namespace VClouds{
 		 */
 		void _updateVolTextureData(Cell ***c, const VolTextureId& TexId, const int& nx, const int& ny, const int& nz);
 
+		/** Build the brick list and (re)allocate staging data
+		    @param nx X size
+			@param ny Y size
+			@param nz Z size
+		 */
+		void _createBricks(const int& nx, const int& ny, const int& nz);
+
+		/** Has a brick changed since the last upload to a volumetric texture?
+		    @param b Brick box
+			@param TexId Texture Id
+			@return true if any packed texel differs from the uploaded data
+		 */
+		const bool _isBrickDirty(const Ogre::Box& b, const VolTextureId& TexId) const;
+
+		/** Upload a region of the staging data to a volumetric texture
+		    @param buffer Volumetric texture pixel buffer
+			@param b Region to upload
+			@param discard Discard the whole buffer contents (full uploads only)
+		 */
+		void _uploadBox(const Ogre::HardwarePixelBufferSharedPtr& buffer, const Ogre::Box& b, const bool& discard);
+
 		/** Get continous density at a point
 		    @param c Cells data
 			@param nx X size
@@ -283,6 +350,21 @@ namespace SkyX { namespace VClouds{
 		/// Current texture
 		bool mVolTexToUpdate;
 
+		/// Brick edge length, in cells
+		int mBrickSize;
+		/// Bricks the volumetric textures are divided into
+		std::vector<Ogre::Box> mBricks;
+		/// Persistent staging buffer, packed texels of the last computed data
+		std::vector<Ogre::uint32> mStaging;
+		/// Packed texels last uploaded to each volumetric texture
+		std::vector<Ogre::uint32> mUploaded[2];
+		/// Does mUploaded hold valid data for each volumetric texture?
+		bool mUploadedValid[2];
+		/// Upload dirty bricks through blitFromMemory(...) instead of sub-box locks
+		bool mUseStagingBuffer;
+		/// Bricks uploaded in the last volumetric texture update
+		int mLastUploadedBricks;
+
 		/// Has been create(...) already called?
 		bool mCreated;
 
@@ -25,6 +25,12 @@ http://www.gnu.org/copyleft/lesser.txt.
 
 #include "VClouds/VClouds.h"
 
+#include <OgrePlatformInformation.h>
+
+#if __OGRE_HAVE_SSE
+#include <xmmintrin.h>
+#endif
+
 namespace SkyX { namespace VClouds
 {
 	GeometryBlock::GeometryBlock(VClouds* vc,
@@ -36,7 +42,6 @@ namespace SkyX { namespace VClouds
 		, mCreated(false)
 		, mSubMesh(0)
 		, mEntity(0)
-		, mVertices(0)
 		, mNumberOfTriangles(0)
 		, mVertexCount(0)
 		, mHeight(Height)
@@ -52,6 +57,13 @@ namespace SkyX { namespace VClouds
 		, mCamera(0)
 		, mDistance(Ogre::Vector3(0,0,0))
 		, mLastFallingDistance(0)
+		, mRegenerationTolerance(0.0005f)
+		, mGeometryDirty(true)
+		, mGeneratedCamera(0)
+		, mGeneratedOpacity(0)
+		, mGeneratedFallingParams(Ogre::Vector2(0,0))
+		, mGeneratedFieldScale(0), mGeneratedNoiseScale(0)
+		, mUploadedWorldOffset(Ogre::Vector2(0,0))
 	{
 		_calculateDataSize();
 	}
@@ -109,7 +121,10 @@ namespace SkyX { namespace VClouds
 		mVertexBuffer.setNull();
 		mIndexBuffer.setNull();
 
-		delete [] mVertices;
+		mVertices.clear();
+
+		mGeometryDirty = true;
+		mGeneratedCamera = 0;
 
 		mCreated = false;
 	}
@@ -168,7 +183,7 @@ namespace SkyX { namespace VClouds
 		mVertexBuffer = Ogre::HardwareBufferManager::getSingleton().
 			createVertexBuffer(sizeof(VERTEX),
 			                   mVertexCount,
-			                   Ogre::HardwareBuffer::HBU_DYNAMIC_WRITE_ONLY);
+			                   Ogre::HardwareBuffer::HBU_DYNAMIC_WRITE_ONLY_DISCARDABLE);
 
 		vbind->setBinding(0, mVertexBuffer);
 
@@ -274,7 +289,8 @@ namespace SkyX { namespace VClouds
 		mSubMesh->indexData->indexCount = mNumberOfTriangles*3;
 
 	    // Create our internal buffer for manipulations
-		mVertices = new VERTEX[mVertexCount];
+		mVertices.resize(mVertexCount);
+		mGeometryDirty = true;
 	}
 
 	void GeometryBlock::updateGeometry(Ogre::Camera* c, const Ogre::Vector3& displacement, const Ogre::Vector3& distance)
@@ -284,8 +300,6 @@ namespace SkyX { namespace VClouds
 			return;
 		}
 
-		mDisplacement = displacement;
-
 		float fallingDistance = mVClouds->getDistanceFallingParams().x*(mEntity->getParentSceneNode()->_getDerivedPosition().y-c->getDerivedPosition().y);
 
 		if (mVClouds->getDistanceFallingParams().y > 0) // -1 means no max falling
@@ -312,12 +326,44 @@ namespace SkyX { namespace VClouds
 			mMesh->_setBounds(_buildAABox(mLastFallingDistance));
 		}
 
-		if (isInFrustum(c))
+		if (!isInFrustum(c))
+		{
+			return;
+		}
+
+		if (_needsRegeneration(c, displacement, distance))
 		{
 			mCamera = c;
+			mDisplacement = displacement;
 			mDistance = distance;
 			_updateGeometry();
+			_uploadGeometry();
+		}
+		else if (mWorldOffset != mUploadedWorldOffset)
+		{
+			// Wind/camera drift only shifts 3D and noise coords
+			_uploadGeometry();
+		}
+	}
+
+	const bool GeometryBlock::_needsRegeneration(Ogre::Camera* c, const Ogre::Vector3& displacement, const Ogre::Vector3& distance) const
+	{
+		if (mGeometryDirty || c != mGeneratedCamera)
+		{
+			return true;
+		}
+
+		const float tolerance = mRegenerationTolerance*mRadius;
+
+		if (!displacement.positionEquals(mDisplacement, tolerance) || !distance.positionEquals(mDistance, tolerance))
+		{
+			return true;
 		}
+
+		return mVClouds->getGlobalOpacity() != mGeneratedOpacity ||
+			   mVClouds->getDistanceFallingParams() != mGeneratedFallingParams ||
+			   mVClouds->getCloudFieldScale() != mGeneratedFieldScale ||
+			   mVClouds->getNoiseScale() != mGeneratedNoiseScale;
 	}
 
 	void GeometryBlock::_updateGeometry()
@@ -340,12 +386,148 @@ namespace SkyX { namespace VClouds
 			_updateZoneASlice(k);
 		}
 
-		// Upload changes
-		mVertexBuffer->
-				writeData(0,
-		                  mVertexBuffer->getSizeInBytes(),
-	                      mVertices,
-		                  true);
+		_generateVertexAttributes();
+
+		mGeneratedCamera = mCamera;
+		mGeneratedOpacity = mVClouds->getGlobalOpacity();
+		mGeneratedFallingParams = mVClouds->getDistanceFallingParams();
+		mGeneratedFieldScale = mVClouds->getCloudFieldScale();
+		mGeneratedNoiseScale = mVClouds->getNoiseScale();
+		mGeometryDirty = false;
+	}
+
+	void GeometryBlock::_generateVertexAttributes()
+	{
+		const Ogre::Vector2& fp = mVClouds->getDistanceFallingParams();
+
+		const float yDist = -mDistance.y;
+		const bool overCloud = yDist < -mHeight/2;
+		const float fallingScale = fp.x*yDist/mRadius;
+		const float maxFalling = (fp.y > 0) ? fp.y : std::numeric_limits<float>::max(); // -1 means no max falling
+		const float fallingSign = Ogre::Math::Sign(yDist);
+		const float scale = mVClouds->getCloudFieldScale()/mRadius;
+		const float noiseScale = mVClouds->getNoiseScale()/mRadius;
+		const float originBase = -(mEntity->getParentSceneNode()->_getDerivedPosition().y-mCamera->getDerivedPosition().y) - 0.5f*mRadius;
+		const float attDist = mA/3.25f;
+		const float globalOpacity = mVClouds->getGlobalOpacity();
+
+		VertexCache& vc = mVertices;
+		int k = 0;
+
+#if __OGRE_HAVE_SSE
+		const __m128 vFallingScale = _mm_set1_ps(fallingScale),
+			         vMaxFalling   = _mm_set1_ps(maxFalling),
+					 vMinFalling   = _mm_set1_ps(-maxFalling),
+					 vFallingSign  = _mm_set1_ps(fallingSign),
+					 vHeight       = _mm_set1_ps(mHeight),
+					 vScale        = _mm_set1_ps(scale),
+					 vNoiseScale   = _mm_set1_ps(noiseScale),
+					 vOriginBase   = _mm_set1_ps(originBase),
+					 vDistanceX    = _mm_set1_ps(mDistance.x),
+					 vDistanceY    = _mm_set1_ps(mDistance.y),
+					 vDistanceZ    = _mm_set1_ps(mDistance.z),
+					 vAttDist      = _mm_set1_ps(attDist),
+					 vOpacity      = _mm_set1_ps(globalOpacity),
+					 vHalf         = _mm_set1_ps(0.5f),
+					 vZero         = _mm_setzero_ps(),
+					 vOne          = _mm_set1_ps(1.0f);
+
+		for (; k + 4 <= mVertexCount; k += 4)
+		{
+			const __m128 px = _mm_loadu_ps(&vc.px[k]),
+				         py = _mm_loadu_ps(&vc.py[k]),
+						 pz = _mm_loadu_ps(&vc.pz[k]);
+
+			const __m128 len = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(px, px), _mm_mul_ps(pz, pz)));
+
+			// Falling distance
+			__m128 falling = _mm_min_ps(_mm_max_ps(_mm_mul_ps(vFallingScale, len), vMinFalling), vMaxFalling);
+			falling = _mm_mul_ps(falling, vFallingSign);
+
+			// Position
+			_mm_storeu_ps(&vc.y[k], overCloud ? _mm_sub_ps(vHeight, py) : _mm_sub_ps(py, falling));
+
+			// 3D coords (Z-UP)
+			_mm_storeu_ps(&vc.xc[k], _mm_mul_ps(px, vScale));
+			_mm_storeu_ps(&vc.yc[k], _mm_mul_ps(pz, vScale));
+			__m128 zc = _mm_min_ps(_mm_max_ps(_mm_div_ps(py, vHeight), vZero), vOne);
+			_mm_storeu_ps(&vc.zc[k], overCloud ? _mm_sub_ps(vOne, zc) : zc);
+
+			// Noise coords
+			const __m128 oy = _mm_sub_ps(vOriginBase, _mm_mul_ps(vHalf, len)),
+				         dy = _mm_sub_ps(py, oy);
+			const __m128 hip = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(len, len), _mm_mul_ps(oy, oy))),
+				         dirLength = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(px, px), _mm_mul_ps(dy, dy)), _mm_mul_ps(pz, pz)));
+			const __m128 uvScale = _mm_mul_ps(_mm_div_ps(hip, dirLength), vNoiseScale);
+			_mm_storeu_ps(&vc.u[k], _mm_mul_ps(px, uvScale));
+			_mm_storeu_ps(&vc.v[k], _mm_mul_ps(pz, uvScale));
+
+			// Opacity
+			const __m128 ex = _mm_sub_ps(vDistanceX, px),
+				         ey = _mm_sub_ps(vDistanceY, _mm_sub_ps(py, falling)),
+						 ez = _mm_sub_ps(vDistanceZ, pz);
+			const __m128 dist = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(ex, ex), _mm_mul_ps(ey, ey)), _mm_mul_ps(ez, ez)));
+			const __m128 att = _mm_min_ps(_mm_max_ps(_mm_div_ps(_mm_sub_ps(dist, vAttDist), vAttDist), vZero), vOne);
+			_mm_storeu_ps(&vc.o[k], _mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(&vc.po[k]), att), vOpacity));
+		}
+#endif
+
+		// Scalar path, also the SSE tail
+		for (; k < mVertexCount; k++)
+		{
+			const float px = vc.px[k], py = vc.py[k], pz = vc.pz[k];
+			const float len = Ogre::Math::Sqrt(px*px + pz*pz);
+
+			// Falling distance
+			const float falling = Ogre::Math::Clamp(fallingScale*len, -maxFalling, maxFalling)*fallingSign;
+
+			// Position
+			vc.y[k] = overCloud ? (mHeight - py) : (py - falling);
+
+			// 3D coords (Z-UP)
+			vc.xc[k] = px*scale;
+			vc.yc[k] = pz*scale;
+			const float zc = Ogre::Math::Clamp<Ogre::Real>(py/mHeight, 0, 1);
+			vc.zc[k] = overCloud ? (1.0f - zc) : zc;
+
+			// Noise coords
+			const float oy = originBase - 0.5f*len,
+				        dy = py - oy;
+			const float uvScale = Ogre::Math::Sqrt(len*len + oy*oy)/Ogre::Math::Sqrt(px*px + dy*dy + pz*pz)*noiseScale;
+			vc.u[k] = px*uvScale;
+			vc.v[k] = pz*uvScale;
+
+			// Opacity
+			const float dist = (mDistance - Ogre::Vector3(px, py - falling, pz)).length();
+			const float att = Ogre::Math::Clamp((dist-attDist)/attDist, 0.0f, 1.0f);
+			vc.o[k] = vc.po[k]*att*globalOpacity;
+		}
+	}
+
+	void GeometryBlock::_uploadGeometry()
+	{
+		const Ogre::Vector2 xcOffset = mWorldOffset*(mVClouds->getCloudFieldScale()/mRadius),
+			                uvOffset = mWorldOffset*(mVClouds->getNoiseScale()/mRadius);
+
+		// Write straight into the locked buffer, no intermediate copy
+		VERTEX *vertices = static_cast<VERTEX*>(mVertexBuffer->lock(Ogre::HardwareBuffer::HBL_DISCARD));
+
+		for (int k = 0; k < mVertexCount; k++)
+		{
+			vertices[k].x  = mVertices.px[k];
+			vertices[k].y  = mVertices.y[k];
+			vertices[k].z  = mVertices.pz[k];
+			vertices[k].xc = mVertices.xc[k] + xcOffset.x;
+			vertices[k].yc = mVertices.yc[k] + xcOffset.y;
+			vertices[k].zc = mVertices.zc[k];
+			vertices[k].u  = mVertices.u[k] + uvOffset.x;
+			vertices[k].v  = mVertices.v[k] + uvOffset.y;
+			vertices[k].o  = mVertices.o[k];
+		}
+
+		mVertexBuffer->unlock();
+
+		mUploadedWorldOffset = mWorldOffset;
 	}
 
 	void GeometryBlock::_updateZoneCSlice(const int& n)
@@ -488,67 +670,25 @@ namespace SkyX { namespace VClouds
 
 	void GeometryBlock::_setVertexData(const int& index, const Ogre::Vector3& p, const float& o)
 	{
-		float yDist = -mDistance.y;
-		float fallingDistance = mVClouds->getDistanceFallingParams().x*yDist*(Ogre::Vector2(p.x,p.z).length()/mRadius);
-		
-		if (mVClouds->getDistanceFallingParams().y > 0) // -1 means no max falling
-		{
-			if (fallingDistance > 0)
-			{
-				if (fallingDistance > mVClouds->getDistanceFallingParams().y)
-				{
-					fallingDistance = mVClouds->getDistanceFallingParams().y;
-				}
-			}
-			else
-			{
-				if (-fallingDistance > mVClouds->getDistanceFallingParams().y)
-				{
-					fallingDistance = -mVClouds->getDistanceFallingParams().y;
-				}
-			}
-		}
+		mVertices.px[index] = p.x;
+		mVertices.py[index] = p.y;
+		mVertices.pz[index] = p.z;
+		mVertices.po[index] = o;
+	}
 
-		fallingDistance *= Ogre::Math::Sign(yDist);
-		
-		// Position
-		mVertices[index].x = p.x;
-		if (yDist < -mHeight/2)
-		{
-			// Over-cloud
-			mVertices[index].y = mHeight - p.y;
-		}
-		else // Under-cloud
-		{
-			mVertices[index].y = p.y - fallingDistance;
-		}
-		mVertices[index].z = p.z;
-
-		// 3D coords (Z-UP)
-		float scale = mVClouds->getCloudFieldScale()/mRadius;
-		mVertices[index].xc = (p.x+mWorldOffset.x)*scale;
-		mVertices[index].yc = (p.z+mWorldOffset.y)*scale;
-		mVertices[index].zc = Ogre::Math::Clamp<Ogre::Real>(p.y/mHeight, 0, 1);
-		if (yDist < -mHeight/2)
+	void GeometryBlock::VertexCache::resize(const int& n)
+	{
+		std::vector<float>* arrays[] = {&px, &py, &pz, &po, &y, &xc, &yc, &zc, &u, &v, &o};
+
+		for (int k = 0; k < 11; k++)
 		{
-			// Over-cloud
-			mVertices[index].zc = 1.0f - mVertices[index].zc;
+			arrays[k]->assign(n, 0.0f);
 		}
+	}
 
-		// Noise coords
-		float noise_scale = mVClouds->getNoiseScale()/mRadius;
-		float xz_length_radius = Ogre::Vector2(p.x,p.z).length() / mRadius;
-		Ogre::Vector3 origin = Ogre::Vector3(0,-(mEntity->getParentSceneNode()->_getDerivedPosition().y-mCamera->getDerivedPosition().y) -mRadius*(0.5f+0.5f*Ogre::Vector2(p.x,p.z).length()/mRadius),0);
-		Ogre::Vector3 dir = (p-origin).normalisedCopy();
-		float hip = Ogre::Math::Sqrt(Ogre::Math::Pow(xz_length_radius * mRadius, 2) + Ogre::Math::Pow(origin.y, 2));
-		Ogre::Vector3 uv = dir*hip; // Only x/z, += origin doesn't need
-		mVertices[index].u = (uv.x+mWorldOffset.x)*noise_scale;
-		mVertices[index].v = (uv.z+mWorldOffset.y)*noise_scale;
-
-		// Opacity
-		float dist = (mDistance - Ogre::Vector3(p.x, p.y - fallingDistance, p.z)).length();
-		float att = Ogre::Math::Clamp((dist-mA/3.25f)/(mA/3.25f),0.0f,1.0f);
-		mVertices[index].o = o * att * mVClouds->getGlobalOpacity();
+	void GeometryBlock::VertexCache::clear()
+	{
+		resize(0);
 	}
 
 	const bool GeometryBlock::isInFrustum(Ogre::Camera *c) const
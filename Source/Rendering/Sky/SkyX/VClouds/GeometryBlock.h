@@ -147,6 +147,30 @@ namespace SkyX { namespace VClouds{
 		 */
 		const bool isInFrustum(Ogre::Camera *c) const;
 
+		/** Set regeneration tolerance
+		    @param Tolerance Camera-relative change, as a fraction of the block radius, under which slice vertices are not regenerated
+			@remarks 0 regenerates on any change
+		 */
+		inline void setRegenerationTolerance(const float& Tolerance)
+		{
+			mRegenerationTolerance = Tolerance;
+		}
+
+		/** Get regeneration tolerance
+		    @return Regeneration tolerance, as a fraction of the block radius
+		 */
+		inline const float& getRegenerationTolerance() const
+		{
+			return mRegenerationTolerance;
+		}
+
+		/** Force slice vertices to be regenerated in the next updateGeometry(...) call
+		 */
+		inline void invalidate()
+		{
+			mGeometryDirty = true;
+		}
+
 	private:
 		/** Build axis aligned box
 		    @param fd Falling distance (Positive values for falling geometry, negative for reverse falling geometry)
@@ -165,6 +189,23 @@ namespace SkyX { namespace VClouds{
 		 */
 		void _updateGeometry();
 
+		/** Do the camera-relative parameters differ enough from the last generated ones to regenerate?
+		    @param c Camera
+		    @param displacement Current offset in world units per zone
+			@param distance Current camera to cloud field distance
+			@return true if slice vertices must be regenerated
+		 */
+		const bool _needsRegeneration(Ogre::Camera* c, const Ogre::Vector3& displacement, const Ogre::Vector3& distance) const;
+
+		/** Compute per-vertex attributes (falling, 3D/noise coords, opacity) from slice positions
+		    @remarks SSE path processes four vertices at once, the scalar path handles the rest
+		 */
+		void _generateVertexAttributes();
+
+		/** Write generated vertices plus the current world offset into the hardware buffer
+		 */
+		void _uploadGeometry();
+
 		/** Update zone C slice
 		    @param n Number of slice
 		 */
@@ -180,10 +221,11 @@ namespace SkyX { namespace VClouds{
 		 */
 		void _updateZoneASlice(const int& n);
 
-		/** Set vertex data
+		/** Set vertex slice data
 			@param index Vertex index
 			@param o Slice opacity
 			@param p Position
+			@remarks Attributes are computed later, in _generateVertexAttributes()
 		 */
 		void _setVertexData(const int& index, const Ogre::Vector3& p, const float& o);
 
@@ -202,8 +244,22 @@ namespace SkyX { namespace VClouds{
         /// Index buffer
         Ogre::HardwareIndexBufferSharedPtr  mIndexBuffer;
 
-		/// Vertices pointer
-		VERTEX *mVertices;
+		/** Generated vertex data, structure of arrays. World offset is not applied
+		    so wind/camera drift only needs _uploadGeometry()
+		 */
+		struct VertexCache
+		{
+			/// Slice position and opacity
+			std::vector<float> px, py, pz, po;
+			/// Output height, 3D coords, noise coords and opacity
+			std::vector<float> y, xc, yc, zc, u, v, o;
+
+			void resize(const int& n);
+			void clear();
+		};
+
+		/// Vertices cache
+		VertexCache mVertices;
 
 		/// Current number of triangles
 		int mNumberOfTriangles;
@@ -247,6 +303,18 @@ namespace SkyX { namespace VClouds{
 
 		/// Last falling distance
 		float mLastFallingDistance;
+
+		/// Regeneration tolerance, fraction of mRadius
+		float mRegenerationTolerance;
+		/// Must slice vertices be regenerated regardless of tolerance?
+		bool mGeometryDirty;
+		/// Parameters the cached vertices were generated with
+		Ogre::Camera* mGeneratedCamera;
+		float mGeneratedOpacity;
+		Ogre::Vector2 mGeneratedFallingParams;
+		float mGeneratedFieldScale, mGeneratedNoiseScale;
+		/// World offset written in the hardware buffer
+		Ogre::Vector2 mUploadedWorldOffset;
 	};
 
 
@@ -40,6 +40,7 @@ namespace SkyX { namespace VClouds
 		, mNa(0), mNb(0), mNc(0)
 		, mA(0), mB(0), mC(0)
 		, mWorldOffset(Ogre::Vector2(0,0))
+		, mRegenerationTolerance(0.0005f)
 		, mCurrentDistance(Ogre::Vector3(0,0,0))
 	{
 	}
@@ -114,6 +115,24 @@ namespace SkyX { namespace VClouds
 		_updateGeometry(c, timeSinceLastCameraFrame);
 	}
 
+	void GeometryManager::setRegenerationTolerance(const float& Tolerance)
+	{
+		mRegenerationTolerance = Tolerance;
+
+		for(Ogre::uint32 k = 0; k < mGeometryBlocks.size(); k++)
+		{
+			mGeometryBlocks.at(k)->setRegenerationTolerance(Tolerance);
+		}
+	}
+
+	void GeometryManager::invalidateGeometry()
+	{
+		for(Ogre::uint32 k = 0; k < mGeometryBlocks.size(); k++)
+		{
+			mGeometryBlocks.at(k)->invalidate();
+		}
+	}
+
 	void GeometryManager::_setMaterialName(const Ogre::String& mn)
 	{
 		for(Ogre::uint32 k = 0; k < mGeometryBlocks.size(); k++)
@@ -139,6 +158,7 @@ namespace SkyX { namespace VClouds
 		for (int k = 0; k < mNumberOfBlocks; k++)
 		{
 			mGeometryBlocks.push_back(new GeometryBlock(mVClouds, mHeight.y, mAlpha, mBeta, mRadius, mPhi, mNa, mNb, mNc, mA, mB, mC, k));
+			mGeometryBlocks.at(k)->setRegenerationTolerance(mRegenerationTolerance);
 			mGeometryBlocks.at(k)->create();
 			// Each geometry block must be in a different scene node, See: GeometryBlock::isInFrustum(Ogre::Camera *c)
 			Ogre::SceneNode *sn = mSceneNode->createChildSceneNode();
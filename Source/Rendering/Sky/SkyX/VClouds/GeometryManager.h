@@ -97,6 +97,24 @@ namespace SkyX { namespace VClouds{
 			return mHeight;
 		}
 
+		/** Set geometry blocks regeneration tolerance
+		    @param Tolerance Camera-relative change, as a fraction of the field radius, under which blocks keep their vertices
+			@remarks See GeometryBlock::setRegenerationTolerance(...)
+		 */
+		void setRegenerationTolerance(const float& Tolerance);
+
+		/** Get geometry blocks regeneration tolerance
+		    @return Regeneration tolerance, as a fraction of the field radius
+		 */
+		inline const float& getRegenerationTolerance() const
+		{
+			return mRegenerationTolerance;
+		}
+
+		/** Force all geometry blocks to regenerate their vertices in the next update
+		 */
+		void invalidateGeometry();
+
 		/** Set material name
 		    @param mn Material name
 		    @remarks Only for internal use
@@ -150,6 +168,9 @@ namespace SkyX { namespace VClouds{
 		/// World coords offset
 		Ogre::Vector2 mWorldOffset;
 
+		/// Geometry blocks regeneration tolerance
+		float mRegenerationTolerance;
+
 		/// Geometry blocks
 		std::vector<GeometryBlock*> mGeometryBlocks;
 
@@ -25,27 +25,22 @@ http://www.gnu.org/copyleft/lesser.txt.
 
 namespace SkyX { namespace VClouds
 {
-	Lightning::Lightning(Ogre::SceneManager* sm, Ogre::SceneNode* sn, const Ogre::Vector3& orig, const Ogre::Vector3& dir, 
-		const Ogre::Real& l, const Ogre::uint32& d, const Ogre::uint32& rec, const Ogre::Real& tm, const Ogre::Real& wm, const Ogre::Vector2& b)
-		: mOrigin(orig)
-		, mDirection(dir)
-		, mLength(l)
-		, mRealLength(0)
-		, mDivisions(d)
-		, mRecursivity(rec)
+	Lightning::Lightning(Ogre::SceneManager* sm, Ogre::SceneNode* sn)
+		: mDirection(Ogre::Vector3::NEGATIVE_UNIT_Y)
+		, mLength(0)
+		, mRecursivity(0)
+		, mBounds(Ogre::Vector2(0,1))
 		, mTime(0)
-		, mTimeMultiplier(tm)
+		, mTimeMultiplier(1)
+		, mTimeMultipliers(Ogre::Vector3(1,1,1))
 		, mIntensity(0)
-		, mWidthMultiplier(wm)
-		, mBounds(b)
-		, mAngleRange(Ogre::Vector2(Ogre::Math::RangeRandom(0.3,0.5), Ogre::Math::RangeRandom(0.6,0.8)))
-		, mTimeMultipliers(Ogre::Vector3(Ogre::Math::RangeRandom(1.75,4.25), Ogre::Math::RangeRandom(0.4,1.25f), Ogre::Math::RangeRandom(0.2,1.0f)))
-		, mSegments(std::vector<Lightning::Segment>())
 		, mChildren(std::vector<Lightning*>())
+		, mActiveChildren(0)
 		, mBillboardSet(0)
 		, mSceneManager(sm)
 		, mSceneNode(sn)
 		, mCreated(false)
+		, mActive(false)
 		, mFinished(false)
 	{
 	}
@@ -59,128 +54,172 @@ namespace SkyX { namespace VClouds
 	{
 		remove();
 
-		Ogre::Vector3 end = mOrigin + mDirection*mLength;
-		Ogre::Vector3 current, last = mOrigin;
+		// Create the associated billboard set, sized for the longest rays (three billboards per segment)
+		mBillboardSet = mSceneManager->createBillboardSet(96);
+		mBillboardSet->setMaterialName("SkyX_Lightning");
+		mBillboardSet->setBillboardType(Ogre::BBT_ORIENTED_SELF);
+		mBillboardSet->setCustomParameter(0, Ogre::Vector4(1,0,0,0));
+		mBillboardSet->setVisible(false);
 
-		// Create ray segments
-		for(Ogre::uint32 k = 1; k < mDivisions+1; k++)
+		mSceneNode->attachObject(mBillboardSet);
+
+		mCreated = true;
+	}
+
+	void Lightning::remove()
+	{
+		if (!mCreated)
+		{
+			return;
+		}
+
+		mSceneNode->detachObject(mBillboardSet);
+		mSceneManager->destroyBillboardSet(mBillboardSet);
+		mBillboardSet = 0;
+
+		for(Ogre::uint32 k = 0; k < mChildren.size(); k++)
 		{
-			Ogre::Vector3 current = mOrigin + mDirection*mLength*(static_cast<Ogre::Real>(k)/mDivisions);
+			delete mChildren.at(k);
+		}
 
-			current += (mLength/(mDivisions*3))*Ogre::Vector3(
-				Ogre::Math::RangeRandom(-1, 1), Ogre::Math::RangeRandom(-1, 1), Ogre::Math::RangeRandom(-1, 1));
+		mChildren.clear();
+		mActiveChildren = 0;
 
-			mSegments.push_back(Segment(last, current));
+		mActive = false;
+		mFinished = false;
 
-			mRealLength += (current-last).length();
+		mCreated = false;
+	}
 
-			last = current;
+	void Lightning::start(const Path& path, const Ogre::Quaternion& q, const Ogre::Real& l, const Ogre::Real& tm, const Ogre::Real& wm)
+	{
+		if (!mCreated || path.segments.empty())
+		{
+			return;
 		}
 
-		// Create the associated billboard set
-		mBillboardSet = mSceneManager->createBillboardSet();
-		mBillboardSet->setMaterialName("SkyX_Lightning");
-		mBillboardSet->setBillboardType(Ogre::BBT_ORIENTED_SELF);
+		mDirection = q * (path.segments.back().b - path.segments.front().a).normalisedCopy();
+		mLength = l;
+		mRecursivity = path.recursivity;
+		mBounds = path.bounds;
+		mTime = 0;
+		mTimeMultiplier = tm;
+		mTimeMultipliers = Ogre::Vector3(Ogre::Math::RangeRandom(1.75,4.25), Ogre::Math::RangeRandom(0.4,1.25f), Ogre::Math::RangeRandom(0.2,1.0f));
+		mIntensity = 0;
 
-		Ogre::Real width = mWidthMultiplier*3*(static_cast<Ogre::Real>(mRecursivity)/4+1)*Ogre::Math::RangeRandom(0.5f, 2.5f-mRecursivity/3);
+		// Fill the billboards from the path, the billboard pool is reused so no allocation happens once warmed up
+		mBillboardSet->clear();
 
-		// Create the associated billboard for each segment
-		Ogre::Real delta;
+		Ogre::Real width = wm*path.width;
+
+		Ogre::Real delta = 1.0f / path.segments.size();
 		Ogre::Vector2 bounds;
+		Ogre::Vector3 a, b, dir;
 		Ogre::Billboard* bb;
-		for(Ogre::uint32 k = 0; k < mSegments.size(); k++)
+		for(Ogre::uint32 k = 0; k < path.segments.size(); k++)
 		{
-			delta = 1.0f / mSegments.size();
+			a = q * (path.segments[k].a*l);
+			b = q * (path.segments[k].b*l);
+			dir = (a-b).normalisedCopy();
+
 			bounds = Ogre::Vector2(k*delta,(k+1)*delta);
 
 			bounds = Ogre::Vector2(mBounds.x, mBounds.x) + bounds*(mBounds.y-mBounds.x);
 
-			bb = mBillboardSet->createBillboard((mSegments.at(k).a+mSegments.at(k).b)/2);
-			bb->setDimensions(width, (mSegments.at(k).a-mSegments.at(k).b).length());
+			bb = mBillboardSet->createBillboard((a+b)/2);
+			bb->setDimensions(width, (a-b).length());
 			bb->setColour(Ogre::ColourValue(0,bounds.x,bounds.y));
-			bb->mDirection = (mSegments.at(k).a-mSegments.at(k).b).normalisedCopy();
+			bb->mDirection = dir;
 
-			bb = mBillboardSet->createBillboard(mSegments.at(k).a + (mSegments.at(k).a-mSegments.at(k).b).normalisedCopy()*width/2);
+			bb = mBillboardSet->createBillboard(a + dir*width/2);
 			bb->setDimensions(width, width);
 			bb->setColour(Ogre::ColourValue(1,bounds.x,bounds.x));
-			bb->mDirection = (mSegments.at(k).a-mSegments.at(k).b).normalisedCopy();
+			bb->mDirection = dir;
 			
-			bb = mBillboardSet->createBillboard(mSegments.at(k).b - (mSegments.at(k).a-mSegments.at(k).b).normalisedCopy()*width/2);
+			bb = mBillboardSet->createBillboard(b - dir*width/2);
 			bb->setDimensions(width, width);
 			bb->setColour(Ogre::ColourValue(1,bounds.y,bounds.y));
-			bb->mDirection = -(mSegments.at(k).a-mSegments.at(k).b).normalisedCopy();
+			bb->mDirection = -dir;
 		
-			width *= 1-(1.0f/(mRecursivity*mRecursivity+1.0f))*(1.0f/mSegments.size());
+			width *= 1-(1.0f/(mRecursivity*mRecursivity+1.0f))*(1.0f/path.segments.size());
 		}
 
 		mBillboardSet->_updateBounds();
-
-		mSceneNode->attachObject(mBillboardSet);
-
 		mBillboardSet->setCustomParameter(0, Ogre::Vector4(1,0,0,0));
 
-		// Ramifications
-		if (mRecursivity > 0)
+		// Ramifications, reusing the children reserved up front (only paths that weren't reserved allocate here)
+		for(Ogre::uint32 k = 0; k < path.children.size(); k++)
 		{
-			Ogre::Real angle;
-			Ogre::Vector3 dir;
-			Ogre::Real lengthMult;
-			for (Ogre::uint32 k = 0; k < mDivisions-1; k++)
+			if (k == mChildren.size())
 			{
-				angle = (mSegments.at(k).b-mSegments.at(k).a).normalisedCopy().dotProduct(
-					((mSegments.at(k+1).b-mSegments.at(k+1).a).normalisedCopy()));
-
-				if (angle < Ogre::Math::RangeRandom(mAngleRange.x, mAngleRange.y))
-				{
-					dir = (mSegments.at(k).b-mSegments.at(k).a).normalisedCopy();
-					dir.x *= Ogre::Math::RangeRandom(0.8f, 1.2f);
-					dir.y *= Ogre::Math::RangeRandom(0.8f, 1.2f);
-					dir.z *= Ogre::Math::RangeRandom(0.8f, 1.2f);
-					dir.normalise();
-
-					delta = 1.0f / mSegments.size();
-					bounds = Ogre::Vector2(mBounds.x+(mBounds.y-mBounds.x)*(k+1)*delta,1);
+				_addChild();
+			}
 
-					lengthMult = Ogre::Math::RangeRandom(0.1f, 0.7f);
+			mChildren.at(k)->start(path.children.at(k), q, l, tm, wm);
+		}
 
-					Lightning* lightning = new Lightning(mSceneManager, mSceneNode, mSegments.at(k).b, dir, lengthMult*mLength, 2+mDivisions*lengthMult, mRecursivity-1, mTimeMultiplier, mWidthMultiplier, bounds);
-					lightning->create();
-					
-					mChildren.push_back(lightning);
-				}
-			}
+		for(Ogre::uint32 k = path.children.size(); k < mActiveChildren; k++)
+		{
+			mChildren.at(k)->stop();
 		}
 
-		mCreated = true;
+		mActiveChildren = path.children.size();
+
+		mActive = true;
+		mFinished = false;
 	}
 
-	void Lightning::remove()
+	void Lightning::stop()
 	{
-		if (!mCreated)
+		if (!mActive)
 		{
 			return;
 		}
 
-		mSceneNode->detachObject(mBillboardSet);
-		mSceneManager->destroyBillboardSet(mBillboardSet);
-
-		mSegments.clear();
+		mBillboardSet->clear();
+		mBillboardSet->setVisible(false);
 
-		for(Ogre::uint32 k = 0; k < mChildren.size(); k++)
+		for(Ogre::uint32 k = 0; k < mActiveChildren; k++)
 		{
-			delete mChildren.at(k);
+			mChildren.at(k)->stop();
 		}
 
-		mChildren.clear();
+		mActiveChildren = 0;
 
+		mActive = false;
 		mFinished = false;
+	}
 
-		mCreated = false;
+	void Lightning::reserve(const Path& path)
+	{
+		if (!mCreated)
+		{
+			return;
+		}
+
+		for(Ogre::uint32 k = 0; k < path.children.size(); k++)
+		{
+			if (k == mChildren.size())
+			{
+				_addChild();
+			}
+
+			mChildren.at(k)->reserve(path.children.at(k));
+		}
+	}
+
+	void Lightning::_addChild()
+	{
+		Lightning* lightning = new Lightning(mSceneManager, mSceneNode);
+		lightning->create();
+		lightning->_updateRenderQueueGroup(mBillboardSet->getRenderQueueGroup());
+
+		mChildren.push_back(lightning);
 	}
 
 	void Lightning::update(Ogre::Real timeSinceLastFrame)
 	{
-		if (!mCreated)
+		if (!mActive)
 		{
 			return;
 		}
@@ -240,6 +279,80 @@ namespace SkyX { namespace VClouds
 		_updateData(alpha, mTime > 1 ? 1 : mTime, mTime);
 	}
 
+	void Lightning::generatePath(Path& path, Random& r, const Ogre::Vector3& orig, const Ogre::Vector3& dir, const Ogre::Real& l, 
+		const Ogre::uint32& d, const Ogre::uint32& rec, const Ogre::Vector2& b)
+	{
+		path.segments.clear();
+		path.children.clear();
+		path.recursivity = rec;
+		path.bounds = b;
+
+		Ogre::Vector3 current, last = orig;
+
+		// Create ray segments
+		for(Ogre::uint32 k = 1; k < d+1; k++)
+		{
+			current = orig + dir*l*(static_cast<Ogre::Real>(k)/d);
+
+			current += (l/(d*3))*Ogre::Vector3(r.get(-1, 1), r.get(-1, 1), r.get(-1, 1));
+
+			path.segments.push_back(Segment(last, current));
+
+			last = current;
+		}
+
+		path.width = 3*(static_cast<Ogre::Real>(rec)/4+1)*r.get(0.5f, 2.5f-rec/3);
+
+		// Ramifications
+		if (rec > 0)
+		{
+			const Ogre::Vector2 angleRange = Ogre::Vector2(r.get(0.3f,0.5f), r.get(0.6f,0.8f));
+
+			Ogre::Real angle;
+			Ogre::Vector3 childDir;
+			Ogre::Vector2 bounds;
+			Ogre::Real lengthMult;
+			Ogre::Real delta = 1.0f / path.segments.size();
+			for (Ogre::uint32 k = 0; k < d-1; k++)
+			{
+				angle = (path.segments.at(k).b-path.segments.at(k).a).normalisedCopy().dotProduct(
+					((path.segments.at(k+1).b-path.segments.at(k+1).a).normalisedCopy()));
+
+				if (angle < r.get(angleRange.x, angleRange.y))
+				{
+					childDir = (path.segments.at(k).b-path.segments.at(k).a).normalisedCopy();
+					childDir.x *= r.get(0.8f, 1.2f);
+					childDir.y *= r.get(0.8f, 1.2f);
+					childDir.z *= r.get(0.8f, 1.2f);
+					childDir.normalise();
+
+					bounds = Ogre::Vector2(b.x+(b.y-b.x)*(k+1)*delta,1);
+
+					lengthMult = r.get(0.1f, 0.7f);
+
+					path.children.push_back(Path());
+					generatePath(path.children.back(), r, path.segments.at(k).b, childDir, lengthMult*l, 
+						2+static_cast<Ogre::uint32>(d*lengthMult), rec-1, bounds);
+				}
+			}
+		}
+	}
+
+	void Lightning::setVisible(const bool& v)
+	{
+		if (!mCreated)
+		{
+			return;
+		}
+
+		mBillboardSet->setVisible(v && mActive);
+
+		for(Ogre::uint32 k = 0; k < mActiveChildren; k++)
+		{
+			mChildren.at(k)->setVisible(v);
+		}
+	}
+
 	void Lightning::_updateRenderQueueGroup(const Ogre::uint8& rqg)
 	{
 		mBillboardSet->setRenderQueueGroup(rqg);
@@ -265,7 +378,7 @@ namespace SkyX { namespace VClouds
 
 		mBillboardSet->setCustomParameter(0, params);
 
-		for(Ogre::uint32 k = 0; k < mChildren.size(); k++)
+		for(Ogre::uint32 k = 0; k < mActiveChildren; k++)
 		{
 			mChildren.at(k)->_updateData(alpha*0.75f, currentPos, parentTime);
 		}
@@ -60,26 +60,69 @@ namespace SkyX { namespace VClouds{
 			Ogre::Vector3 b;
 		};
 
+		/** Path struct
+		    Pre-generated ray shape, including its ramifications. Paths are generated in a unit frame: the root ray 
+			starts at the origin, points to -Y and has length 1, so they can be reused with any direction and length.
+		 */
+		struct Path
+		{
+			/// Ray segments
+			std::vector<Segment> segments;
+			/// Initial billboard width, to be multiplied by the width multiplier
+			Ogre::Real width;
+			/// Recursivity level
+			Ogre::uint32 recursivity;
+			/// Ray bounds (for internal visual calculations)
+			Ogre::Vector2 bounds;
+			/// Ramifications
+			std::vector<Path> children;
+		};
+
+		/** Random class
+		    Small xorshift generator, used to generate paths outside the main thread without touching Ogre::Math's generator
+		 */
+		class Random
+		{
+		public:
+			/** Constructor
+			    @param seed Seed
+			 */
+			Random(const Ogre::uint32& seed)
+				: mState(seed != 0 ? seed : 0x9E3779B9)
+			{
+			}
+
+			/** Get random number
+			    @param min Min value
+				@param max Max value
+				@return Random number in [min, max] range
+			 */
+			inline const Ogre::Real get(const Ogre::Real& min, const Ogre::Real& max)
+			{
+				mState ^= mState << 13;
+				mState ^= mState >> 17;
+				mState ^= mState << 5;
+
+				return min + (max-min)*(static_cast<Ogre::Real>(mState)/4294967295.0f);
+			}
+
+		private:
+			/// Generator state
+			Ogre::uint32 mState;
+		};
+
 		/** Constructor
 		    @param sm Scene manager
 			@param sn Scene node
-			@param orig Lighting origin
-			@param dir Lighting direction
-			@param l Lighting lenth
-			@param d Divisions
-			@param rec Recursivity level
-			@param tm Time multiplier
-			@param wm Width multiplier
-			@param b Bounds
 		 */
-		Lightning(Ogre::SceneManager* sm, Ogre::SceneNode* sn, const Ogre::Vector3& orig, const Ogre::Vector3& dir, const Ogre::Real& l, 
-			const Ogre::uint32& d, const Ogre::uint32& rec, const Ogre::Real& tm,  const Ogre::Real& wm, const Ogre::Vector2& b = Ogre::Vector2(0,1));
+		Lightning(Ogre::SceneManager* sm, Ogre::SceneNode* sn);
 
 		/** Destructor
 		 */
 		~Lightning();
 
 		/** Create
+		    @remarks Creates the billboard set, which is reused by every start(...) call
 		 */
 		void create();
 
@@ -87,11 +130,44 @@ namespace SkyX { namespace VClouds{
 		 */
 		void remove();
 
+		/** Start a new ray, reusing the existing billboards and ramifications
+		    @param path Pre-generated path
+			@param q Orientation applied to the path (the path points to -Y)
+			@param l Ray length
+			@param tm Time multiplier
+			@param wm Width multiplier
+		 */
+		void start(const Path& path, const Ogre::Quaternion& q, const Ogre::Real& l, const Ogre::Real& tm, const Ogre::Real& wm);
+
+		/** Stop the ray, its billboards are hidden until the next start(...) call
+		 */
+		void stop();
+
+		/** Reserve the ramifications of a path
+		    @param path Path which start(...) must be able to use without allocating
+			@remarks Creates the missing children lightnings, recursively
+		 */
+		void reserve(const Path& path);
+
 		/** Update
 		    @param timeSinceLastFrame Time since last frame
          */
         void update(Ogre::Real timeSinceLastFrame);
 
+		/** Generate a path
+		    @param path Path to be filled
+			@param r Random generator
+			@param orig Ray origin
+			@param dir Ray direction
+			@param l Ray length
+			@param d Divisions
+			@param rec Recursivity level
+			@param b Bounds
+			@remarks Only touches the given path and generator, so it can be called from any thread
+		 */
+		static void generatePath(Path& path, Random& r, const Ogre::Vector3& orig, const Ogre::Vector3& dir, const Ogre::Real& l, 
+			const Ogre::uint32& d, const Ogre::uint32& rec, const Ogre::Vector2& b = Ogre::Vector2(0,1));
+
 		/** Get ray direction
 		    @return Ray direction
 		 */
@@ -140,6 +216,20 @@ namespace SkyX { namespace VClouds{
 			return mFinished;
 		}
 
+		/** Is the ray active? (Started and not stopped yet)
+		    @return true if the ray is active, false otherwise
+		 */
+		inline const bool& isActive() const
+		{
+			return mActive;
+		}
+
+		/** Set visible
+		    @param v Visible?
+			@remarks Applies to the ramifications too
+		 */
+		void setVisible(const bool& v);
+
 		/** Update render queue group
 		    @param rqg Render queue group
 		    @remarks Only for internal use. Use VClouds::setRenderQueueGroups(...) instead.
@@ -147,6 +237,10 @@ namespace SkyX { namespace VClouds{
 		void _updateRenderQueueGroup(const Ogre::uint8& rqg);
 
 	private:
+		/** Create a new child lightning, sharing this ray's scene node and render queue group
+		 */
+		void _addChild();
+
 		/** Update data
 		    @param alpha Alpha
 			@param currentPos Current position
@@ -154,25 +248,15 @@ namespace SkyX { namespace VClouds{
 		 */
 		void _updateData(const Ogre::Real& alpha, const Ogre::Real& currentPos, const Ogre::Real& parentTime);
 
-		/// Ray origin
-		Ogre::Vector3 mOrigin;
 		/// Ray direction
 		Ogre::Vector3 mDirection;
 		/// Ray length
 		Ogre::Real mLength;
 
-		/// Real ray length (total segments length amount)
-		Ogre::Real mRealLength;
-		/// Number of divisions
-		Ogre::uint32 mDivisions;
 		/// Recursivity level
 		Ogre::uint32 mRecursivity;
-		/// Width multiplier
-		Ogre::Real mWidthMultiplier;
 		/// Ray bounds (for internal visual calculations)
 		Ogre::Vector2 mBounds;
-		/// Angle range (Little values -> Less derivations, bigger values -> More derivations)
-		Ogre::Vector2 mAngleRange;
 
 		/// Current elapsed time
 		Ogre::Real mTime;
@@ -184,10 +268,10 @@ namespace SkyX { namespace VClouds{
 		/// Lightning intensity
 		Ogre::Real mIntensity;
 
-		/// Segments
-		std::vector<Segment> mSegments;
-		/// Children lightnings
+		/// Children lightnings, kept between rays and grown up front by reserve(...)
 		std::vector<Lightning*> mChildren;
+		/// Number of children used by the current ray
+		Ogre::uint32 mActiveChildren;
 
 		/// Billboard set
 		Ogre::BillboardSet* mBillboardSet;
@@ -198,6 +282,8 @@ namespace SkyX { namespace VClouds{
 
 		/// Has been create() already called?
 		bool mCreated;
+		/// Is the ray active?
+		bool mActive;
 		/// Has the ray finished?
 		bool mFinished;
 	};
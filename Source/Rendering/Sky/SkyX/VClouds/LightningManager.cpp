@@ -40,6 +40,14 @@ namespace SkyX { namespace VClouds
 		, mVolCloudsLightningMaterial(Ogre::MaterialPtr())
 		, mLightningMaterial(Ogre::MaterialPtr())
 		, mListeners(std::vector<Listener*>())
+		, mPaths(std::vector<Lightning::Path>())
+		, mNumberOfPaths(24)
+		, mFallbackPath(Lightning::Path())
+		, mPathsReady(false)
+		, mPathsReserved(false)
+		, mMaxStrikeRate(0)
+		, mStrikeBudget(3.0f)
+		, mVisible(true)
 		, mCreated(false)
 	{
 	}
@@ -71,6 +79,26 @@ namespace SkyX { namespace VClouds
 			mVClouds->getGeometryManager()->_setMaterialName("SkyX_VolClouds");
 		}
 
+		// Lightnings pool, the volumetric clouds material supports up to 3 simultaneous lightnings
+		for(Ogre::uint32 k = 0; k < 3; k++)
+		{
+			Ogre::SceneNode* sn = mVClouds->getSceneManager()->getRootSceneNode()->createChildSceneNode();
+
+			Lightning* lightning = new Lightning(mVClouds->getSceneManager(), sn);
+			lightning->create();
+
+			mSceneNodes.push_back(sn);
+			mLightnings.push_back(lightning);
+		}
+
+		mStrikeBudget = 3.0f;
+		mVisible = mVClouds->isVisible();
+
+		// Wait for the paths so the pooled lightnings can be grown to fit them now rather than on their first rays
+		_generatePaths();
+		_joinPathsThread();
+		_reservePaths();
+
 		mCreated = true;
 
 		setLightningColor(mLightningColor);
@@ -93,6 +121,10 @@ namespace SkyX { namespace VClouds
 		mLightnings.clear();
 		mSceneNodes.clear();
 
+		_joinPathsThread();
+		mPaths.clear();
+		mPathsReady = false;
+
 		removeListeners();
 
 		mVolCloudsLightningMaterial.setNull();
@@ -108,6 +140,12 @@ namespace SkyX { namespace VClouds
 			return;
 		}
 
+		// Paths regenerated by setNumberOfPaths(...)
+		if (!mPathsReserved && mPathsReady)
+		{
+			_reservePaths();
+		}
+
 		if (mEnabled)
 		{
 			mRemainingTime -= timeSinceLastFrame;
@@ -175,53 +213,67 @@ namespace SkyX { namespace VClouds
 			}
 		}
 
-		for(std::vector<Lightning*>::iterator it = mLightnings.begin(); it != mLightnings.end();)
+		if (mMaxStrikeRate > 0)
 		{
-			if ((*it)->isFinished())
-			{
-				Ogre::SceneNode* sn = (*it)->getSceneNode();
-
-				delete (*it);
-				it = mLightnings.erase(it);
+			mStrikeBudget = Ogre::Math::Clamp<Ogre::Real>(mStrikeBudget + timeSinceLastFrame*mMaxStrikeRate, 0, 3);
+		}
 
-				// Remove the associated scene node
-				for(std::vector<Ogre::SceneNode*>::iterator it2 = mSceneNodes.begin(); it2 != mSceneNodes.end(); it2++)
-				{
-					if ((*it2) == sn)
-					{
-						sn->getParentSceneNode()->removeAndDestroyChild(sn->getName());
-						mSceneNodes.erase(it2);
-						break;
-					}
-				}
+		// Finished lightnings go back to the pool
+		for(Ogre::uint32 k = 0; k < mLightnings.size(); k++)
+		{
+			if (mLightnings.at(k)->isFinished())
+			{
+				mLightnings.at(k)->stop();
 			}
 			else
 			{
-				(*it)->update(timeSinceLastFrame);
-				it++;
+				mLightnings.at(k)->update(timeSinceLastFrame);
 			}
 		}
 	}
 
 	Lightning* LightningManager::addLightning(const Ogre::Vector3& p, const Ogre::Vector3& d, const Ogre::Real l, const Ogre::uint32& div)
 	{
-		if (!mCreated || mLightnings.size() == 3)
+		if (!mCreated)
 		{
 			return static_cast<Lightning*>(NULL);
 		}
 
-		Ogre::SceneNode* sn = mVClouds->getSceneManager()->getRootSceneNode()->createChildSceneNode();
-		sn->setPosition(p);
+		if (mMaxStrikeRate > 0 && mStrikeBudget < 1)
+		{
+			return static_cast<Lightning*>(NULL);
+		}
+
+		// Find a free lightning in the pool
+		Ogre::uint32 slot = 0;
+		while (slot < mLightnings.size() && mLightnings.at(slot)->isActive())
+		{
+			slot++;
+		}
+
+		if (slot == mLightnings.size())
+		{
+			return static_cast<Lightning*>(NULL);
+		}
 
-		Lightning* lightning = new Lightning(mVClouds->getSceneManager(), sn, Ogre::Vector3(0,0,0), d, l, div, 3, mLightningTimeMultiplier, mVClouds->getGeometrySettings().Radius/9500);
-		lightning->create();
+		Lightning* lightning = mLightnings.at(slot);
+		mSceneNodes.at(slot)->setPosition(p);
+
+		// Reuse a path with a random roll around the ray axis, aligned to the ray direction
+		const Ogre::Quaternion q = 
+			Ogre::Vector3::NEGATIVE_UNIT_Y.getRotationTo(d.normalisedCopy(), Ogre::Vector3::UNIT_X) *
+			Ogre::Quaternion(Ogre::Radian(Ogre::Math::RangeRandom(0, Ogre::Math::TWO_PI)), Ogre::Vector3::NEGATIVE_UNIT_Y);
+
+		lightning->start(_selectPath(div), q, l, mLightningTimeMultiplier, mVClouds->getGeometrySettings().Radius/9500);
 		lightning->_updateRenderQueueGroup(
 			mVClouds->getGeometryManager()->_getCurrentDistance().y < mVClouds->getGeometryManager()->getHeight().y/2 ?
 			mVClouds->getRenderQueueGroups().vcloudsLightningsUnder : mVClouds->getRenderQueueGroups().vcloudsLightningsOver);
-		lightning->getBillboardSet()->setVisible(mVClouds->isVisible());
+		lightning->setVisible(mVisible);
 
-		mSceneNodes.push_back(sn);
-		mLightnings.push_back(lightning);
+		if (mMaxStrikeRate > 0)
+		{
+			mStrikeBudget -= 1;
+		}
 
 		for(Ogre::uint32 k = 0; k < mListeners.size(); k++)
 		{
@@ -237,7 +289,7 @@ namespace SkyX { namespace VClouds
 
 		for(Ogre::uint32 k = 0; k < 3; k++)
 		{
-			if (k < mLightnings.size())
+			if (k < mLightnings.size() && mLightnings.at(k)->isActive())
 			{
 				pos = mVClouds->getGeometryManager()->getSceneNode()->_getFullTransform().inverseAffine() * mSceneNodes.at(k)->_getDerivedPosition();
 
@@ -307,12 +359,116 @@ namespace SkyX { namespace VClouds
 		}
 	}
 
+	void LightningManager::setNumberOfPaths(const Ogre::uint32& n)
+	{
+		mNumberOfPaths = n;
+
+		if (mCreated)
+		{
+			_generatePaths();
+		}
+	}
+
 	void LightningManager::_setVisible(const bool& v)
 	{
+		mVisible = v;
+
 		for(Ogre::uint32 k = 0; k < mLightnings.size(); k++)
 		{	
-			mLightnings.at(k)->getBillboardSet()->setVisible(v);
+			mLightnings.at(k)->setVisible(v);
+		}
+	}
+
+	void LightningManager::_generatePaths()
+	{
+		_joinPathsThread();
+
+		mPathsReady = false;
+		mPathsReserved = false;
+
+		if (mNumberOfPaths == 0)
+		{
+			return;
+		}
+
+		// Seed from the main thread, the generation itself doesn't touch Ogre::Math's generator
+		const Ogre::uint32 seed = static_cast<Ogre::uint32>(Ogre::Math::UnitRandom()*4294967295.0);
+		const Ogre::uint32 n = mNumberOfPaths;
+
+		mPathsThread = std::thread([this, seed, n]()
+		{
+			Lightning::Random r(seed);
+			std::vector<Lightning::Path> paths(n);
+
+			// Spread divisions over the [12, 30] range used by addLightning(...)
+			for(Ogre::uint32 k = 0; k < n; k++)
+			{
+				const Ogre::uint32 div = 12 + (n > 1 ? (18*k)/(n-1) : 9);
+
+				Lightning::generatePath(paths.at(k), r, Ogre::Vector3::ZERO, Ogre::Vector3::NEGATIVE_UNIT_Y, 1, div, 3);
+			}
+
+			mPaths.swap(paths);
+			mPathsReady = true;
+		});
+	}
+
+	void LightningManager::_reservePaths()
+	{
+		if (!mPathsReady)
+		{
+			return;
 		}
+
+		for(Ogre::uint32 k = 0; k < mLightnings.size(); k++)
+		{
+			for(Ogre::uint32 p = 0; p < mPaths.size(); p++)
+			{
+				mLightnings.at(k)->reserve(mPaths.at(p));
+			}
+		}
+
+		mPathsReserved = true;
+	}
+
+	void LightningManager::_joinPathsThread()
+	{
+		if (mPathsThread.joinable())
+		{
+			mPathsThread.join();
+		}
+	}
+
+	const Lightning::Path& LightningManager::_selectPath(const Ogre::uint32& div)
+	{
+		if (!mPathsReady)
+		{
+			Lightning::Random r(static_cast<Ogre::uint32>(Ogre::Math::UnitRandom()*4294967295.0));
+			Lightning::generatePath(mFallbackPath, r, Ogre::Vector3::ZERO, Ogre::Vector3::NEGATIVE_UNIT_Y, 1, div, 3);
+
+			return mFallbackPath;
+		}
+
+		// Closest number of divisions, ties are broken randomly
+		Ogre::uint32 best = 0, bestDiff = 0xFFFFFFFF, matches = 0;
+		for(Ogre::uint32 k = 0; k < mPaths.size(); k++)
+		{
+			const Ogre::uint32 segments = static_cast<Ogre::uint32>(mPaths.at(k).segments.size());
+			const Ogre::uint32 diff = segments > div ? segments - div : div - segments;
+
+			if (diff < bestDiff)
+			{
+				best = k;
+				bestDiff = diff;
+				matches = 1;
+			}
+			else if (diff == bestDiff && Ogre::Math::UnitRandom()*(++matches) < 1)
+			{
+				best = k;
+			}
+		}
+
+		return mPaths.at(best);
 	}
 
 }}
\ No newline at end of file
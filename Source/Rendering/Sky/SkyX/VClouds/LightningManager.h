@@ -28,6 +28,9 @@ http://www.gnu.org/copyleft/lesser.txt.
 
 #include "Lightning.h"
 
+#include <atomic>
+#include <thread>
+
 namespace SkyX { namespace VClouds{
 
 	class VClouds;
@@ -46,6 +49,7 @@ namespace SkyX { namespace VClouds{
 						 invoking LightningManager::addLightning(...) or automatically based on the lightning creation
 						 probabilities) in order to play a sound, etc.
 						 The lightning position is accessible through Lightning::getSceneNode()->getPosition().
+						 Lightnings are pooled, so the same pointer will be reported again for later rays.
 			 */
 			inline virtual void lightningAdded(Lightning* l){}
 		};
@@ -76,9 +80,10 @@ namespace SkyX { namespace VClouds{
 		    @param p Lightning position
 			@param d Lightning direction
 			@param l Lightning length
-			@return The lightning or null in error case (the max number of simultaneous lightnings is 3)
-			@remarks The lightning will be automatically destroyed one time it'll be finished, so the returned ptr will not
-					 be available one time the lightning will have disappeared
+			@param div Divisions, the pre-generated path with the closest number of divisions is used
+			@return The lightning or null in error case (the max number of simultaneous lightnings is 3, or the strike rate cap has been reached)
+			@remarks The lightning is taken from a fixed pool and will be automatically stopped one time it'll be finished, 
+			         after that the returned ptr can be reused by a new ray
 		 */
 		Lightning* addLightning(const Ogre::Vector3& p, const Ogre::Vector3& d, const Ogre::Real l, const Ogre::uint32& div = static_cast<Ogre::uint32>(Ogre::Math::RangeRandom(12, 30)));
 
@@ -176,6 +181,46 @@ namespace SkyX { namespace VClouds{
 			return mAverageLightningApparitionTime;
 		}
 
+		/** Set the number of pre-generated lightning paths
+		    @param n Number of path variations, generated in a background thread
+			@remarks Paths are regenerated if the lightning manager is already created
+		 */
+		void setNumberOfPaths(const Ogre::uint32& n);
+
+		/** Get the number of pre-generated lightning paths
+		    @return Number of path variations
+		 */
+		inline const Ogre::uint32& getNumberOfPaths() const
+		{
+			return mNumberOfPaths;
+		}
+
+		/** Are the pre-generated paths ready?
+		    @return true if the background generation has finished
+			@remarks Until then, rays use paths generated on demand
+		 */
+		inline const bool arePathsReady() const
+		{
+			return mPathsReady.load();
+		}
+
+		/** Set max strike rate
+		    @param msr Max number of rays per second (in update time), 0 (default) to disable the cap
+			@remarks Applies to automatic and manually added lightnings, short bursts of up to 3 rays are allowed
+		 */
+		inline void setMaxStrikeRate(const Ogre::Real& msr)
+		{
+			mMaxStrikeRate = msr;
+		}
+
+		/** Get max strike rate
+		    @return Max number of rays per second, 0 if there is no cap
+		 */
+		inline const Ogre::Real& getMaxStrikeRate() const
+		{
+			return mMaxStrikeRate;
+		}
+
 		/** Has been create() already called?
 		    @return true if created() have been already called, false if not
 		 */
@@ -197,11 +242,50 @@ namespace SkyX { namespace VClouds{
 		void _setVisible(const bool& v);
 
 	private:
-		/// Lightnings
+		/** Start generating the lightning paths in a background thread
+		 */
+		void _generatePaths();
+
+		/** Wait for the background path generation, if any
+		 */
+		void _joinPathsThread();
+
+		/** Grow the pooled lightnings so every pre-generated path can be started without allocating
+		 */
+		void _reservePaths();
+
+		/** Select a path for a new ray
+		    @param div Desired number of divisions
+			@return Pre-generated path, or a path generated now if they are not ready yet
+		 */
+		const Lightning::Path& _selectPath(const Ogre::uint32& div);
+
+		/// Lightnings pool, one per lightning slot of the volumetric clouds material
 		std::vector<Lightning*> mLightnings;
-		/// Scene nodes
+		/// Scene nodes, one per pooled lightning
 		std::vector<Ogre::SceneNode*> mSceneNodes;
 
+		/// Pre-generated paths, only accessed from the main thread once mPathsReady is set
+		std::vector<Lightning::Path> mPaths;
+		/// Number of paths to generate
+		Ogre::uint32 mNumberOfPaths;
+		/// Path generated on demand while mPaths is not ready
+		Lightning::Path mFallbackPath;
+		/// Path generation thread
+		std::thread mPathsThread;
+		/// Has the path generation finished?
+		std::atomic<bool> mPathsReady;
+		/// Have the pooled lightnings been grown for the current paths?
+		bool mPathsReserved;
+
+		/// Max number of rays per second, 0 to disable
+		Ogre::Real mMaxStrikeRate;
+		/// Rays that can be started before reaching the strike rate cap
+		Ogre::Real mStrikeBudget;
+
+		/// Are the lightnings visible?
+		bool mVisible;
+
 		/// Is the lightning system enabled?
 		bool mEnabled;
 
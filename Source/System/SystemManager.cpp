@@ -27,6 +27,13 @@
 #include "PhysicsSystem.hpp"
 #include "System.hpp"
 #include "SystemManager.hpp"
+#include "World/World.hpp"
+
+// ========================================================================= //
+
+// Around the main camera, multi-model entities with physics are created
+// immediately rather than streamed in.
+static const Ogre::Real SpawnCollisionRadius = 250.f;
 
 // ========================================================================= //
 
@@ -167,6 +174,47 @@ void SystemManager::processEntity(EntityPtr entity)
         if (entity->hasComponent<SceneComponent>() &&
             entity->hasComponent<PhysicsComponent>()){
             this->getSystem<PhysicsSystem>()->attachEntity(entity);
+
+            // Multi-model entities stream in over several ticks, so give
+            // each one its actor as it appears. As in PhysicsComponent::init,
+            // only entities on the root node's direct children get one. The
+            // Entity is looked up each time, as it may be destroyed first.
+            if (entity->hasComponent<MultiModelComponent>()){
+                MultiModelComponentPtr multiModelC =
+                    entity->getComponent<MultiModelComponent>();
+                const std::weak_ptr<World> world = m_world;
+                const EntityID id = entity->getID();
+                multiModelC->setEntityCallback(
+                    [world, id](Ogre::Entity* e, Ogre::SceneNode* node){
+                    std::shared_ptr<World> w = world.lock();
+                    if (w == nullptr){
+                        return;
+                    }
+                    EntityPtr owner = w->getEntityPtr(id);
+                    if (owner == nullptr ||
+                        owner->hasComponent<PhysicsComponent>() == false ||
+                        node->getParentSceneNode() !=
+                        owner->getComponent<SceneComponent>()->getSceneNode()){
+                        return;
+                    }
+
+                    owner->getComponent<PhysicsComponent>()->createActor(
+                        e,
+                        id,
+                        node->_getDerivedPosition(),
+                        node);
+                });
+
+                // Don't let the ground under the camera (usually the
+                // player's spawn) stream in after the player has fallen
+                // through it.
+                CameraComponentPtr camera = m_world->getMainCamera();
+                if (camera != nullptr){
+                    multiModelC->createWithin(
+                        camera->getCamera()->getDerivedPosition(),
+                        SpawnCollisionRadius);
+                }
+            }
         }
     }
 }
@@ -25,12 +25,25 @@
 
 // ========================================================================= //
 
+// Time pulse CEGUI receives per tick.
+static const float STimePulse = 1.f / 16.f;
+
+// Ticks CEGUI keeps being pulsed after the last activity, long enough for
+// tooltip delays and double-click timeouts to elapse.
+static const unsigned int SActiveTicks = 32;
+
+// Set by Input when it injects an event, consumed by the next update.
+static bool SInputPending = false;
+
+// ========================================================================= //
+
 UI::UI(void) :
 m_layers(),
 m_layerStack(),
 m_currentLayer(nullptr),
 m_events(),
-m_username()
+m_username(),
+m_activeTicks(SActiveTicks)
 {
 
 }
@@ -53,19 +66,68 @@ void UI::destroy(void)
 
         m_layerStack.pop();
     }
+
+    m_currentLayer = nullptr;
+    this->updateRendering();
 }
 
 // ========================================================================= //
 
 bool UI::update(void)
 {
-    CEGUI::System::getSingleton().injectTimePulse(1.f / 16.f);
+    if (SInputPending == true){
+        SInputPending = false;
+        this->markDirty();
+    }
+
+    // Keep animations running until they finish.
+    CEGUI::AnimationManager& amgr = CEGUI::AnimationManager::getSingleton();
+    for (size_t i = 0; i < amgr.getNumAnimationInstances(); ++i){
+        if (amgr.getAnimationInstanceAtIdx(i)->isRunning() == true){
+            this->markDirty();
+            break;
+        }
+    }
+
+    // An idle UI has no timers or animations worth advancing, so the pulse is
+    // skipped rather than accumulated.
+    if (m_activeTicks > 0){
+        --m_activeTicks;
+        CEGUI::System::getSingleton().injectTimePulse(STimePulse);
+    }
 
     return (m_events.empty() == false);
 }
 
 // ========================================================================= //
 
+void UI::notifyInput(void)
+{
+    SInputPending = true;
+}
+
+// ========================================================================= //
+
+void UI::markDirty(void)
+{
+    m_activeTicks = SActiveTicks;
+}
+
+// ========================================================================= //
+
+void UI::updateRendering(void)
+{
+    const bool visible = (m_currentLayer != nullptr && 
+                          m_currentLayer->isVisible() == true);
+
+    // Nothing to draw, so don't let CEGUI touch the render queue at all.
+    static_cast<CEGUI::OgreRenderer*>(
+        CEGUI::System::getSingleton().getRenderer())->
+        setRenderingEnabled(visible);
+}
+
+// ========================================================================= //
+
 void UI::pushLayer(const unsigned int n)
 {
     Assert(n < m_layers.size(), "Invalid layer");
@@ -77,11 +139,16 @@ void UI::pushLayer(const unsigned int n)
         current->deactivate();
     }
 
-    // Activate new layer.
+    // Activate new layer. Its geometry is cached in a rendering surface and
+    // only redrawn when a child window is invalidated.
     m_layerStack.push(n);
+    m_layers[n]->setUsingAutoRenderingSurface(true);
     m_layers[n]->setVisible(true);
     m_layers[n]->activate();
     m_currentLayer = m_layers[n];
+
+    this->markDirty();
+    this->updateRendering();
 }
 
 // ========================================================================= //
@@ -104,6 +171,9 @@ void UI::popLayer(void)
     else{
         m_currentLayer = nullptr;
     }
+
+    this->markDirty();
+    this->updateRendering();
 }
 
 // ========================================================================= //
@@ -118,6 +188,9 @@ void UI::setVisible(const bool visible)
     else{
         m_currentLayer->deactivate();
     }
+
+    this->markDirty();
+    this->updateRendering();
 }
 
 // ========================================================================= //
@@ -162,6 +235,8 @@ void UI::insertListboxItem(const std::string& window, const std::string& text)
 
     CEGUI::ListboxTextItem* item = new CEGUI::ListboxTextItem(text);
     listbox->addItem(item);
+
+    this->markDirty();
 }
 
 // ========================================================================= //
@@ -175,6 +250,7 @@ void UI::removeListboxItem(const std::string& window,
     CEGUI::ListboxItem* item = listbox->findItemWithText(text, nullptr);
     if (item != nullptr){
         listbox->removeItem(item);
+        this->markDirty();
     }
 }
 
@@ -185,6 +261,17 @@ void UI::clearListbox(const std::string& window)
     CEGUI::Listbox* listbox = static_cast<CEGUI::Listbox*>(
         m_currentLayer->getChild(window));
     listbox->resetList();
+
+    this->markDirty();
+}
+
+// ========================================================================= //
+
+void UI::appendText(const std::string& window, const std::string& text)
+{
+    m_currentLayer->getChild(window)->appendText(text);
+
+    this->markDirty();
 }
 
 // ========================================================================= //
\ No newline at end of file
@@ -54,7 +54,10 @@ struct UIEvent{
 
 // ========================================================================= //
 // Handles CEGUI creation and events. Uses a stack to manage GUI layers, 
-// allowing users to traverse menu systems.
+// allowing users to traverse menu systems. CEGUI is only pulsed while the UI
+// is active (recent input, a changed window, a running animation) and only 
+// rendered while a layer is visible; layers draw from cached rendering 
+// surfaces, so static menus cost next to nothing.
 class UI
 {
 public:
@@ -70,10 +73,14 @@ public:
     // Pops all layers.
     virtual void destroy(void);
 
-    // Updates CEGUI system, returns true if there are events that need 
-    // processing.
+    // Updates CEGUI system if the UI is active, returns true if there are 
+    // events that need processing.
     virtual bool update(void);
 
+    // Marks the UI active so CEGUI receives time pulses for the next few 
+    // ticks. Called by Input whenever it injects an event into CEGUI.
+    static void notifyInput(void);
+
     // Pushes layer at index n onto layer stack, activating it.
     virtual void pushLayer(const unsigned int n);
 
@@ -106,6 +113,9 @@ public:
     // Removes all items from listbox.
     void clearListbox(const std::string& window);
 
+    // Appends text to a window in the current layer.
+    void appendText(const std::string& window, const std::string& text);
+
     // Getters:
 
     // Returns network username.
@@ -117,6 +127,12 @@ public:
     void setUsername(const std::string& username);
 
 protected:
+    // Keeps CEGUI pulsed for the next few ticks, e.g. after a window changed.
+    void markDirty(void);
+
+    // Enables CEGUI rendering only while the current layer is visible.
+    void updateRendering(void);
+
     // All layers (windows loaded from a layout).
     std::vector<CEGUI::Window*> m_layers;
     // Active layers, with the top being the currently visible layer.
@@ -128,6 +144,9 @@ private:
     // Event queue for passing events from inside UI class to the outside.
     std::queue<UIEvent> m_events;
     std::string m_username;
+
+    // Ticks left before the UI is considered idle.
+    unsigned int m_activeTicks;
 };
 
 // ========================================================================= //
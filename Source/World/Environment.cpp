@@ -23,10 +23,13 @@
 
 #include "Component/ActorComponent.hpp"
 #include "Component/CameraComponent.hpp"
+#include "Core/Talos.hpp"
 #include "Entity/Entity.hpp"
 #include "Environment.hpp"
+#include "OceanWaves.hpp"
 #include "Rendering/Ocean/OceanHighGraphics.hpp"
 #include "Rendering/Ocean/OceanLowGraphics.hpp"
+#include "Rendering/ShadowManager.hpp"
 #include "Rendering/Sky/SkyHighGraphics.hpp"
 #include "Rendering/SSAO/Geom.hpp"
 #include "Rendering/SSAO/SSAO.hpp"
@@ -48,9 +51,18 @@ m_renderOcean(false),
 m_renderSky(false),
 m_oceanCfg(""),
 m_skyCfg(""),
+m_oceanWaves(new OceanWaves()),
+m_keepAliveOnPause(true),
+m_suspended(false),
 m_ssao(nullptr),
 m_geom(nullptr),
-m_qr(nullptr)
+m_qr(nullptr),
+// Subsystems advance by the tick length in seconds.
+m_scheduler(Talos::MS_PER_UPDATE, Talos::MS_PER_UPDATE / 1000.f),
+m_oceanTask(0),
+m_skyTask(0),
+m_cloudsTask(0),
+m_ssaoTask(0)
 {
     m_world = world;
 }
@@ -81,12 +93,47 @@ void Environment::init(void)
     m_moon->setDiffuseColour(Ogre::ColourValue::Black);
     m_moon->setSpecularColour(Ogre::ColourValue::Black);
     m_moon->setDirection(Ogre::Vector3::NEGATIVE_UNIT_Y);    
+
+    // Both compete for shadow maps with the scene's lights; whichever is
+    // brighter wins.
+    m_world->getShadowManager()->addLight(m_sun);
+    m_world->getShadowManager()->addLight(m_moon);
+
+    // Register subsystem updates. Costs are initial estimates in ms, refined
+    // from measurements; rates are minimum then preferred Hz (0 = every 
+    // tick). SSAO is redrawn every frame, so it is not throttled. Each is 
+    // enabled once its subsystem is loaded.
+    m_scheduler.clear();
+    m_oceanTask = m_scheduler.addTask("Ocean", [this](const Ogre::Real dt){
+        m_ocean->update(dt);
+    }, 1.5f, 30.f);
+    m_skyTask = m_scheduler.addTask("Sky", [this](const Ogre::Real dt){
+        m_sky->update(dt);
+    }, 0.5f, 10.f);
+    m_cloudsTask = m_scheduler.addTask("Clouds", [this](const Ogre::Real dt){
+        m_sky->updateClouds(dt);
+    }, 2.f, 4.f);
+    m_ssaoTask = m_scheduler.addUnthrottledTask("SSAO", 
+                                                [this](const Ogre::Real){
+        m_geom->clear();
+        m_geom->update();
+
+        m_ssao->clear();
+        m_ssao->update();
+    });
+
+    m_scheduler.setTaskEnabled(m_oceanTask, false);
+    m_scheduler.setTaskEnabled(m_skyTask, false);
+    m_scheduler.setTaskEnabled(m_cloudsTask, false);
+    m_scheduler.setTaskEnabled(m_ssaoTask, false);
 }
 
 // ========================================================================= //
 
 void Environment::destroy(void)
 {
+    m_scheduler.logReport();
+
     if (m_ocean != nullptr){
         m_ocean->destroy();
     }
@@ -94,6 +141,8 @@ void Environment::destroy(void)
         m_sky->destroy();
     }
 
+    m_world->getShadowManager()->removeLight(m_sun);
+    m_world->getShadowManager()->removeLight(m_moon);
     m_world->getSceneManager()->destroyLight(m_sun);
     m_world->getSceneManager()->destroyLight(m_moon);
 
@@ -106,11 +155,29 @@ void Environment::destroy(void)
 
 void Environment::pause(void)
 {
+    m_scheduler.setTaskEnabled(m_oceanTask, false);
+    m_scheduler.setTaskEnabled(m_skyTask, false);
+    m_scheduler.setTaskEnabled(m_cloudsTask, false);
+
+    if (m_keepAliveOnPause){
+        // Hide them and leave everything loaded for a fast resume.
+        if (m_renderOcean){
+            m_ocean->suspend();
+        }
+        if (m_renderSky){
+            m_sky->suspend();
+        }
+        m_suspended = true;
+        return;
+    }
+
     if (m_renderOcean){
         m_ocean->destroy();
+        m_ocean.reset();
     }
     if (m_renderSky){
         m_sky->destroy();
+        m_sky.reset();
     }
 }
 
@@ -118,6 +185,21 @@ void Environment::pause(void)
 
 void Environment::resume(void)
 {
+    if (m_suspended){
+        m_suspended = false;
+
+        if (m_renderOcean){
+            m_ocean->resume();
+            m_scheduler.setTaskEnabled(m_oceanTask, true);
+        }
+        if (m_renderSky){
+            m_sky->resume();
+            m_scheduler.setTaskEnabled(m_skyTask, true);
+            m_scheduler.setTaskEnabled(m_cloudsTask, true);
+        }
+        return;
+    }
+
     if (m_renderOcean){
         this->loadOcean(m_oceanCfg);
     }
@@ -130,23 +212,12 @@ void Environment::resume(void)
 
 void Environment::update(void)
 {
-    // Update Ocean.
-    if (m_renderOcean){
-        m_ocean->update();        
-    }
-
-    // Update Sky.
-    if (m_renderSky){
-        m_sky->update();
-    }
+    // Waves advance every tick at a fixed step so queries are deterministic,
+    // however often the ocean itself is redrawn.
+    m_oceanWaves->update(Talos::MS_PER_UPDATE / 1000.f);
 
-    if (m_graphics.ssao){
-        m_geom->clear();
-        m_geom->update();
-
-        m_ssao->clear();
-        m_ssao->update();
-    }
+    // Update Ocean, Sky, clouds and SSAO within the budget.
+    m_scheduler.update();
 }
 
 // ========================================================================= //
@@ -159,18 +230,28 @@ void Environment::loadOcean(const std::string& cfg)
         m_ocean.reset(new OceanLowGraphics());
         static_cast<OceanLowGraphics*>(m_ocean.get())->init(m_world,
                                                             cfg);
-        return;
+        // Updated like the high detail ocean so it follows the camera.
+        break;
 
     case Graphics::Setting::High:
         m_ocean.reset(new OceanHighGraphics());
         static_cast<OceanHighGraphics*>(m_ocean.get())->init(m_world, 
                                                              cfg, 
-                                                             m_graphics.ocean);
+                                                             m_graphics.ocean,
+                                                             m_oceanWaves);
         break;
     }
 
     m_renderOcean = true;
     m_oceanCfg = cfg;
+    m_scheduler.setTaskEnabled(m_oceanTask, true);
+}
+
+// ========================================================================= //
+
+void Environment::loadOceanWaves(const std::string& cfg)
+{
+    m_oceanWaves->loadConfig(cfg);
 }
 
 // ========================================================================= //
@@ -193,6 +274,8 @@ void Environment::loadSky(const std::string& cfg)
 
     m_renderSky = true;
     m_skyCfg = cfg;
+    m_scheduler.setTaskEnabled(m_skyTask, true);
+    m_scheduler.setTaskEnabled(m_cloudsTask, true);
 }
 
 // ========================================================================= //
@@ -215,6 +298,8 @@ void Environment::loadEffects(void)
         m_ssao->create(rw->getWidth(),
                        rw->getHeight(),
                        Ogre::PF_R8G8B8);
+
+        m_scheduler.setTaskEnabled(m_ssaoTask, true);
     }
 }
 
@@ -348,6 +433,7 @@ void Environment::setOceanPosition(const Ogre::Real x,
                                    const Ogre::Real y,
                                    const Ogre::Real z)
 {
+    m_oceanWaves->setLevel(y);
     m_ocean->setPosition(x, y, z);
 }
 
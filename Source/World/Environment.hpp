@@ -26,11 +26,13 @@
 
 // ========================================================================= //
 
+#include "EnvironmentScheduler.hpp"
 #include "stdafx.hpp"
 
 // ========================================================================= //
 
 class Geom;
+class OceanWaves;
 class SSAO;
 struct QuadRenderer;
 
@@ -46,24 +48,34 @@ public:
     ~Environment(void);
 
     // Sets ambient light to darkness and sets up default sun/moon lights to
-    // darkness and pointing straight down.
+    // darkness and pointing straight down. Registers ocean, sky, cloud and
+    // SSAO updates with the scheduler.
     void init(void);
 
-    // Destroys directional light.
+    // Destroys directional light, logs update timing report.
     void destroy(void);
 
-    // Disables SkyX and HydraX to allow for use in other states.
+    // Disables SkyX and HydraX to allow for use in other states. They are
+    // suspended (hidden, not updated, resources kept) unless keep-alive is
+    // disabled, in which case they are destroyed.
     void pause(void);
 
-    // Re-enables SkyX and HydraX with previous settings.
+    // Re-enables SkyX and HydraX, either un-suspending them or recreating
+    // them with previous settings.
     void resume(void);
 
-    // Updates directional light, water, and sky if active.
+    // Runs the water, sky, cloud and SSAO updates the scheduler selects
+    // for this tick.
     void update(void);
 
     // Allocates Ocean object according to graphics settings.
     void loadOcean(const std::string& cfg);
 
+    // Reads wave parameters from a Hydrax config. Called whatever the 
+    // graphics level (and on servers), before loadOcean(), since the high
+    // detail ocean renders the same waves.
+    void loadOceanWaves(const std::string& cfg);
+
     // Allocates Sky object, uses config file passed in for settings.
     void loadSky(const std::string& = "");
 
@@ -78,9 +90,19 @@ public:
     // Returns pointer to active Ocean object.
     std::shared_ptr<Ocean> getOcean(void) const;
 
+    // Returns ocean surface model for height/normal queries. Available
+    // without a renderer; its parameters come from loadOceanWaves().
+    std::shared_ptr<OceanWaves> getOceanWaves(void) const;
+
     // Returns pointer to active Sky object.
     std::shared_ptr<Sky> getSky(void) const;
 
+    // Returns scheduler for budget configuration and timing statistics.
+    EnvironmentScheduler& getScheduler(void);
+
+    // Returns true if Ocean and Sky are kept loaded while paused.
+    const bool getKeepAliveOnPause(void) const;
+
     // Setters:
 
     // Sets colour of world's ambient light.
@@ -136,6 +158,14 @@ public:
                           const Ogre::Real, 
                           const Ogre::Real);
 
+    // Sets milliseconds per tick the environment may spend updating before
+    // subsystems fall back to their minimum refresh rates.
+    void setUpdateBudget(const Ogre::Real);
+
+    // If true (default), Ocean and Sky are suspended on pause() instead of
+    // destroyed. Disable to free their memory while another state runs.
+    void setKeepAliveOnPause(const bool);
+
 private:
     // Directional lights.
     Ogre::Light* m_sun; 
@@ -151,11 +181,18 @@ private:
     std::shared_ptr<Sky> m_sky;
     bool m_renderOcean, m_renderSky;
     std::string m_oceanCfg, m_skyCfg;
+    std::shared_ptr<OceanWaves> m_oceanWaves;
+    bool m_keepAliveOnPause, m_suspended;
 
     // SSAO.
     std::shared_ptr<SSAO> m_ssao;
     std::shared_ptr<Geom> m_geom;
     std::shared_ptr<QuadRenderer> m_qr;
+
+    // Update scheduling.
+    EnvironmentScheduler m_scheduler;
+    EnvironmentScheduler::TaskHandle m_oceanTask, m_skyTask, m_cloudsTask, 
+        m_ssaoTask;
 };
 
 // ========================================================================= //
@@ -172,10 +209,32 @@ inline std::shared_ptr<Ocean> Environment::getOcean(void) const{
 }
 
 
+inline std::shared_ptr<OceanWaves> Environment::getOceanWaves(void) const{
+    return m_oceanWaves;
+}
+
 inline std::shared_ptr<Sky> Environment::getSky(void) const{
     return m_sky;
 }
 
+inline EnvironmentScheduler& Environment::getScheduler(void){
+    return m_scheduler;
+}
+
+inline const bool Environment::getKeepAliveOnPause(void) const{
+    return m_keepAliveOnPause;
+}
+
+// Setters:
+
+inline void Environment::setUpdateBudget(const Ogre::Real budget){
+    m_scheduler.setBudget(budget);
+}
+
+inline void Environment::setKeepAliveOnPause(const bool keepAlive){
+    m_keepAliveOnPause = keepAlive;
+}
+
 // ========================================================================= //
 
 #endif
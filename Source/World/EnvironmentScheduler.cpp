@@ -0,0 +1,245 @@
+// ========================================================================= //
+// Talos - A 3D game engine with network multiplayer.
+// Copyright(C) 2015 Jordan Sparks <unixunited@live.com>
+//
+// This program is free software; you can redistribute it and / or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 3
+// of the License, or(at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+// ========================================================================= //
+// File: EnvironmentScheduler.cpp
+// Author: Jordan Sparks <unixunited@live.com>
+// ========================================================================= //
+// Implements EnvironmentScheduler class.
+// ========================================================================= //
+
+#include "EnvironmentScheduler.hpp"
+
+#include <algorithm>
+
+// ========================================================================= //
+
+EnvironmentScheduler::EnvironmentScheduler(const Ogre::Real msPerTick,
+                                           const Ogre::Real stepPerTick) :
+m_tasks(),
+m_due(),
+m_msPerTick(msPerTick),
+m_stepPerTick(stepPerTick),
+// Room for the Environment's throttled costs (4 ms) with some to spare.
+m_budget(5.f),
+// Report once a minute.
+m_reportTicks(static_cast<uint32_t>(60000.f / msPerTick)),
+m_timer(),
+m_timeSpent(0.f),
+m_totalTimeSpent(0.f),
+m_ticks(0)
+{
+
+}
+
+// ========================================================================= //
+
+EnvironmentScheduler::~EnvironmentScheduler(void)
+{
+
+}
+
+// ========================================================================= //
+
+EnvironmentScheduler::TaskHandle EnvironmentScheduler::addTask(
+    const std::string& name,
+    const UpdateFunc& update,
+    const Ogre::Real cost,
+    const Ogre::Real minRate,
+    const Ogre::Real preferredRate)
+{
+    Assert(minRate > 0.f, "Environment task needs a positive minimum rate");
+
+    Task task;
+    task.name = name;
+    task.update = update;
+    task.enabled = true;
+    task.cost = cost;
+    task.preferredRate = preferredRate;
+    task.minRate = minRate;
+    task.throttled = true;
+    // Make the task due on the first tick.
+    task.ticksSinceRun = 1;
+    task.lastCost = 0.f;
+    task.totalTime = 0.f;
+    task.runs = 0;
+    task.forcedRuns = 0;
+
+    m_tasks.push_back(task);
+    m_due.reserve(m_tasks.size());
+
+    return static_cast<TaskHandle>(m_tasks.size() - 1);
+}
+
+// ========================================================================= //
+
+EnvironmentScheduler::TaskHandle EnvironmentScheduler::addUnthrottledTask(
+    const std::string& name,
+    const UpdateFunc& update)
+{
+    const TaskHandle handle = this->addTask(name, update, 0.f, 1.f);
+    m_tasks[handle].throttled = false;
+
+    return handle;
+}
+
+// ========================================================================= //
+
+void EnvironmentScheduler::clear(void)
+{
+    m_tasks.clear();
+    m_due.clear();
+}
+
+// ========================================================================= //
+
+const Ogre::Real EnvironmentScheduler::getSlack(const Task& task) const
+{
+    // Run once the next tick would exceed the minimum rate's interval.
+    const Ogre::Real maxInterval = 1000.f / task.minRate;
+
+    return maxInterval - (task.ticksSinceRun + 1) * m_msPerTick;
+}
+
+// ========================================================================= //
+
+void EnvironmentScheduler::run(Task& task)
+{
+    m_timer.reset();
+    task.update(task.ticksSinceRun * m_stepPerTick);
+    const Ogre::Real cost = m_timer.getMicroseconds() / 1000.f;
+
+    // Blend measured cost into the declared estimate.
+    task.cost = task.cost * 0.9f + cost * 0.1f;
+    task.lastCost = cost;
+    task.totalTime += cost;
+    ++task.runs;
+    task.ticksSinceRun = 0;
+}
+
+// ========================================================================= //
+
+void EnvironmentScheduler::update(void)
+{
+    // Run unthrottled passes and collect tasks whose preferred interval has
+    // elapsed.
+    m_due.clear();
+    for (TaskHandle i = 0; i < m_tasks.size(); ++i){
+        Task& task = m_tasks[i];
+        if (task.enabled == false){
+            continue;
+        }
+        if (task.throttled == false){
+            this->run(task);
+            continue;
+        }
+
+        const Ogre::Real preferredInterval = (task.preferredRate > 0.f) ?
+            1000.f / task.preferredRate : 0.f;
+        if (task.ticksSinceRun * m_msPerTick >= preferredInterval){
+            m_due.push_back(i);
+        }
+    }
+
+    // Most urgent (least slack before missing minimum rate) first.
+    std::sort(m_due.begin(), m_due.end(),
+              [this](const TaskHandle a, const TaskHandle b){
+        return this->getSlack(m_tasks[a]) < this->getSlack(m_tasks[b]);
+    });
+
+    Ogre::Real spent = 0.f;
+    for (std::vector<TaskHandle>::iterator itr = m_due.begin();
+         itr != m_due.end();
+         ++itr){
+        Task& task = m_tasks[*itr];
+
+        const bool forced = (this->getSlack(task) < 0.f);
+        if (forced == false && spent + task.cost > m_budget){
+            continue;
+        }
+
+        this->run(task);
+        if (forced){
+            ++task.forcedRuns;
+        }
+
+        spent += task.lastCost;
+    }
+
+    // Age every enabled task by one tick.
+    for (std::vector<Task>::iterator itr = m_tasks.begin();
+         itr != m_tasks.end();
+         ++itr){
+        if (itr->enabled){
+            ++itr->ticksSinceRun;
+        }
+    }
+
+    m_timeSpent = spent;
+    m_totalTimeSpent += spent;
+    ++m_ticks;
+
+    if (m_reportTicks != 0 && m_ticks % m_reportTicks == 0){
+        this->logReport();
+    }
+}
+
+// ========================================================================= //
+
+void EnvironmentScheduler::logReport(void) const
+{
+    if (m_ticks == 0){
+        return;
+    }
+
+    const Ogre::Real seconds = (m_ticks * m_msPerTick) / 1000.f;
+
+    Talos::Log::getSingleton().log("Environment update: " +
+                                   toString(this->getAverageTimeSpent()) +
+                                   " ms/tick average, budget " +
+                                   toString(m_budget) + " ms");
+
+    for (std::vector<Task>::const_iterator itr = m_tasks.begin();
+         itr != m_tasks.end();
+         ++itr){
+        const Ogre::Real avg = (itr->runs == 0) ? 0.f :
+            itr->totalTime / itr->runs;
+
+        Talos::Log::getSingleton().log("  " + itr->name + ": " +
+                                       toString(itr->runs / seconds) +
+                                       " Hz, " + toString(avg) +
+                                       " ms/run, " +
+                                       ((itr->throttled) ? 
+                                        toString(itr->forcedRuns) + 
+                                        " forced" : "unthrottled"));
+    }
+}
+
+// ========================================================================= //
+
+void EnvironmentScheduler::setTaskEnabled(const TaskHandle handle,
+                                          const bool enabled)
+{
+    Task& task = m_tasks[handle];
+    if (enabled && task.enabled == false){
+        // Catch up on the next tick.
+        task.ticksSinceRun = std::max<uint32_t>(task.ticksSinceRun, 1);
+    }
+
+    task.enabled = enabled;
+}
+
+// ========================================================================= //
\ No newline at end of file
@@ -0,0 +1,195 @@
+// ========================================================================= //
+// Talos - A 3D game engine with network multiplayer.
+// Copyright(C) 2015 Jordan Sparks <unixunited@live.com>
+//
+// This program is free software; you can redistribute it and / or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 3
+// of the License, or(at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+// ========================================================================= //
+// File: EnvironmentScheduler.hpp
+// Author: Jordan Sparks <unixunited@live.com>
+// ========================================================================= //
+// Defines EnvironmentScheduler class.
+// ========================================================================= //
+
+#ifndef __ENVIRONMENTSCHEDULER_HPP__
+#define __ENVIRONMENTSCHEDULER_HPP__
+
+// ========================================================================= //
+
+#include "stdafx.hpp"
+
+#include <functional>
+
+// ========================================================================= //
+// Spreads the Environment's subsystem updates (ocean, sky, clouds, SSAO)
+// across ticks within a millisecond budget. Each task declares its expected
+// cost and the refresh rates it wants and can tolerate; tasks run at their
+// preferred rate while the budget allows and fall back towards their minimum
+// rate under load. Per-frame rendering passes are registered unthrottled:
+// they run every tick and are timed, but never skipped or charged against
+// the budget. Statistics are logged periodically and on request.
+class EnvironmentScheduler final
+{
+public:
+    // Receives the animation time accumulated since the task last ran.
+    typedef std::function<void(const Ogre::Real)> UpdateFunc;
+
+    typedef uint32_t TaskHandle;
+
+    // Per-task declaration and statistics.
+    struct Task{
+        std::string name;
+        UpdateFunc update;
+        bool enabled;
+
+        // Declared cost in milliseconds, refined by measurements.
+        Ogre::Real cost;
+        // Refresh rates in Hz. A preferred rate of 0 means every tick; the
+        // task is forced to run once its minimum rate would be missed.
+        Ogre::Real preferredRate;
+        Ogre::Real minRate;
+        // False for passes that must run every tick.
+        bool throttled;
+
+        // Ticks since the task last ran.
+        uint32_t ticksSinceRun;
+
+        // Statistics.
+        Ogre::Real lastCost;
+        Ogre::Real totalTime;
+        uint32_t runs;
+        uint32_t forcedRuns;
+    };
+
+    // Takes the fixed tick length in milliseconds and the animation step
+    // each tick represents to the subsystems.
+    explicit EnvironmentScheduler(const Ogre::Real msPerTick,
+                                  const Ogre::Real stepPerTick);
+
+    // Empty destructor.
+    ~EnvironmentScheduler(void);
+
+    // Registers a task and returns its handle.
+    TaskHandle addTask(const std::string& name,
+                       const UpdateFunc& update,
+                       const Ogre::Real cost,
+                       const Ogre::Real minRate,
+                       const Ogre::Real preferredRate = 0.f);
+
+    // Registers a pass that runs every tick outside the budget, e.g. a
+    // screen-space effect that must be redrawn each frame.
+    TaskHandle addUnthrottledTask(const std::string& name,
+                                  const UpdateFunc& update);
+
+    // Removes all tasks.
+    void clear(void);
+
+    // Runs the unthrottled tasks, then the tasks due this tick, most overdue
+    // first, until the budget is spent. Tasks about to miss their minimum 
+    // rate always run. Logs the report every report interval.
+    void update(void);
+
+    // Writes per-task timing statistics to the log.
+    void logReport(void) const;
+
+    // Getters:
+
+    // Returns per-tick budget in milliseconds.
+    const Ogre::Real getBudget(void) const;
+
+    // Returns time spent running throttled tasks during the last tick in 
+    // milliseconds.
+    const Ogre::Real getTimeSpent(void) const;
+
+    // Returns average time spent per tick in milliseconds.
+    const Ogre::Real getAverageTimeSpent(void) const;
+
+    // Returns task data for statistics.
+    const Task& getTask(const TaskHandle) const;
+
+    // Returns number of registered tasks.
+    const size_t getTaskCount(void) const;
+
+    // Setters:
+
+    // Sets per-tick budget in milliseconds.
+    void setBudget(const Ogre::Real);
+
+    // Enables or disables a task. A re-enabled task runs on the next tick.
+    void setTaskEnabled(const TaskHandle, const bool);
+
+    // Sets milliseconds of ticks between reports, 0 to only report on 
+    // request.
+    void setReportInterval(const Ogre::Real);
+
+private:
+    // Milliseconds until the task misses its minimum rate.
+    const Ogre::Real getSlack(const Task& task) const;
+
+    // Runs a task and records its cost.
+    void run(Task& task);
+
+    std::vector<Task> m_tasks;
+    std::vector<TaskHandle> m_due;
+    Ogre::Real m_msPerTick;
+    Ogre::Real m_stepPerTick;
+    Ogre::Real m_budget;
+    uint32_t m_reportTicks;
+
+    // Timing.
+    Ogre::Timer m_timer;
+    Ogre::Real m_timeSpent;
+    Ogre::Real m_totalTimeSpent;
+    uint32_t m_ticks;
+};
+
+// ========================================================================= //
+
+// Getters:
+
+inline const Ogre::Real EnvironmentScheduler::getBudget(void) const{
+    return m_budget;
+}
+
+inline const Ogre::Real EnvironmentScheduler::getTimeSpent(void) const{
+    return m_timeSpent;
+}
+
+inline const Ogre::Real EnvironmentScheduler::getAverageTimeSpent(void) const{
+    return (m_ticks == 0) ? 0.f : m_totalTimeSpent / m_ticks;
+}
+
+inline const EnvironmentScheduler::Task&
+EnvironmentScheduler::getTask(const TaskHandle handle) const{
+    return m_tasks[handle];
+}
+
+inline const size_t EnvironmentScheduler::getTaskCount(void) const{
+    return m_tasks.size();
+}
+
+// Setters:
+
+inline void EnvironmentScheduler::setBudget(const Ogre::Real budget){
+    m_budget = budget;
+}
+
+inline void EnvironmentScheduler::setReportInterval(const Ogre::Real ms){
+    m_reportTicks = static_cast<uint32_t>(ms / m_msPerTick);
+}
+
+// ========================================================================= //
+
+#endif
+
+// ========================================================================= //
\ No newline at end of file
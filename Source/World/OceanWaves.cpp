@@ -0,0 +1,506 @@
+// ========================================================================= //
+// Talos - A 3D game engine with network multiplayer.
+// Copyright(C) 2015 Jordan Sparks <unixunited@live.com>
+//
+// This program is free software; you can redistribute it and / or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 3
+// of the License, or(at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+// ========================================================================= //
+// File: OceanWaves.cpp
+// Author: Jordan Sparks <unixunited@live.com>
+// ========================================================================= //
+// Implements OceanWaves class.
+// ========================================================================= //
+
+#include "OceanWaves.hpp"
+
+#include <OgrePlatformInformation.h>
+
+#if __OGRE_HAVE_SSE
+#include <emmintrin.h>
+#endif
+
+// ========================================================================= //
+
+OceanWaves::OceanWaves(const uint32_t seed) :
+m_frames(TileTexels * NoiseFrames),
+m_octaves(),
+m_packs(),
+m_frequencies(),
+m_options(),
+m_time(0.f),
+m_level(0.f)
+{
+    // Uniform noise in [-2, 2] from a xorshift generator, so every machine
+    // produces the same frames for the same seed.
+    std::vector<float> uniform(m_frames.size());
+    uint32_t state = (seed != 0) ? seed : 0x9E3779B9;
+    for (size_t i = 0; i < uniform.size(); ++i){
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        uniform[i] = 4.f * (static_cast<float>(state) / 4294967295.f - 0.5f);
+    }
+
+    // Smooth each frame with a wrapping 3x3 kernel, as Hydrax's Perlin does.
+    for (uint32_t frame = 0; frame < NoiseFrames; ++frame){
+        const float* src = &uniform[frame * TileTexels];
+        float* dst = &m_frames[frame * TileTexels];
+
+        for (uint32_t v = 0; v < TileSize; ++v){
+            const uint32_t v0 = ((v - 1) & TileMask) * TileSize;
+            const uint32_t v1 = v * TileSize;
+            const uint32_t v2 = ((v + 1) & TileMask) * TileSize;
+
+            for (uint32_t u = 0; u < TileSize; ++u){
+                const uint32_t u0 = (u - 1) & TileMask;
+                const uint32_t u2 = (u + 1) & TileMask;
+
+                dst[v1 + u] = (1.f / 14.f) *
+                    (src[v0 + u0] + src[v0 + u] + src[v0 + u2] +
+                     src[v1 + u0] + 6.f * src[v1 + u] + src[v1 + u2] +
+                     src[v2 + u0] + src[v2 + u] + src[v2 + u2]);
+            }
+        }
+    }
+
+    this->buildOctaves();
+}
+
+// ========================================================================= //
+
+OceanWaves::~OceanWaves(void)
+{
+
+}
+
+// ========================================================================= //
+
+void OceanWaves::loadConfig(const std::string& cfg)
+{
+    Ogre::DataStreamPtr stream;
+    try{
+        stream = Ogre::ResourceGroupManager::getSingleton().openResource(cfg);
+    }
+    catch (const Ogre::Exception& e){
+        Talos::Log::getSingleton().log("OceanWaves: Unable to open " + cfg +
+                                       ", keeping current options: " +
+                                       e.getDescription());
+        return;
+    }
+
+    // Lines look like "<float>Perlin_Scale=0.085".
+    Options options = m_options;
+    while (!stream->eof()){
+        std::string line = stream->getLine();
+        if (line.empty() || line[0] == '#'){
+            continue;
+        }
+
+        if (line[0] == '<'){
+            const size_t end = line.find('>');
+            if (end == std::string::npos){
+                continue;
+            }
+            line = line.substr(end + 1);
+        }
+
+        const size_t eq = line.find('=');
+        if (eq == std::string::npos){
+            continue;
+        }
+
+        const std::string key = line.substr(0, eq);
+        const std::string value = line.substr(eq + 1);
+
+        if (key == "Perlin_Octaves"){
+            options.octaves = Ogre::StringConverter::parseUnsignedInt(
+                value, options.octaves);
+        }
+        else if (key == "Perlin_Scale"){
+            options.scale = Ogre::StringConverter::parseReal(value, 
+                                                             options.scale);
+        }
+        else if (key == "Perlin_Falloff"){
+            options.falloff = Ogre::StringConverter::parseReal(
+                value, options.falloff);
+        }
+        else if (key == "Perlin_Animspeed"){
+            options.animSpeed = Ogre::StringConverter::parseReal(
+                value, options.animSpeed);
+        }
+        else if (key == "Perlin_Timemulti"){
+            options.timeMulti = Ogre::StringConverter::parseReal(
+                value, options.timeMulti);
+        }
+        else if (key == "PG_Strength"){
+            options.strength = Ogre::StringConverter::parseReal(
+                value, options.strength);
+        }
+    }
+
+    this->setOptions(options);
+}
+
+// ========================================================================= //
+
+void OceanWaves::update(const Ogre::Real dt)
+{
+    m_time += dt;
+
+    this->buildOctaves();
+}
+
+// ========================================================================= //
+
+void OceanWaves::buildOctaves(void)
+{
+    const uint32_t octaves = (m_options.octaves < MaxOctaves) ? 
+        m_options.octaves : MaxOctaves;
+    // Hydrax only reads whole packs; remaining octaves still count towards
+    // the strength normalisation below.
+    const uint32_t packs = octaves / PackOctaves;
+
+    m_octaves.resize(octaves * TileTexels);
+    m_packs.resize(packs * PackTexels);
+    m_frequencies.resize(packs);
+
+    // Octave strengths fall off geometrically and are normalised to sum 1.
+    float strengths[MaxOctaves];
+    float sum = 0.f;
+    for (uint32_t o = 0; o < octaves; ++o){
+        strengths[o] = std::pow(m_options.falloff, static_cast<float>(o));
+        sum += strengths[o];
+    }
+
+    const double PI_3 = Ogre::Math::PI / 3.0;
+    double timeMulti = 1.0;
+
+    for (uint32_t o = 0; o < packs * PackOctaves; ++o){
+        // Cross-fade three consecutive frames; the sin^2 weights of phases 
+        // 120 degrees apart sum to 1.5.
+        double whole = 0.0;
+        const double fraction = std::modf(m_time * m_options.animSpeed * 
+                                          timeMulti, &whole);
+        const uint32_t image = static_cast<uint32_t>(
+            static_cast<uint64_t>(whole) & (NoiseFrames - 1));
+
+        const float* frames[3];
+        float amounts[3];
+        for (uint32_t k = 0; k < 3; ++k){
+            const double s = std::sin((fraction + 2.0 - k) * PI_3);
+
+            frames[k] = &m_frames[((image + k) & (NoiseFrames - 1)) * 
+                                  TileTexels];
+            amounts[k] = static_cast<float>((strengths[o] / sum) * 
+                                            (s * s) / 1.5);
+        }
+
+        float* tile = &m_octaves[o * TileTexels];
+        for (uint32_t i = 0; i < TileTexels; ++i){
+            tile[i] = amounts[0] * frames[0][i] + 
+                amounts[1] * frames[1][i] + 
+                amounts[2] * frames[2][i];
+        }
+
+        timeMulti *= m_options.timeMulti;
+    }
+
+    // Pack four octaves per PackSize^2 texture the way Hydrax does: the
+    // last at full rate, the first three bilinearly upsampled 8x, 4x and
+    // 2x. One bilinear read of a pack then equals reading its four octaves
+    // separately, and each pack is 16 times the frequency of the previous.
+    for (uint32_t p = 0; p < packs; ++p){
+        const float* tiles = &m_octaves[p * PackOctaves * TileTexels];
+        float* pack = &m_packs[p * PackTexels];
+
+        for (uint32_t v = 0; v < PackSize; ++v){
+            for (uint32_t u = 0; u < PackSize; ++u){
+                float value = tiles[3 * TileTexels + 
+                                    (v & TileMask) * TileSize + 
+                                    (u & TileMask)];
+
+                for (uint32_t k = 0; k < 3; ++k){
+                    const float* tile = &tiles[k * TileTexels];
+                    const uint32_t power = 3 - k;
+                    const uint32_t mask = (1 << power) - 1;
+                    const float fu = static_cast<float>(u & mask) / 
+                        (1 << power);
+                    const float fv = static_cast<float>(v & mask) / 
+                        (1 << power);
+                    const uint32_t u0 = (u >> power) & TileMask;
+                    const uint32_t u1 = (u0 + 1) & TileMask;
+                    const uint32_t v0 = ((v >> power) & TileMask) * TileSize;
+                    const uint32_t v1 = (((v >> power) + 1) & TileMask) * 
+                        TileSize;
+
+                    const float ab = tile[v0 + u0] + 
+                        (tile[v0 + u1] - tile[v0 + u0]) * fu;
+                    const float cd = tile[v1 + u0] + 
+                        (tile[v1 + u1] - tile[v1 + u0]) * fu;
+                    value += ab + (cd - ab) * fv;
+                }
+
+                pack[v * PackSize + u] = value;
+            }
+        }
+
+        // Pack texels per world unit; Perlin_Scale is per pack texel.
+        m_frequencies[p] = m_options.scale * 
+            std::ldexp(1.f, static_cast<int>(p * PackOctaves));
+    }
+}
+
+// ========================================================================= //
+
+void OceanWaves::evaluate(const Ogre::Real* x,
+                          const Ogre::Real* z,
+                          Ogre::Real* heights,
+                          Ogre::Real* dx,
+                          Ogre::Real* dz,
+                          const size_t n) const
+{
+    const uint32_t packs = static_cast<uint32_t>(m_frequencies.size());
+    const bool gradient = (dx != nullptr || dz != nullptr);
+    size_t i = 0;
+
+#if __OGRE_HAVE_SSE
+    // Four points at a time. Texel fetches are scalar (no gather), the
+    // filtering and accumulation are vectorised.
+    const __m128 vOne = _mm_set1_ps(1.f);
+    const __m128 vLevel = _mm_set1_ps(m_level);
+    const __m128 vStrength = _mm_set1_ps(m_options.strength);
+
+    for (; i + 4 <= n; i += 4){
+        const __m128 px = _mm_loadu_ps(x + i);
+        const __m128 pz = _mm_loadu_ps(z + i);
+
+        __m128 h = _mm_setzero_ps();
+        __m128 gx = _mm_setzero_ps();
+        __m128 gz = _mm_setzero_ps();
+
+        for (uint32_t o = 0; o < packs; ++o){
+            const float* pack = &m_packs[o * PackTexels];
+            const __m128 freq = _mm_set1_ps(m_frequencies[o]);
+            const __m128 u = _mm_mul_ps(px, freq);
+            const __m128 v = _mm_mul_ps(pz, freq);
+
+            // Floor: truncate, then step down where truncation rounded up.
+            __m128 fu = _mm_cvtepi32_ps(_mm_cvttps_epi32(u));
+            __m128 fv = _mm_cvtepi32_ps(_mm_cvttps_epi32(v));
+            fu = _mm_sub_ps(fu, _mm_and_ps(_mm_cmpgt_ps(fu, u), vOne));
+            fv = _mm_sub_ps(fv, _mm_and_ps(_mm_cmpgt_ps(fv, v), vOne));
+
+            const __m128 tu = _mm_sub_ps(u, fu);
+            const __m128 tv = _mm_sub_ps(v, fv);
+
+            int32_t iu[4], iv[4];
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(iu), 
+                             _mm_cvttps_epi32(fu));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(iv), 
+                             _mm_cvttps_epi32(fv));
+
+            float a[4], b[4], c[4], d[4];
+            for (uint32_t l = 0; l < 4; ++l){
+                const uint32_t u0 = iu[l] & PackMask;
+                const uint32_t u1 = (u0 + 1) & PackMask;
+                const uint32_t v0 = (iv[l] & PackMask) * PackSize;
+                const uint32_t v1 = ((iv[l] + 1) & PackMask) * PackSize;
+
+                a[l] = pack[v0 + u0];
+                b[l] = pack[v0 + u1];
+                c[l] = pack[v1 + u0];
+                d[l] = pack[v1 + u1];
+            }
+            const __m128 va = _mm_loadu_ps(a);
+            const __m128 vb = _mm_loadu_ps(b);
+            const __m128 vc = _mm_loadu_ps(c);
+            const __m128 vd = _mm_loadu_ps(d);
+
+            // Bilinear filter.
+            const __m128 dab = _mm_sub_ps(vb, va);
+            const __m128 dcd = _mm_sub_ps(vd, vc);
+            const __m128 ab = _mm_add_ps(va, _mm_mul_ps(dab, tu));
+            const __m128 cd = _mm_add_ps(vc, _mm_mul_ps(dcd, tu));
+            const __m128 dv = _mm_sub_ps(cd, ab);
+            h = _mm_add_ps(h, _mm_add_ps(ab, _mm_mul_ps(dv, tv)));
+
+            if (gradient){
+                const __m128 du = _mm_add_ps(dab, 
+                    _mm_mul_ps(_mm_sub_ps(dcd, dab), tv));
+                gx = _mm_add_ps(gx, _mm_mul_ps(du, freq));
+                gz = _mm_add_ps(gz, _mm_mul_ps(dv, freq));
+            }
+        }
+
+        if (heights != nullptr){
+            _mm_storeu_ps(heights + i, 
+                          _mm_add_ps(vLevel, _mm_mul_ps(h, vStrength)));
+        }
+        if (dx != nullptr){
+            _mm_storeu_ps(dx + i, _mm_mul_ps(gx, vStrength));
+        }
+        if (dz != nullptr){
+            _mm_storeu_ps(dz + i, _mm_mul_ps(gz, vStrength));
+        }
+    }
+#endif
+
+    // Remaining points (all of them without SSE).
+    for (; i < n; ++i){
+        float h = 0.f, gx = 0.f, gz = 0.f;
+
+        for (uint32_t o = 0; o < packs; ++o){
+            const float* pack = &m_packs[o * PackTexels];
+            const float freq = m_frequencies[o];
+            const float u = x[i] * freq;
+            const float v = z[i] * freq;
+            const float fu = std::floor(u);
+            const float fv = std::floor(v);
+            const float tu = u - fu;
+            const float tv = v - fv;
+
+            const uint32_t u0 = static_cast<int32_t>(fu) & PackMask;
+            const uint32_t u1 = (u0 + 1) & PackMask;
+            const uint32_t v0 = (static_cast<int32_t>(fv) & PackMask) * 
+                PackSize;
+            const uint32_t v1 = ((static_cast<int32_t>(fv) + 1) & PackMask) * 
+                PackSize;
+
+            const float a = pack[v0 + u0];
+            const float b = pack[v0 + u1];
+            const float c = pack[v1 + u0];
+            const float d = pack[v1 + u1];
+
+            const float ab = a + (b - a) * tu;
+            const float cd = c + (d - c) * tu;
+            h += ab + (cd - ab) * tv;
+
+            if (gradient){
+                gx += ((b - a) + ((d - c) - (b - a)) * tv) * freq;
+                gz += (cd - ab) * freq;
+            }
+        }
+
+        if (heights != nullptr){
+            heights[i] = m_level + h * m_options.strength;
+        }
+        if (dx != nullptr){
+            dx[i] = gx * m_options.strength;
+        }
+        if (dz != nullptr){
+            dz[i] = gz * m_options.strength;
+        }
+    }
+}
+
+// ========================================================================= //
+
+const Ogre::Real OceanWaves::getNoise(const Ogre::Real x, 
+                                      const Ogre::Real z) const
+{
+    if (m_options.strength == 0.f){
+        return 0.f;
+    }
+
+    return (this->getHeight(x, z) - m_level) / m_options.strength;
+}
+
+// ========================================================================= //
+
+const Ogre::Real OceanWaves::getHeight(const Ogre::Real x, 
+                                       const Ogre::Real z) const
+{
+    Ogre::Real height = 0.f;
+    this->evaluate(&x, &z, &height, nullptr, nullptr, 1);
+
+    return height;
+}
+
+// ========================================================================= //
+
+const Ogre::Vector3 OceanWaves::getNormal(const Ogre::Real x,
+                                          const Ogre::Real z) const
+{
+    Ogre::Vector3 normal;
+    this->getHeightsAndNormals(&x, &z, nullptr, &normal, 1);
+
+    return normal;
+}
+
+// ========================================================================= //
+
+void OceanWaves::getHeights(const Ogre::Real* x,
+                            const Ogre::Real* z,
+                            Ogre::Real* heights,
+                            const size_t n) const
+{
+    this->evaluate(x, z, heights, nullptr, nullptr, n);
+}
+
+// ========================================================================= //
+
+void OceanWaves::getHeightsAndNormals(const Ogre::Real* x,
+                                      const Ogre::Real* z,
+                                      Ogre::Real* heights,
+                                      Ogre::Vector3* normals,
+                                      const size_t n) const
+{
+    if (normals == nullptr){
+        this->evaluate(x, z, heights, nullptr, nullptr, n);
+        return;
+    }
+
+    // Slopes go through a small stack buffer, in chunks.
+    const size_t ChunkSize = 256;
+    Ogre::Real dx[ChunkSize], dz[ChunkSize];
+
+    for (size_t i = 0; i < n; i += ChunkSize){
+        const size_t count = std::min(ChunkSize, n - i);
+
+        this->evaluate(x + i,
+                       z + i,
+                       (heights != nullptr) ? heights + i : nullptr,
+                       dx,
+                       dz,
+                       count);
+
+        for (size_t k = 0; k < count; ++k){
+            normals[i + k] = Ogre::Vector3(-dx[k], 1.f, -dz[k]);
+            normals[i + k].normalise();
+        }
+    }
+}
+
+// ========================================================================= //
+
+// Setters:
+
+// ========================================================================= //
+
+void OceanWaves::setOptions(const Options& options)
+{
+    m_options = options;
+
+    this->buildOctaves();
+}
+
+// ========================================================================= //
+
+void OceanWaves::setTime(const Ogre::Real time)
+{
+    m_time = time;
+
+    this->buildOctaves();
+}
+
+// ========================================================================= //
\ No newline at end of file
@@ -0,0 +1,184 @@
+// ========================================================================= //
+// Talos - A 3D game engine with network multiplayer.
+// Copyright(C) 2015 Jordan Sparks <unixunited@live.com>
+//
+// This program is free software; you can redistribute it and / or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 3
+// of the License, or(at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+// ========================================================================= //
+// File: OceanWaves.hpp
+// Author: Jordan Sparks <unixunited@live.com>
+// ========================================================================= //
+// Defines OceanWaves class.
+// ========================================================================= //
+
+#ifndef __OCEANWAVES_HPP__
+#define __OCEANWAVES_HPP__
+
+// ========================================================================= //
+
+#include "stdafx.hpp"
+
+// ========================================================================= //
+// CPU model of the ocean surface: animated multi-octave Perlin noise laid out
+// and filtered as Hydrax's Perlin module does, with the parameters Hydrax
+// reads from its config (Perlin_* and PG_Strength). Like Hydrax, only whole
+// packs of four octaves are used. Noise frames come from a fixed seed rather
+// than rand(), so the waves differ in detail but not in character.
+// Has no rendering dependency, so dedicated servers evaluate the same surface
+// as clients. Batched queries process four points per SSE instruction.
+class OceanWaves final
+{
+public:
+    // Noise and surface parameters, defaults match HydraxDemo.hdx.
+    struct Options{
+        explicit Options(void) :
+        octaves(8),
+        scale(0.085f),
+        falloff(0.49f),
+        animSpeed(1.f),
+        timeMulti(1.f),
+        strength(35.f) { }
+
+        uint32_t octaves;
+        Ogre::Real scale;
+        Ogre::Real falloff;
+        Ogre::Real animSpeed;
+        Ogre::Real timeMulti;
+        // Wave height multiplier (PG_Strength).
+        Ogre::Real strength;
+    };
+
+    // Generates the noise frames from seed. Clients and servers must use the
+    // same seed to agree on the surface.
+    explicit OceanWaves(const uint32_t seed = 0x5EED);
+
+    // Empty destructor.
+    ~OceanWaves(void);
+
+    // Reads noise options from a Hydrax config file in the resource groups.
+    // Missing keys keep their current values.
+    void loadConfig(const std::string& cfg);
+
+    // Advances the animation by dt units of time.
+    void update(const Ogre::Real dt);
+
+    // Returns unscaled noise value at world x, z (what Hydrax displaces by
+    // strength).
+    const Ogre::Real getNoise(const Ogre::Real x, const Ogre::Real z) const;
+
+    // Returns surface height at world x, z.
+    const Ogre::Real getHeight(const Ogre::Real x, const Ogre::Real z) const;
+
+    // Returns surface normal at world x, z.
+    const Ogre::Vector3 getNormal(const Ogre::Real x, const Ogre::Real z) const;
+
+    // Writes surface heights at n points given as separate x and z arrays.
+    void getHeights(const Ogre::Real* x, 
+                    const Ogre::Real* z, 
+                    Ogre::Real* heights,
+                    const size_t n) const;
+
+    // Writes surface heights and normals at n points. Either output may be
+    // nullptr.
+    void getHeightsAndNormals(const Ogre::Real* x,
+                              const Ogre::Real* z,
+                              Ogre::Real* heights,
+                              Ogre::Vector3* normals,
+                              const size_t n) const;
+
+    // Getters:
+
+    // Returns current noise options.
+    const Options& getOptions(void) const;
+
+    // Returns animation time.
+    const Ogre::Real getTime(void) const;
+
+    // Returns height of the still water plane.
+    const Ogre::Real getLevel(void) const;
+
+    // Setters:
+
+    // Sets noise options.
+    void setOptions(const Options&);
+
+    // Sets animation time, e.g. to match a server's clock.
+    void setTime(const Ogre::Real);
+
+    // Sets height of the still water plane.
+    void setLevel(const Ogre::Real);
+
+private:
+    // Blends the noise frames of each octave for the current time.
+    void buildOctaves(void);
+
+    // Evaluates n points. Heights are absolute, gradients are surface slopes
+    // along x and z. Gradient outputs may be nullptr.
+    void evaluate(const Ogre::Real* x,
+                  const Ogre::Real* z,
+                  Ogre::Real* heights,
+                  Ogre::Real* dx,
+                  Ogre::Real* dz,
+                  const size_t n) const;
+
+    // Noise tiles are TileSize^2 texels, animated over NoiseFrames frames.
+    static const uint32_t TileSize = 16;
+    static const uint32_t TileMask = TileSize - 1;
+    static const uint32_t TileTexels = TileSize * TileSize;
+    static const uint32_t NoiseFrames = 256;
+    static const uint32_t MaxOctaves = 32;
+    // Octaves are read in packs of four, PackSize^2 texels each.
+    static const uint32_t PackOctaves = 4;
+    static const uint32_t PackSize = TileSize * 8;
+    static const uint32_t PackMask = PackSize - 1;
+    static const uint32_t PackTexels = PackSize * PackSize;
+
+    std::vector<float> m_frames;
+    // Per-octave weighted tiles.
+    std::vector<float> m_octaves;
+    // Packed octaves and their frequencies in pack texels per unit.
+    std::vector<float> m_packs;
+    std::vector<float> m_frequencies;
+
+    Options m_options;
+    Ogre::Real m_time;
+    Ogre::Real m_level;
+};
+
+// ========================================================================= //
+
+// Getters:
+
+inline const OceanWaves::Options& OceanWaves::getOptions(void) const{
+    return m_options;
+}
+
+inline const Ogre::Real OceanWaves::getTime(void) const{
+    return m_time;
+}
+
+inline const Ogre::Real OceanWaves::getLevel(void) const{
+    return m_level;
+}
+
+// Setters:
+
+inline void OceanWaves::setLevel(const Ogre::Real level){
+    m_level = level;
+}
+
+// ========================================================================= //
+
+#endif
+
+// ========================================================================= //
\ No newline at end of file
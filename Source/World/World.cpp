@@ -21,19 +21,27 @@
 // Implements World class.
 // ========================================================================= //
 
+#include "Audio/AudioManager.hpp"
+#include "Audio/IrrKlangBackend.hpp"
+#include "Audio/NullAudioBackend.hpp"
 #include "Component/AllComponents.hpp"
+#include "Core/Talos.hpp"
 #include "Entity/EntityPool.hpp"
 #include "Environment.hpp"
 #include "Input/Input.hpp"
+#include "Loader/SceneLoadQueue.hpp"
+#include "Loader/SceneTemplateCache.hpp"
 #include "Network/NullNetwork.hpp"
 #include "Network/Client/Client.hpp"
 #include "Network/Server/Server.hpp"
 #include "Physics/PScene.hpp"
 #include "Pool/Pool.hpp"
+#include "Rendering/ShadowManager.hpp"
 #include "Rendering/Listeners/WeaponListener.hpp"
 #include "System/System.hpp"
 #include "System/SystemManager.hpp"
 #include "World.hpp"
+#include "WorldStreamer.hpp"
 
 // ========================================================================= //
 
@@ -47,9 +55,13 @@ m_scene(nullptr),
 m_viewport(nullptr),
 m_environment(nullptr),
 m_graphics(),
+m_shadowManager(nullptr),
 m_physics(nullptr),
 m_PScene(nullptr),
 m_usePhysics(false),
+m_sceneTemplates(nullptr),
+m_sceneLoads(nullptr),
+m_worldStreamer(nullptr),
 m_network(nullptr),
 m_server(nullptr),
 m_client(nullptr),
@@ -62,10 +74,16 @@ m_hasPlayer(false),
 m_mainCameraC(nullptr),
 m_input(nullptr),
 m_soundEngine(nullptr),
-m_sounds(),
-m_musicCount(0)
+m_audio(nullptr),
+m_music(),
+m_metricsTimer(),
+m_updateTime(nullptr),
+m_entityCount(nullptr),
+m_physicalVoices(nullptr),
+m_virtualVoices(nullptr),
+m_poolGauges()
 {
-    m_sounds.reserve(10);
+
 }
 
 // ========================================================================= //
@@ -96,6 +114,7 @@ void World::init(const bool usePhysics)
     // Create Ogre scene for rendering.
     m_scene = m_root->createSceneManager(Ogre::ST_GENERIC);
     m_scene->addRenderQueueListener(new WeaponRenderListener());
+    m_shadowManager.reset(new ShadowManager(m_scene));
 
     switch (m_graphics.shadows){
     default:
@@ -109,20 +128,23 @@ void World::init(const bool usePhysics)
         // Set shadow shader.
         m_scene->setShadowTextureCasterMaterial("Sparks/shadow_caster");
 
-        // Setup shadow texture settings.
-        m_scene->setShadowTextureCount(8);
-        m_scene->setShadowTextureSize(1024);
-
-        // Using float16 for R and G channels.
-        m_scene->setShadowTexturePixelFormat(Ogre::PF_FLOAT16_RGB);
-
         // VSM doesn't need biasing, this would be worthless.
         m_scene->setShadowCasterRenderBackFaces(false);
 
         // Use integrated additive shadows with these shaders.
         m_scene->setShadowTechnique(Ogre::SHADOWTYPE_TEXTURE_ADDITIVE_INTEGRATED);
 
-        m_scene->setShadowTextureFSAA(16);
+        // Shadow maps in size tiers, using float16 for R and G channels.
+        {
+            std::vector<ShadowManager::Tier> tiers(3);
+            tiers[0].size = 1024;
+            tiers[0].count = 2;
+            tiers[1].size = 512;
+            tiers[1].count = 2;
+            tiers[2].size = 256;
+            tiers[2].count = 4;
+            m_shadowManager->init(tiers, Ogre::PF_FLOAT16_RGB, 16);
+        }
 
         /*const uint32_t rtts = m_scene->getShadowTextureCount();
         for (uint32_t i = 0; i < rtts; ++i){
@@ -143,6 +165,15 @@ void World::init(const bool usePhysics)
         this->initPhysics();
     }
 
+    // Mix through irrKlang, or silently when there is no device.
+    m_audio.reset(new AudioManager((m_soundEngine != nullptr) ?
+        static_cast<AudioBackend*>(new IrrKlangBackend(m_soundEngine)) :
+        new NullAudioBackend()));
+
+    m_sceneTemplates.reset(new SceneTemplateCache());
+    m_sceneLoads.reset(new SceneLoadQueue());
+    m_worldStreamer.reset(new WorldStreamer(shared_from_this()));
+
     // Allocate Entity pool.
     // @TODO: Read pool size from config file.
     m_entityPool.reset(new EntityPool(256));
@@ -184,6 +215,33 @@ void World::init(const bool usePhysics)
 
     m_systemManager.reset(new SystemManager(shared_from_this()));
 
+    // Register metrics, labelling each component pool by its type name.
+    Talos::Metrics& metrics = Talos::Metrics::getSingleton();
+    m_updateTime = metrics.getHistogram("talos_world_update_ms",
+                                        "Time spent in World::update.");
+    m_entityCount = metrics.getGauge("talos_entities", "Entities in use.");
+    m_physicalVoices = metrics.getGauge("talos_audio_voices",
+                                        "Sounds being mixed.");
+    m_virtualVoices = metrics.getGauge("talos_audio_virtual_voices",
+                                       "Sounds tracked without mixing.");
+    m_poolGauges.clear();
+    for (auto& pool : m_componentPools){
+        std::string name = pool.first->name();
+        const size_t space = name.find_last_of(' ');
+        if (space != std::string::npos){
+            name = name.substr(space + 1);
+        }
+        const std::string labels = "pool=\"" + name + "\"";
+
+        metrics.getGauge("talos_pool_capacity", "Component pool size.",
+                         labels)->set(pool.second->getSize());
+        m_poolGauges.push_back(std::make_pair(
+            pool.second.get(),
+            metrics.getGauge("talos_pool_used",
+                             "Component pool objects in use.",
+                             labels)));
+    }
+
     // Assign Network pointer if server or client is active.
     if (m_server->initialized()){
         m_network = m_server.get();
@@ -207,20 +265,25 @@ void World::destroy(void)
     }
     m_entityIDMap.clear();
 
+    // Streamed cells own static actors, so unload them before the scene.
+    m_worldStreamer->clear();
+
     if (m_usePhysics){
+        // Report the scene's PhysX memory before releasing it.
+        m_physics->getAllocator().logReport();
         m_PScene->destroy();
     }
 
+    // Release template meshes along with the scene.
+    m_sceneLoads->clear();
+    m_sceneTemplates->clear();
+
     // Stop all sounds.
-    m_soundEngine->stopAllSounds();
-    for (std::vector<irrklang::ISound*>::iterator itr = std::begin(m_sounds);
-         itr != std::end(m_sounds);
-         ++itr){
-        (*itr)->drop();
-    }
-    m_sounds.clear();
-    m_musicCount = 0;
+    m_audio->stopAll();
+    m_audio->getSoundBank()->clear();
+    m_music.clear();
 
+    m_shadowManager->destroy();
     m_scene->destroyAllCameras();
     m_scene->clearScene();
     m_root->destroySceneManager(m_scene);
@@ -238,6 +301,7 @@ void World::pause(void)
 void World::resume(void)
 {
     m_viewport->setCamera(m_mainCameraC->getCamera());
+    m_shadowManager->setCamera(m_mainCameraC->getCamera());
 
     m_environment->resume();
 
@@ -253,12 +317,24 @@ void World::resume(void)
 
 void World::update(void)
 {
+    m_metricsTimer.reset();
+
     // Update each world component.
 
     m_network->update();
 
     m_systemManager->update();
 
+    // Stream in scenes, nearest the camera first.
+    if (m_sceneLoads->isLoading()){
+        const Ogre::Vector3 focus = (m_mainCameraC != nullptr) ?
+            m_mainCameraC->getCamera()->getDerivedPosition() :
+            Ogre::Vector3::ZERO;
+        m_sceneLoads->update(focus);
+    }
+
+    m_worldStreamer->update();
+
     for (int i = 0; i < m_entityPool->m_poolSize; ++i){
         if (m_player != nullptr){
             if (m_entityPool->m_pool[i].getID() == m_player->getID()){
@@ -281,9 +357,19 @@ void World::update(void)
         Ogre::Vector3 look = m_player->getComponent<ActorComponent>()->
             getOrientation() * Ogre::Vector3::NEGATIVE_UNIT_Z;
 
-        m_soundEngine->setListenerPosition(irrklang::vec3df(pos.x, pos.y, pos.z),
-                                           irrklang::vec3df(-look.x, look.y, -look.z)); 
+        m_audio->setListener(pos, look);
     }
+
+    // Hand out voices after every emitter has moved.
+    m_audio->update(Talos::MS_PER_UPDATE);
+
+    m_entityCount->set(static_cast<double>(m_entityIDMap.size()));
+    m_physicalVoices->set(m_audio->getPhysicalCount());
+    m_virtualVoices->set(m_audio->getVirtualCount());
+    for (auto& pool : m_poolGauges){
+        pool.second->set(pool.first->getActiveCount());
+    }
+    m_updateTime->observe(m_metricsTimer.getMicroseconds() / 1000.0);
 }
 
 // ========================================================================= //
@@ -708,18 +794,19 @@ CommandPtr World::handleInput(const SDL_Event& e)
 
 void World::playMusic(const std::string& file, const uint32_t instance)
 {
-    m_sounds.push_back(m_soundEngine->play2D(file.c_str(), true));
-    ++m_musicCount;
+    // Music outranks every positional sound.
+    m_music.push_back(m_audio->play2D(
+        m_audio->getSoundBank()->add(file, SoundBank::Mode::Stream),
+        true,
+        100.f));
 }
 
 // ========================================================================= //
 
 void World::stopMusic(const uint32_t instance)
 {
-    m_sounds[instance]->stop();
-    m_sounds[instance]->drop();
-    m_sounds.erase(m_sounds.begin() + instance);
-    --m_musicCount;
+    m_audio->stop(m_music[instance]);
+    m_music.erase(m_music.begin() + instance);
 }
 
 // ========================================================================= //
@@ -727,7 +814,7 @@ void World::stopMusic(const uint32_t instance)
 void World::setPlayer(const EntityPtr player)
 {
     m_player = player;
-    m_mainCameraC = m_player->getComponent<CameraComponent>();
+    this->setMainCamera(m_player->getComponent<CameraComponent>());
     m_hasPlayer = true;
 
     if (m_network->getLocalPlayer()){
@@ -735,4 +822,16 @@ void World::setPlayer(const EntityPtr player)
     }
 }
 
+// ========================================================================= //
+
+void World::setMainCamera(CameraComponentPtr cameraC)
+{
+    m_mainCameraC = cameraC;
+
+    // Without a camera the shadow budget can't rank lights.
+    if (m_mainCameraC != nullptr){
+        m_shadowManager->setCamera(m_mainCameraC->getCamera());
+    }
+}
+
 // ========================================================================= //
\ No newline at end of file
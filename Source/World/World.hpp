@@ -27,11 +27,17 @@
 // ========================================================================= //
 
 #include "Component/ComponentDecls.hpp"
+#include "Metrics/Metrics.hpp"
 #include "stdafx.hpp"
 
 // ========================================================================= //
 
 class AbstractPool;
+class AudioManager;
+class SceneLoadQueue;
+class SceneTemplateCache;
+class ShadowManager;
+class WorldStreamer;
 
 // Hash table for fast Entity lookup.
 typedef std::unordered_map<EntityID, EntityPtr> EntityIDMap;
@@ -173,6 +179,9 @@ public:
     // Returns pointer to internal Environment.
     std::shared_ptr<Environment> getEnvironment(void) const;
 
+    // Returns the shadow budget manager lights register with.
+    std::shared_ptr<ShadowManager> getShadowManager(void) const;
+
     // Returns graphics settings data.
     const Graphics& getGraphics(void) const;
 
@@ -185,6 +194,15 @@ public:
     // Returns pointer to PScene (physics scene).
     std::shared_ptr<PScene> getPScene(void) const;
 
+    // Returns cache of parsed scene templates.
+    std::shared_ptr<SceneTemplateCache> getSceneTemplateCache(void) const;
+
+    // Returns queue of scenes being instantiated over several ticks.
+    std::shared_ptr<SceneLoadQueue> getSceneLoadQueue(void) const;
+
+    // Returns streamer for large static scenes.
+    std::shared_ptr<WorldStreamer> getWorldStreamer(void) const;
+
     // Returns pointer to Network.
     Network* getNetwork(void) const;
 
@@ -194,12 +212,16 @@ public:
     // Returns pointer to internal irrKlang sound engine.
     irrklang::ISoundEngine* getSoundEngine(void) const;
 
+    // Returns the voice manager sounds are played through.
+    std::shared_ptr<AudioManager> getAudioManager(void) const;
+
     // Setters:
 
     // Sets pointer to Entity controlled by player.
     void setPlayer(const EntityPtr);
 
-    // Sets pointer to main camera which views the game world.
+    // Sets pointer to main camera which views the game world, and ranks
+    // shadow casting lights for it.
     void setMainCamera(CameraComponentPtr);
 
     // === // 
@@ -228,11 +250,21 @@ private:
     // Graphics settings.
     Graphics m_graphics;
 
+    // Shadow map budget.
+    std::shared_ptr<ShadowManager> m_shadowManager;
+
     // PhysX.    
     std::shared_ptr<Physics> m_physics;
     std::shared_ptr<PScene> m_PScene;
     bool m_usePhysics;
 
+    // Scene templates shared by MultiModelComponents, and their streaming.
+    std::shared_ptr<SceneTemplateCache> m_sceneTemplates;
+    std::shared_ptr<SceneLoadQueue> m_sceneLoads;
+
+    // Cell streaming for large static scenes.
+    std::shared_ptr<WorldStreamer> m_worldStreamer;
+
     // Network.
     Network* m_network;
     std::shared_ptr<Network> m_server;
@@ -260,8 +292,16 @@ private:
 
     // Audio.
     irrklang::ISoundEngine* m_soundEngine;
-    std::vector<irrklang::ISound*> m_sounds;
-    uint32_t m_musicCount;    
+    std::shared_ptr<AudioManager> m_audio;
+    std::vector<uint32_t> m_music;
+
+    // Runtime metrics.
+    Ogre::Timer m_metricsTimer;
+    Talos::Metrics::Histogram* m_updateTime;
+    Talos::Metrics::Gauge* m_entityCount;
+    Talos::Metrics::Gauge* m_physicalVoices;
+    Talos::Metrics::Gauge* m_virtualVoices;
+    std::vector<std::pair<AbstractPool*, Talos::Metrics::Gauge*>> m_poolGauges;
 };
 
 // ========================================================================= //
@@ -284,6 +324,10 @@ inline std::shared_ptr<Environment> World::getEnvironment(void) const{
     return m_environment;
 }
 
+inline std::shared_ptr<ShadowManager> World::getShadowManager(void) const{
+    return m_shadowManager;
+}
+
 inline const Graphics& World::getGraphics(void) const{
     return m_graphics;
 }
@@ -300,6 +344,19 @@ inline std::shared_ptr<PScene> World::getPScene(void) const{
     return m_PScene;
 }
 
+inline std::shared_ptr<SceneTemplateCache>
+World::getSceneTemplateCache(void) const{
+    return m_sceneTemplates;
+}
+
+inline std::shared_ptr<SceneLoadQueue> World::getSceneLoadQueue(void) const{
+    return m_sceneLoads;
+}
+
+inline std::shared_ptr<WorldStreamer> World::getWorldStreamer(void) const{
+    return m_worldStreamer;
+}
+
 inline Network* World::getNetwork(void) const{
     return m_network;
 }
@@ -312,10 +369,8 @@ inline irrklang::ISoundEngine* World::getSoundEngine(void) const{
     return m_soundEngine;
 }
 
-// Setters:
-
-inline void World::setMainCamera(CameraComponentPtr cameraC){
-    m_mainCameraC = cameraC;
+inline std::shared_ptr<AudioManager> World::getAudioManager(void) const{
+    return m_audio;
 }
 
 // ========================================================================= //
@@ -0,0 +1,574 @@
+// ========================================================================= //
+// Talos - A 3D game engine with network multiplayer.
+// Copyright(C) 2015 Jordan Sparks <unixunited@live.com>
+//
+// This program is free software; you can redistribute it and / or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 3
+// of the License, or(at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+// ========================================================================= //
+// File: WorldStreamer.cpp
+// Author: Jordan Sparks <unixunited@live.com>
+// ========================================================================= //
+// Implements WorldStreamer class.
+// ========================================================================= //
+
+#include "WorldStreamer.hpp"
+#include "Core/ResourceManifest.hpp"
+#include "Loader/SceneTemplate.hpp"
+#include "Physics/Cooker.hpp"
+#include "Physics/PScene.hpp"
+#include "World.hpp"
+
+#include <algorithm>
+#include <limits>
+
+// ========================================================================= //
+
+WorldStreamer::WorldStreamer(std::shared_ptr<World> world) :
+m_world(world),
+m_scenes(),
+m_cells(),
+m_sources(),
+m_candidates(),
+m_hysteresis(500.f),
+m_memoryBudget(256 * 1024 * 1024),
+m_maxLoadedCells(64),
+m_loadedCells(0),
+m_memoryUsage(0),
+m_budget(4.f),
+m_timer()
+{
+
+}
+
+// ========================================================================= //
+
+WorldStreamer::~WorldStreamer(void)
+{
+
+}
+
+// ========================================================================= //
+
+bool WorldStreamer::addScene(const std::string& file,
+                             const Ogre::Vector3& position,
+                             const Ogre::Quaternion& orientation,
+                             const Ogre::Vector3& scale,
+                             const Ogre::Real cellSize,
+                             const bool collision,
+                             const std::string& group)
+{
+    Assert(cellSize > 0.f, "World streaming needs a positive cell size");
+
+    // Meshes are loaded per cell, not up front.
+    std::shared_ptr<SceneTemplate> scene(new SceneTemplate());
+    if (scene->init(file, group, false) == false){
+        Talos::Log::getSingleton().log("Failed to stream scene " + file);
+        return false;
+    }
+
+    const BinarySceneLoader& loader = scene->getScene();
+    const SceneFile::Header& header = loader.getHeader();
+
+    // The scene's root transform replaces the placement, as it would on an
+    // attach node.
+    Ogre::Vector3 rootPosition = position;
+    Ogre::Quaternion rootOrientation = orientation;
+    Ogre::Vector3 rootScale = scale;
+    if (header.flags & SceneFile::RootPosition){
+        rootPosition = Ogre::Vector3(header.rootPosition);
+    }
+    if (header.flags & SceneFile::RootOrientation){
+        rootOrientation = Ogre::Quaternion(header.rootOrientation[0],
+                                           header.rootOrientation[1],
+                                           header.rootOrientation[2],
+                                           header.rootOrientation[3]);
+    }
+    if (header.flags & SceneFile::RootScale){
+        rootScale = Ogre::Vector3(header.rootScale);
+    }
+
+    // Derive world transforms the way Ogre would; parents precede children.
+    std::vector<Ogre::Vector3> positions(header.nodeCount);
+    std::vector<Ogre::Quaternion> orientations(header.nodeCount);
+    std::vector<Ogre::Vector3> scales(header.nodeCount);
+    for (uint32_t i = 0; i < header.nodeCount; ++i){
+        const SceneFile::Node& node = loader.getNode(i);
+
+        Ogre::Vector3 parentPosition = rootPosition;
+        Ogre::Quaternion parentOrientation = rootOrientation;
+        Ogre::Vector3 parentScale = rootScale;
+        if (node.parent != SceneFile::NoParent){
+            parentPosition = positions[node.parent];
+            parentOrientation = orientations[node.parent];
+            parentScale = scales[node.parent];
+        }
+
+        const Ogre::Quaternion localOrientation(node.orientation[0],
+                                                node.orientation[1],
+                                                node.orientation[2],
+                                                node.orientation[3]);
+
+        positions[i] = parentPosition + parentOrientation *
+            (parentScale * Ogre::Vector3(node.position));
+        orientations[i] = parentOrientation * localOrientation;
+        scales[i] = parentScale * Ogre::Vector3(node.scale);
+    }
+
+    // Bin each entity into the cell containing its node's origin.
+    const uint32_t sceneIndex = static_cast<uint32_t>(m_scenes.size());
+    std::map<std::pair<int32_t, int32_t>, size_t> cells;
+    for (uint32_t i = 0; i < header.entityCount; ++i){
+        const uint32_t node = loader.getEntity(i).node;
+
+        Placement placement;
+        placement.entity = i;
+        placement.position = positions[node];
+        placement.orientation = orientations[node];
+        placement.scale = scales[node];
+
+        const int32_t x = static_cast<int32_t>(
+            std::floor(placement.position.x / cellSize));
+        const int32_t z = static_cast<int32_t>(
+            std::floor(placement.position.z / cellSize));
+
+        std::map<std::pair<int32_t, int32_t>, size_t>::iterator itr =
+            cells.find(std::make_pair(x, z));
+        if (itr == cells.end()){
+            Cell cell;
+            cell.scene = sceneIndex;
+            cell.name = "WorldStreamer/" + file + "/" + toString(x) + "_" +
+                toString(z);
+            cell.minX = x * cellSize;
+            cell.minZ = z * cellSize;
+            cell.maxX = cell.minX + cellSize;
+            cell.maxZ = cell.minZ + cellSize;
+            cell.loaded = false;
+            cell.geometry = nullptr;
+            cell.collided = false;
+            cell.memory = 0;
+            cell.collisionMemory = 0;
+            cell.lastMemory = 0;
+            cell.distance = 0.f;
+            cell.wanted = false;
+            cell.kept = false;
+            cell.collisionWanted = false;
+            cell.collisionKept = false;
+
+            m_cells.push_back(cell);
+            itr = cells.insert(std::make_pair(std::make_pair(x, z),
+                                              m_cells.size() - 1)).first;
+        }
+
+        m_cells[itr->second].placements.push_back(placement);
+    }
+
+    Scene entry;
+    entry.scene = scene;
+    entry.cellSize = cellSize;
+    entry.collision = collision;
+    m_scenes.push_back(entry);
+    m_candidates.reserve(m_cells.size());
+
+    Talos::Log::getSingleton().log("Streaming " + file + " in " +
+                                   toString(cells.size()) + " cells of " +
+                                   toString(cellSize) + " units");
+
+    return true;
+}
+
+// ========================================================================= //
+
+WorldStreamer::SourceHandle WorldStreamer::addSource(
+    const PositionFunc& position,
+    const Ogre::Real radius,
+    const Ogre::Real visualRadius)
+{
+    Source source;
+    source.position = position;
+    source.radius = radius;
+    source.visualRadius = visualRadius;
+    source.active = true;
+
+    // Reuse a removed slot so handles stay stable.
+    for (SourceHandle i = 0; i < m_sources.size(); ++i){
+        if (m_sources[i].active == false){
+            m_sources[i] = source;
+            return i;
+        }
+    }
+
+    m_sources.push_back(source);
+
+    return static_cast<SourceHandle>(m_sources.size() - 1);
+}
+
+// ========================================================================= //
+
+void WorldStreamer::removeSource(const SourceHandle handle)
+{
+    m_sources[handle].active = false;
+    m_sources[handle].position = nullptr;
+}
+
+// ========================================================================= //
+
+const Ogre::Real WorldStreamer::getDistance(const Cell& cell,
+                                            const Ogre::Vector3& pos) const
+{
+    const Ogre::Real dx = std::max(std::max(cell.minX - pos.x, 0.f),
+                                   pos.x - cell.maxX);
+    const Ogre::Real dz = std::max(std::max(cell.minZ - pos.z, 0.f),
+                                   pos.z - cell.maxZ);
+
+    return std::sqrt(dx * dx + dz * dz);
+}
+
+// ========================================================================= //
+
+void WorldStreamer::update(void)
+{
+    if (m_cells.empty()){
+        return;
+    }
+
+    // Find which cells any source wants, or still tolerates.
+    for (std::vector<Cell>::iterator itr = m_cells.begin();
+         itr != m_cells.end();
+         ++itr){
+        itr->distance = std::numeric_limits<Ogre::Real>::max();
+        itr->wanted = false;
+        itr->kept = false;
+        itr->collisionWanted = false;
+        itr->collisionKept = false;
+    }
+    for (std::vector<Source>::iterator source = m_sources.begin();
+         source != m_sources.end();
+         ++source){
+        if (source->active == false){
+            continue;
+        }
+
+        const Ogre::Vector3 pos = source->position();
+        const Ogre::Real visualRadius = std::max(source->radius,
+                                                 source->visualRadius);
+        for (std::vector<Cell>::iterator itr = m_cells.begin();
+             itr != m_cells.end();
+             ++itr){
+            const Ogre::Real distance = this->getDistance(*itr, pos);
+            itr->distance = std::min(itr->distance, distance);
+            if (distance <= visualRadius){
+                itr->wanted = true;
+            }
+            if (distance <= visualRadius + m_hysteresis){
+                itr->kept = true;
+            }
+            if (distance <= source->radius){
+                itr->collisionWanted = true;
+            }
+            if (distance <= source->radius + m_hysteresis){
+                itr->collisionKept = true;
+            }
+        }
+    }
+
+    // Unload cells every source has left behind, and collision no source is
+    // near any more.
+    for (std::vector<Cell>::iterator itr = m_cells.begin();
+         itr != m_cells.end();
+         ++itr){
+        if (itr->loaded && itr->kept == false){
+            this->unloadCell(*itr);
+        }
+        else if (itr->collided && itr->collisionKept == false){
+            this->unloadCollision(*itr);
+        }
+    }
+
+    // Evict the farthest cells while over a cap.
+    while (m_loadedCells > m_maxLoadedCells ||
+           m_memoryUsage > m_memoryBudget){
+        Cell* farthest = nullptr;
+        for (std::vector<Cell>::iterator itr = m_cells.begin();
+             itr != m_cells.end();
+             ++itr){
+            if (itr->loaded &&
+                (farthest == nullptr || itr->distance > farthest->distance)){
+                farthest = &*itr;
+            }
+        }
+        if (farthest == nullptr){
+            break;
+        }
+
+        this->unloadCell(*farthest);
+    }
+
+    // Load wanted cells and collision nearest first.
+    m_candidates.clear();
+    for (std::vector<Cell>::iterator itr = m_cells.begin();
+         itr != m_cells.end();
+         ++itr){
+        if (itr->wanted &&
+            (itr->loaded == false ||
+             (itr->collisionWanted && itr->collided == false))){
+            m_candidates.push_back(&*itr);
+        }
+    }
+    if (m_candidates.empty()){
+        return;
+    }
+
+    std::sort(m_candidates.begin(), m_candidates.end(),
+              [](const Cell* a, const Cell* b){
+        return a->distance < b->distance;
+    });
+
+    m_timer.reset();
+    for (std::vector<Cell*>::iterator itr = m_candidates.begin();
+         itr != m_candidates.end();
+         ++itr){
+        Cell& cell = **itr;
+        if (cell.loaded == false){
+            if (m_loadedCells >= m_maxLoadedCells){
+                continue;
+            }
+            // Skip cells known not to fit, otherwise they would be evicted
+            // again next tick.
+            if (m_memoryUsage + cell.lastMemory > m_memoryBudget){
+                continue;
+            }
+
+            this->loadCell(cell);
+        }
+        if (cell.collisionWanted && cell.collided == false){
+            this->loadCollision(cell);
+        }
+
+        if (m_timer.getMicroseconds() / 1000.f >= m_budget){
+            break;
+        }
+    }
+}
+
+// ========================================================================= //
+
+void WorldStreamer::loadCell(Cell& cell)
+{
+    const Scene& scene = m_scenes[cell.scene];
+    const BinarySceneLoader& loader = scene.scene->getScene();
+    const std::string& group = scene.scene->getGroup();
+    Ogre::SceneManager* sceneMgr = m_world->getSceneManager();
+
+    // One region per cell, so the whole cell is a single batch.
+    cell.geometry = sceneMgr->createStaticGeometry(cell.name);
+    cell.geometry->setRegionDimensions(Ogre::Vector3(scene.cellSize));
+    cell.geometry->setOrigin(Ogre::Vector3(cell.minX, 0.f, cell.minZ));
+    cell.meshes.reserve(cell.placements.size());
+    cell.memory = 0;
+
+    for (std::vector<Placement>::const_iterator itr =
+             cell.placements.begin();
+         itr != cell.placements.end();
+         ++itr){
+        const char* name = loader.getString(
+            loader.getEntity(itr->entity).mesh);
+
+        // Cells manage their own residency, so keep them out of manifests.
+        Ogre::MeshPtr mesh;
+        ResourceManifest::suspendRecording();
+        try{
+            mesh = Ogre::MeshManager::getSingleton().load(name, group);
+            ResourceManifest::resumeRecording();
+        }
+        catch (Ogre::Exception& e){
+            ResourceManifest::resumeRecording();
+            Talos::Log::getSingleton().log("Failed to load mesh " +
+                                           std::string(name) + " for " +
+                                           cell.name + ": " +
+                                           e.getDescription());
+            continue;
+        }
+
+        // Entities only exist long enough to be batched.
+        Ogre::Entity* entity = loader.createEntity(itr->entity,
+                                                   nullptr,
+                                                   sceneMgr,
+                                                   group,
+                                                   &mesh);
+        if (entity == nullptr){
+            continue;
+        }
+        cell.geometry->addEntity(entity,
+                                 itr->position,
+                                 itr->orientation,
+                                 itr->scale);
+        sceneMgr->destroyEntity(entity);
+
+        if (std::find(cell.meshes.begin(), cell.meshes.end(), mesh) ==
+            cell.meshes.end()){
+            cell.meshes.push_back(mesh);
+            cell.memory += mesh->getSize();
+        }
+    }
+
+    cell.geometry->build();
+
+    cell.loaded = true;
+    cell.lastMemory = std::max(cell.lastMemory, cell.memory);
+    m_memoryUsage += cell.memory;
+    ++m_loadedCells;
+}
+
+// ========================================================================= //
+
+void WorldStreamer::loadCollision(Cell& cell)
+{
+    const Scene& scene = m_scenes[cell.scene];
+    std::shared_ptr<PScene> pscene = m_world->getPScene();
+    cell.collided = true;
+    if (scene.collision == false || pscene == nullptr){
+        return;
+    }
+
+    const BinarySceneLoader& loader = scene.scene->getScene();
+    const std::string& group = scene.scene->getGroup();
+    std::shared_ptr<Cooker> cooker = pscene->getCooker();
+
+    for (std::vector<Placement>::const_iterator itr =
+             cell.placements.begin();
+         itr != cell.placements.end();
+         ++itr){
+        // Loaded by loadCell() and held by the cell's mesh list.
+        Ogre::MeshPtr mesh = Ogre::MeshManager::getSingleton().getByName(
+            loader.getString(loader.getEntity(itr->entity).mesh), group);
+        if (mesh.isNull() || mesh->isLoaded() == false){
+            continue;
+        }
+
+        Cooker::Params params;
+        params.scale = itr->scale;
+        PxTriangleMesh* triangleMesh = cooker->createTriangleMesh(mesh,
+                                                                  params);
+        if (triangleMesh == nullptr){
+            continue;
+        }
+
+        // Count each cooked mesh once per cell, as with render meshes.
+        if (std::find(cell.collisionMeshes.begin(),
+                      cell.collisionMeshes.end(),
+                      triangleMesh) == cell.collisionMeshes.end()){
+            cell.collisionMemory += cooker->getTriangleMeshSize(triangleMesh);
+        }
+        cell.collisionMeshes.push_back(triangleMesh);
+
+        PxRigidStatic* actor = PxCreateStatic(
+            *pscene->getSDK(),
+            PxTransform(Physics::toPx(itr->position),
+                        Physics::toPx(itr->orientation)),
+            PxTriangleMeshGeometry(triangleMesh),
+            *pscene->getDefaultMaterial());
+        if (actor != nullptr){
+            pscene->getScene()->addActor(*actor);
+            cell.actors.push_back(actor);
+        }
+    }
+
+    cell.memory += cell.collisionMemory;
+    cell.lastMemory = std::max(cell.lastMemory, cell.memory);
+    m_memoryUsage += cell.collisionMemory;
+}
+
+// ========================================================================= //
+
+void WorldStreamer::unloadCell(Cell& cell)
+{
+    if (cell.collided){
+        this->unloadCollision(cell);
+    }
+
+    if (cell.geometry != nullptr){
+        m_world->getSceneManager()->destroyStaticGeometry(cell.geometry);
+        cell.geometry = nullptr;
+    }
+
+    // Unload meshes nothing else references, e.g. another loaded cell.
+    for (std::vector<Ogre::MeshPtr>::iterator itr = cell.meshes.begin();
+         itr != cell.meshes.end();
+         ++itr){
+        Ogre::MeshPtr mesh = *itr;
+        itr->setNull();
+        if (mesh.useCount() <=
+            Ogre::ResourceGroupManager::RESOURCE_SYSTEM_NUM_REFERENCE_COUNTS + 1){
+            mesh->unload();
+        }
+    }
+    cell.meshes.clear();
+
+    cell.loaded = false;
+    m_memoryUsage -= cell.memory;
+    cell.memory = 0;
+    --m_loadedCells;
+}
+
+// ========================================================================= //
+
+void WorldStreamer::unloadCollision(Cell& cell)
+{
+    if (cell.actors.empty() == false){
+        PxScene* scene = m_world->getPScene()->getScene();
+        for (std::vector<PxRigidStatic*>::iterator itr = cell.actors.begin();
+             itr != cell.actors.end();
+             ++itr){
+            scene->removeActor(**itr);
+            (*itr)->release();
+        }
+        cell.actors.clear();
+    }
+
+    // Cooked meshes otherwise stay cached until the World is destroyed.
+    if (cell.collisionMeshes.empty() == false){
+        std::shared_ptr<Cooker> cooker = m_world->getPScene()->getCooker();
+        for (std::vector<PxTriangleMesh*>::iterator itr =
+                 cell.collisionMeshes.begin();
+             itr != cell.collisionMeshes.end();
+             ++itr){
+            cooker->releaseTriangleMesh(*itr);
+        }
+        cell.collisionMeshes.clear();
+    }
+
+    cell.collided = false;
+    cell.memory -= cell.collisionMemory;
+    m_memoryUsage -= cell.collisionMemory;
+    cell.collisionMemory = 0;
+}
+
+// ========================================================================= //
+
+void WorldStreamer::clear(void)
+{
+    for (std::vector<Cell>::iterator itr = m_cells.begin();
+         itr != m_cells.end();
+         ++itr){
+        if (itr->loaded){
+            this->unloadCell(*itr);
+        }
+    }
+
+    m_cells.clear();
+    m_candidates.clear();
+    m_scenes.clear();
+    m_sources.clear();
+}
+
+// ========================================================================= //
\ No newline at end of file
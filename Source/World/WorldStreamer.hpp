@@ -0,0 +1,266 @@
+// ========================================================================= //
+// Talos - A 3D game engine with network multiplayer.
+// Copyright(C) 2015 Jordan Sparks <unixunited@live.com>
+//
+// This program is free software; you can redistribute it and / or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 3
+// of the License, or(at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+// ========================================================================= //
+// File: WorldStreamer.hpp
+// Author: Jordan Sparks <unixunited@live.com>
+// ========================================================================= //
+// Defines WorldStreamer class.
+// ========================================================================= //
+
+#ifndef __WORLDSTREAMER_HPP__
+#define __WORLDSTREAMER_HPP__
+
+// ========================================================================= //
+
+#include "stdafx.hpp"
+
+#include <functional>
+
+// ========================================================================= //
+
+using namespace physx;
+
+class SceneTemplate;
+class World;
+
+// ========================================================================= //
+// Streams large static scenes in and out around a set of sources (usually
+// the player). Each scene is split into square cells on the XZ plane. A cell
+// is drawn as one batched Ogre::StaticGeometry once any source comes within
+// its visual radius, and gains static collision within its (usually much
+// smaller) radius, so distant skylines stay visible without paying for
+// collision. Each part is dropped when every source is further than its
+// radius plus hysteresis. Memory and loaded cell caps evict the farthest
+// cells first.
+class WorldStreamer final
+{
+public:
+    // Returns the position a source streams around.
+    typedef std::function<Ogre::Vector3(void)> PositionFunc;
+
+    typedef uint32_t SourceHandle;
+
+    // Stores the World the cells are created in.
+    explicit WorldStreamer(std::shared_ptr<World> world);
+
+    // Empty destructor.
+    ~WorldStreamer(void);
+
+    // Partitions the scene into cells of cellSize world units, placed with
+    // the given transform. Nothing is loaded until a source is in range.
+    // Returns false if the scene cannot be read.
+    bool addScene(const std::string& file,
+                  const Ogre::Vector3& position,
+                  const Ogre::Quaternion& orientation,
+                  const Ogre::Vector3& scale,
+                  const Ogre::Real cellSize,
+                  const bool collision = true,
+                  const std::string& group = "General");
+
+    // Adds a point cells are loaded around, returning its handle. Cells are
+    // drawn within visualRadius and get collision within radius. A visual
+    // radius smaller than radius is treated as radius.
+    SourceHandle addSource(const PositionFunc& position,
+                           const Ogre::Real radius,
+                           const Ogre::Real visualRadius = 0.f);
+
+    // Stops streaming around a source.
+    void removeSource(const SourceHandle handle);
+
+    // Unloads cells and collision out of range and loads those in range,
+    // nearest first, until the per-tick budget is spent.
+    void update(void);
+
+    // Unloads every cell and removes all scenes and sources.
+    void clear(void);
+
+    // Getters:
+
+    // Returns number of cells across all scenes.
+    const size_t getCellCount(void) const;
+
+    // Returns number of loaded cells.
+    const size_t getLoadedCellCount(void) const;
+
+    // Returns estimated mesh and cooked collision memory held by loaded
+    // cells, in bytes.
+    const size_t getMemoryUsage(void) const;
+
+    // Returns per-tick load budget in milliseconds.
+    const Ogre::Real getBudget(void) const;
+
+    // Setters:
+
+    // Sets collision radius of a source.
+    void setSourceRadius(const SourceHandle handle, const Ogre::Real radius);
+
+    // Sets visual radius of a source.
+    void setSourceVisualRadius(const SourceHandle handle,
+                               const Ogre::Real radius);
+
+    // Sets the extra distance beyond a source's radius before cells unload.
+    void setHysteresis(const Ogre::Real);
+
+    // Sets the mesh and collision memory loaded cells may hold, in bytes.
+    void setMemoryBudget(const size_t);
+
+    // Sets the maximum number of loaded cells.
+    void setMaxLoadedCells(const size_t);
+
+    // Sets per-tick load budget in milliseconds. At least one cell is
+    // loaded per tick regardless.
+    void setBudget(const Ogre::Real);
+
+private:
+    struct Scene{
+        std::shared_ptr<SceneTemplate> scene;
+        Ogre::Real cellSize;
+        bool collision;
+    };
+
+    // An entity record placed in world space.
+    struct Placement{
+        uint32_t entity;
+        Ogre::Vector3 position;
+        Ogre::Quaternion orientation;
+        Ogre::Vector3 scale;
+    };
+
+    struct Cell{
+        uint32_t scene;
+        std::string name;
+        Ogre::Real minX, minZ, maxX, maxZ;
+        std::vector<Placement> placements;
+
+        // Loaded state.
+        bool loaded;
+        Ogre::StaticGeometry* geometry;
+        std::vector<Ogre::MeshPtr> meshes;
+        // Collision has been created (or the scene has none).
+        bool collided;
+        std::vector<PxRigidStatic*> actors;
+        // One entry per createTriangleMesh() call, released on unload.
+        std::vector<PxTriangleMesh*> collisionMeshes;
+        // Includes collisionMemory.
+        size_t memory;
+        size_t collisionMemory;
+        // Most memory the cell has used while loaded, 0 if never loaded.
+        size_t lastMemory;
+
+        // Distance to the nearest source, updated each tick.
+        Ogre::Real distance;
+        // Within a source's visual radius, and within it plus hysteresis.
+        bool wanted;
+        bool kept;
+        // Within a source's radius, and within it plus hysteresis.
+        bool collisionWanted;
+        bool collisionKept;
+    };
+
+    struct Source{
+        PositionFunc position;
+        Ogre::Real radius;
+        Ogre::Real visualRadius;
+        bool active;
+    };
+
+    // Creates the cell's static geometry.
+    void loadCell(Cell& cell);
+
+    // Destroys the cell's static geometry and collision and releases its
+    // meshes.
+    void unloadCell(Cell& cell);
+
+    // Creates static collision for a loaded cell's placements.
+    void loadCollision(Cell& cell);
+
+    // Destroys the cell's static collision and releases its cooked
+    // collision meshes.
+    void unloadCollision(Cell& cell);
+
+    // Returns distance on the XZ plane from pos to the cell's bounds.
+    const Ogre::Real getDistance(const Cell& cell,
+                                 const Ogre::Vector3& pos) const;
+
+    std::shared_ptr<World> m_world;
+    std::vector<Scene> m_scenes;
+    std::vector<Cell> m_cells;
+    std::vector<Source> m_sources;
+    std::vector<Cell*> m_candidates;
+
+    Ogre::Real m_hysteresis;
+    size_t m_memoryBudget;
+    size_t m_maxLoadedCells;
+    size_t m_loadedCells;
+    size_t m_memoryUsage;
+    Ogre::Real m_budget;
+    Ogre::Timer m_timer;
+};
+
+// ========================================================================= //
+
+// Getters:
+
+inline const size_t WorldStreamer::getCellCount(void) const{
+    return m_cells.size();
+}
+
+inline const size_t WorldStreamer::getLoadedCellCount(void) const{
+    return m_loadedCells;
+}
+
+inline const size_t WorldStreamer::getMemoryUsage(void) const{
+    return m_memoryUsage;
+}
+
+inline const Ogre::Real WorldStreamer::getBudget(void) const{
+    return m_budget;
+}
+
+// Setters:
+
+inline void WorldStreamer::setSourceRadius(const SourceHandle handle,
+                                           const Ogre::Real radius){
+    m_sources[handle].radius = radius;
+}
+
+inline void WorldStreamer::setSourceVisualRadius(const SourceHandle handle,
+                                                 const Ogre::Real radius){
+    m_sources[handle].visualRadius = radius;
+}
+
+inline void WorldStreamer::setHysteresis(const Ogre::Real hysteresis){
+    m_hysteresis = hysteresis;
+}
+
+inline void WorldStreamer::setMemoryBudget(const size_t budget){
+    m_memoryBudget = budget;
+}
+
+inline void WorldStreamer::setMaxLoadedCells(const size_t cells){
+    m_maxLoadedCells = cells;
+}
+
+inline void WorldStreamer::setBudget(const Ogre::Real budget){
+    m_budget = budget;
+}
+
+// ========================================================================= //
+
+#endif
+
+// ========================================================================= //
\ No newline at end of file